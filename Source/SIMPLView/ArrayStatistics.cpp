@@ -0,0 +1,125 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ArrayStatistics.h"
+
+#include <QtCore/QObject>
+
+namespace
+{
+/**
+ * @brief Returns the smallest, largest and mean value of an array
+ */
+template <typename T>
+QString Statistics(IDataArray::Pointer array)
+{
+  const T* data = static_cast<const T*>(array->getVoidPointer(0));
+  size_t count = array->getSize();
+  if(nullptr == data || count == 0)
+  {
+    return QObject::tr("empty");
+  }
+  T minimum = data[0];
+  T maximum = data[0];
+  double sum = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    minimum = qMin(minimum, data[i]);
+    maximum = qMax(maximum, data[i]);
+    sum += static_cast<double>(data[i]);
+  }
+  return QObject::tr("min %1, max %2, mean %3").arg(static_cast<double>(minimum)).arg(static_cast<double>(maximum)).arg(sum / count);
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ArrayStatistics::Summarize(IDataArray::Pointer array)
+{
+  QString type = array->getTypeAsString();
+  if(type == "bool")
+  {
+    const bool* data = static_cast<const bool*>(array->getVoidPointer(0));
+    size_t count = (nullptr != data) ? array->getSize() : 0;
+    size_t set = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+      set += data[i] ? 1 : 0;
+    }
+    return QObject::tr("%1 of %2 true").arg(set).arg(count);
+  }
+  if(type == "int8_t")
+  {
+    return Statistics<int8_t>(array);
+  }
+  if(type == "uint8_t")
+  {
+    return Statistics<uint8_t>(array);
+  }
+  if(type == "int16_t")
+  {
+    return Statistics<int16_t>(array);
+  }
+  if(type == "uint16_t")
+  {
+    return Statistics<uint16_t>(array);
+  }
+  if(type == "int32_t")
+  {
+    return Statistics<int32_t>(array);
+  }
+  if(type == "uint32_t")
+  {
+    return Statistics<uint32_t>(array);
+  }
+  if(type == "int64_t")
+  {
+    return Statistics<int64_t>(array);
+  }
+  if(type == "uint64_t")
+  {
+    return Statistics<uint64_t>(array);
+  }
+  if(type == "float")
+  {
+    return Statistics<float>(array);
+  }
+  if(type == "double")
+  {
+    return Statistics<double>(array);
+  }
+  return QObject::tr("%1 tuples of %2").arg(array->getNumberOfTuples()).arg(type);
+}
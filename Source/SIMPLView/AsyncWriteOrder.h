@@ -0,0 +1,70 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QVector>
+
+/**
+ * @brief The AsyncWriteOrder class decides which of the queued background I/O jobs runs next. Writes go first:
+ * every finished write hands a data structure back, so draining them is what frees memory. A computation waits for
+ * its reads, though, so after MaxWritesInARow writes in a row a waiting read is let through. Within each kind the
+ * jobs run in the order they were queued.
+ */
+class AsyncWriteOrder
+{
+public:
+  /**
+   * @brief The number of writes that may run in a row while a read is waiting
+   */
+  static const int MaxWritesInARow = 2;
+
+  /**
+   * @brief Returns the position of the job to run next
+   * @param writes Whether each queued job is a write, in the order they were queued
+   * @param writesInARow The number of writes that have run since the last read
+   * @return The position in writes, or -1 if nothing is queued
+   */
+  static int Next(const QVector<bool>& writes, int writesInARow);
+
+protected:
+  AsyncWriteOrder();
+
+public:
+  AsyncWriteOrder(const AsyncWriteOrder&) = delete;            // Copy Constructor Not Implemented
+  AsyncWriteOrder(AsyncWriteOrder&&) = delete;                 // Move Constructor Not Implemented
+  AsyncWriteOrder& operator=(const AsyncWriteOrder&) = delete; // Copy Assignment Not Implemented
+  AsyncWriteOrder& operator=(AsyncWriteOrder&&) = delete;      // Move Assignment Not Implemented
+};
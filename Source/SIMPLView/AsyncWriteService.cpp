@@ -0,0 +1,364 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "AsyncWriteService.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+#include "SIMPLView/AsyncWriteOrder.h"
+#include "SIMPLView/PipelineMemoryGovernor.h"
+#include "SIMPLView/TraceRecorder.h"
+
+namespace
+{
+/**
+ * @brief The thread that runs the queued jobs
+ */
+class AsyncWriteThread : public QThread
+{
+public:
+  AsyncWriteThread(AsyncWriteService* service)
+  : m_Service(service)
+  {
+  }
+
+protected:
+  void run() override
+  {
+    m_Service->runJobs();
+  }
+
+private:
+  AsyncWriteService* m_Service = nullptr;
+};
+}
+
+AsyncWriteService* AsyncWriteService::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AsyncWriteService::AsyncWriteService(QObject* parent)
+: QObject(parent)
+{
+  qRegisterMetaType<AsyncWriteService::Result>();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AsyncWriteService::~AsyncWriteService()
+{
+  stop();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AsyncWriteService* AsyncWriteService::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new AsyncWriteService();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsyncWriteService::start()
+{
+  if(nullptr != m_Thread)
+  {
+    return;
+  }
+
+  m_Stopping = false;
+  m_Thread = new AsyncWriteThread(this);
+  m_Thread->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsyncWriteService::stop()
+{
+  if(nullptr == m_Thread)
+  {
+    return;
+  }
+
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_Stopping = true;
+    m_Pending.wakeAll();
+  }
+  m_Thread->wait();
+  delete m_Thread;
+  m_Thread = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AsyncWriteService::submit(const Job& job)
+{
+  Entry entry;
+  entry.job = job;
+  entry.bytes = PipelineMemoryGovernor::DataBytes(job.dca);
+  {
+    QMutexLocker locker(&m_Mutex);
+    entry.id = m_NextId++;
+
+    m_Queue.push_back(entry);
+    m_Pending.wakeAll();
+  }
+
+  if(job.write)
+  {
+    emitPendingChanged();
+  }
+  return entry.id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsyncWriteService::cancel(int id)
+{
+  Entry canceled;
+  {
+    QMutexLocker locker(&m_Mutex);
+    if(m_Current.id == id)
+    {
+      for(const AbstractFilter::Pointer& filter : m_Current.job.filters)
+      {
+        filter->setCancel(true);
+      }
+      return;
+    }
+    for(int i = 0; i < m_Queue.size(); i++)
+    {
+      if(m_Queue[i].id == id)
+      {
+        canceled = m_Queue.takeAt(i);
+        break;
+      }
+    }
+  }
+  if(canceled.id < 0)
+  {
+    return;
+  }
+
+  Result result;
+  result.id = canceled.id;
+  result.owner = canceled.job.owner;
+  result.label = canceled.job.label;
+  result.write = canceled.job.write;
+  result.bytes = canceled.bytes;
+  result.canceled = true;
+  emit jobFinished(result);
+  if(result.write)
+  {
+    emitPendingChanged();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsyncWriteService::release(QObject* owner)
+{
+  QMutexLocker locker(&m_Mutex);
+  for(Entry& entry : m_Queue)
+  {
+    if(entry.job.owner == owner)
+    {
+      entry.job.owner = nullptr;
+    }
+  }
+  if(m_Current.job.owner == owner)
+  {
+    m_Current.job.owner = nullptr;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AsyncWriteService::pendingWrites(qint64* bytes) const
+{
+  QMutexLocker locker(&m_Mutex);
+  int writes = 0;
+  qint64 total = 0;
+  for(const Entry& entry : m_Queue)
+  {
+    if(entry.job.write)
+    {
+      writes++;
+      total += entry.bytes;
+    }
+  }
+  if(m_Current.id >= 0 && m_Current.job.write)
+  {
+    writes++;
+    total += m_Current.bytes;
+  }
+  if(nullptr != bytes)
+  {
+    *bytes = total;
+  }
+  return writes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsyncWriteService::emitPendingChanged()
+{
+  qint64 bytes = 0;
+  int writes = pendingWrites(&bytes);
+  emit pendingChanged(writes, bytes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsyncWriteService::runJobs()
+{
+  while(true)
+  {
+    Entry entry;
+    {
+      QMutexLocker locker(&m_Mutex);
+      while(m_Queue.isEmpty() && !m_Stopping)
+      {
+        m_Pending.wait(&m_Mutex);
+      }
+      if(m_Queue.isEmpty())
+      {
+        break;
+      }
+      QVector<bool> writes(m_Queue.size());
+      for(int i = 0; i < m_Queue.size(); i++)
+      {
+        writes[i] = m_Queue[i].job.write;
+      }
+      entry = m_Queue.takeAt(AsyncWriteOrder::Next(writes, m_WritesInARow));
+      m_WritesInARow = entry.job.write ? m_WritesInARow + 1 : 0;
+      m_Current = entry;
+      m_LastError.clear();
+    }
+
+    Result result = run(entry);
+    {
+      QMutexLocker locker(&m_Mutex);
+      result.owner = m_Current.job.owner;
+      m_Current = Entry();
+    }
+    emit jobFinished(result);
+    if(result.write)
+    {
+      emitPendingChanged();
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AsyncWriteService::Result AsyncWriteService::run(const Entry& entry)
+{
+  SV_TRACE_SCOPE_CATEGORY(entry.job.write ? "Background Write" : "Background Read", "io");
+
+  Result result;
+  result.id = entry.id;
+  result.owner = entry.job.owner;
+  result.label = entry.job.label;
+  result.write = entry.job.write;
+  QElapsedTimer timer;
+  timer.start();
+
+  for(AbstractFilter::Pointer filter : entry.job.filters)
+  {
+    // cancel() marks all the filters of the running job, including those that have not started yet
+    if(filter->getCancel())
+    {
+      result.canceled = true;
+      break;
+    }
+    connect(filter.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(filterMessage(const PipelineMessage&)), Qt::DirectConnection);
+    filter->setDataContainerArray(entry.job.dca);
+    filter->execute();
+
+    if(filter->getCancel())
+    {
+      result.canceled = true;
+      break;
+    }
+    if(filter->getErrorCondition() < 0)
+    {
+      QMutexLocker locker(&m_Mutex);
+      result.err = filter->getErrorCondition();
+      result.errorMessage = tr("%1 failed with error %2").arg(filter->getHumanLabel()).arg(result.err);
+      if(!m_LastError.isEmpty())
+      {
+        result.errorMessage += ": " + m_LastError;
+      }
+      break;
+    }
+  }
+
+  result.milliseconds = timer.elapsed();
+  // What a read brought in is only known afterwards
+  result.bytes = entry.job.write ? entry.bytes : PipelineMemoryGovernor::DataBytes(entry.job.dca);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AsyncWriteService::filterMessage(const PipelineMessage& msg)
+{
+  if(msg.getType() == PipelineMessage::MessageType::Error)
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_LastError = msg.getText();
+  }
+}
@@ -0,0 +1,208 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QMetaType>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+class QThread;
+
+/**
+ * @brief The AsyncWriteService class runs writer filters, and the readers that must not run beside them, on one
+ * dedicated I/O thread so that whoever hands them over can go on computing. A job is a list of filters and the data
+ * structure they run on. The caller must not change that data structure until the job has finished; handing over
+ * the data structure of a dataset that is finished computing is what makes it an immutable snapshot without a copy.
+ *
+ * All of the application's background file I/O goes through the one thread because the HDF5 library that most
+ * readers and writers use must not be entered from two threads at once. Writes drain first because each one frees
+ * a data structure, but a waiting read is let through every few writes (see AsyncWriteOrder). stop() runs the jobs that are still queued, so no write is lost when the
+ * application quits.
+ */
+class AsyncWriteService : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~AsyncWriteService() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static AsyncWriteService* Instance();
+
+  /**
+   * @brief The filters of one job
+   */
+  struct Job
+  {
+    QObject* owner = nullptr;
+    QString label;
+    QVector<AbstractFilter::Pointer> filters;
+    DataContainerArray::Pointer dca;
+    bool write = true;
+  };
+
+  /**
+   * @brief The outcome of one job. bytes is the size of the arrays in its data structure.
+   */
+  struct Result
+  {
+    int id = -1;
+    QObject* owner = nullptr;
+    QString label;
+    bool write = true;
+    qint64 bytes = 0;
+    qint64 milliseconds = 0;
+    bool canceled = false;
+    int err = 0;
+    QString errorMessage;
+
+    double bytesPerSecond() const
+    {
+      return (milliseconds > 0) ? bytes * 1000.0 / milliseconds : 0.0;
+    }
+  };
+
+  /**
+   * @brief Starts the I/O thread
+   */
+  void start();
+
+  /**
+   * @brief Runs the queued jobs and stops the I/O thread
+   */
+  void stop();
+
+  /**
+   * @brief Queues a job. Never waits for the disk.
+   * @param job
+   * @return An ID that the jobFinished signal reports the job under
+   */
+  int submit(const Job& job);
+
+  /**
+   * @brief Takes a queued job off the queue, or cancels it after its current filter if it is running. The
+   * jobFinished signal is emitted for it either way.
+   * @param id
+   */
+  void cancel(int id);
+
+  /**
+   * @brief Lets the queued and running jobs of an owner that goes away run to the end. Their results no longer
+   * name the owner.
+   * @param owner
+   */
+  void release(QObject* owner);
+
+  /**
+   * @brief Returns the number of writes that are queued or running
+   * @param bytes Receives the size of their data structures
+   * @return
+   */
+  int pendingWrites(qint64* bytes = nullptr) const;
+
+  /**
+   * @brief Runs on the I/O thread
+   */
+  void runJobs();
+
+signals:
+  /**
+   * @brief Emitted from the I/O thread when a job has finished, failed or was canceled
+   * @param result
+   */
+  void jobFinished(const AsyncWriteService::Result& result);
+
+  /**
+   * @brief Emitted whenever a write is queued or has finished
+   * @param writes
+   * @param bytes
+   */
+  void pendingChanged(int writes, qint64 bytes);
+
+protected:
+  AsyncWriteService(QObject* parent = nullptr);
+
+protected slots:
+  /**
+   * @brief Runs on the I/O thread and keeps the last error a filter reported
+   * @param msg
+   */
+  void filterMessage(const PipelineMessage& msg);
+
+private:
+  static AsyncWriteService* self;
+
+  /**
+   * @brief A queued job with what is known before it runs
+   */
+  struct Entry
+  {
+    int id = -1;
+    Job job;
+    qint64 bytes = 0;
+  };
+
+  mutable QMutex m_Mutex;
+  QWaitCondition m_Pending;
+  QVector<Entry> m_Queue;
+  Entry m_Current;
+  int m_NextId = 1;
+  int m_WritesInARow = 0;
+  bool m_Stopping = false;
+  QThread* m_Thread = nullptr;
+  QString m_LastError;
+
+  void emitPendingChanged();
+  Result run(const Entry& entry);
+
+public:
+  AsyncWriteService(const AsyncWriteService&) = delete;            // Copy Constructor Not Implemented
+  AsyncWriteService(AsyncWriteService&&) = delete;                 // Move Constructor Not Implemented
+  AsyncWriteService& operator=(const AsyncWriteService&) = delete; // Copy Assignment Not Implemented
+  AsyncWriteService& operator=(AsyncWriteService&&) = delete;      // Move Assignment Not Implemented
+};
+
+Q_DECLARE_METATYPE(AsyncWriteService::Result)
@@ -0,0 +1,536 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "BatchPipelineRunner.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/FilterParameters/FilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputPathFilterParameter.h"
+
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/PipelineMemoryGovernor.h"
+#include "SIMPLView/TraceRecorder.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchPipelineRunner::BatchPipelineRunner(QObject* parent)
+: QObject(parent)
+, m_Cancel(false)
+{
+  connect(AsyncWriteService::Instance(), &AsyncWriteService::jobFinished, this, &BatchPipelineRunner::ioFinished);
+  connect(&m_ComputeWatcher, &QFutureWatcher<StageResult>::finished, this, &BatchPipelineRunner::computeFinished);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchPipelineRunner::~BatchPipelineRunner()
+{
+  m_Cancel = true;
+  {
+    QMutexLocker locker(&m_Mutex);
+    for(const AbstractFilter::Pointer& filter : m_CurrentFilters)
+    {
+      filter->setCancel(true);
+    }
+  }
+  // Reads are dropped, but the writes that were handed over still run so that their output is not lost. The I/O
+  // jobs keep their filters and data structures alive until they have finished.
+  AsyncWriteService* service = AsyncWriteService::Instance();
+  disconnect(service, nullptr, this, nullptr);
+  for(auto iter = m_Jobs.constBegin(); iter != m_Jobs.constEnd(); ++iter)
+  {
+    if(m_States[iter.value()] != State::Writing)
+    {
+      service->cancel(iter.key());
+    }
+  }
+  service->release(this);
+  m_ComputeWatcher.waitForFinished();
+  PipelineMemoryGovernor::Instance()->removeOwner(this);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString BatchPipelineRunner::OutputPath(const QString& path, const QString& input)
+{
+  QFileInfo info(path);
+  QString name = info.completeBaseName() + "_" + QFileInfo(input).completeBaseName();
+  if(!info.suffix().isEmpty())
+  {
+    name += "." + info.suffix();
+  }
+  return info.absoluteDir().filePath(name);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString BatchPipelineRunner::OutputDirectory(const QString& directory, const QString& input)
+{
+  return QDir(directory).filePath(QFileInfo(input).completeBaseName());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchPipelineRunner::start(FilterPipeline::Pointer pipeline, int filterIndex, const QString& propertyName, const QStringList& inputs)
+{
+  if(m_Running || nullptr == pipeline.get() || inputs.isEmpty())
+  {
+    return false;
+  }
+
+  // The readers the pipeline starts with and the writers it ends with are the stages that overlap with compute
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  m_Enabled.clear();
+  for(int i = 0; i < filters.size(); i++)
+  {
+    if(filters[i]->getEnabled())
+    {
+      m_Enabled.push_back(i);
+    }
+  }
+  m_ComputeBegin = 0;
+  while(m_ComputeBegin < m_Enabled.size() && filters[m_Enabled[m_ComputeBegin]]->getSubGroupName() == SIMPL::FilterSubGroups::InputFilters)
+  {
+    m_ComputeBegin++;
+  }
+  m_WriteBegin = m_Enabled.size();
+  while(m_WriteBegin > m_ComputeBegin && PipelineDataFlow::IsOutputFilter(filters[m_Enabled[m_WriteBegin - 1]]))
+  {
+    m_WriteBegin--;
+  }
+
+  m_Pipeline = pipeline;
+  m_InputFilter = filterIndex;
+  m_InputProperty = propertyName;
+  m_Datasets.clear();
+  for(const QString& input : inputs)
+  {
+    Dataset dataset;
+    dataset.index = m_Datasets.size();
+    dataset.input = input;
+    m_Datasets.push_back(dataset);
+  }
+  m_States = QVector<State>(inputs.size(), State::Pending);
+  m_Filters = QVector<QVector<AbstractFilter::Pointer>>(inputs.size());
+  m_Data = QVector<DataContainerArray::Pointer>(inputs.size());
+  m_Done = 0;
+  m_Cancel = false;
+  m_Running = true;
+  m_Clock.invalidate();
+
+  // The batch waits for memory like any other pipeline, with the prediction for one dataset
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+  m_DatasetBytes = PipelineMemoryGovernor::EstimatePeakMemory(pipeline);
+  governor->setEstimate(this, tr("Batch of %1 datasets").arg(inputs.size()), m_DatasetBytes);
+  governor->requestExecution(this, [this] { begin(); });
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::begin()
+{
+  // The other pipelines keep what they were admitted with; the batch holds as many datasets as fit beside them
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+  m_Budget = governor->getBudget();
+  if(m_Budget > 0)
+  {
+    m_Budget = qMax(m_DatasetBytes, m_Budget - (governor->getCommittedMemory() - m_DatasetBytes));
+  }
+  m_Clock.start();
+  schedule();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchPipelineRunner::isRunning() const
+{
+  return m_Running;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::cancel()
+{
+  if(!m_Running)
+  {
+    return;
+  }
+  m_Cancel = true;
+  {
+    QMutexLocker locker(&m_Mutex);
+    for(const AbstractFilter::Pointer& filter : m_CurrentFilters)
+    {
+      filter->setCancel(true);
+    }
+  }
+  // A queued job reports back from within cancel(), so the IDs are copied first
+  for(int id : m_Jobs.keys())
+  {
+    AsyncWriteService::Instance()->cancel(id);
+  }
+  PipelineMemoryGovernor::Instance()->cancelRequest(this);
+  schedule();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchPipelineRunner::heldDatasets() const
+{
+  int held = 0;
+  for(State state : m_States)
+  {
+    held += (state != State::Pending && state != State::Done) ? 1 : 0;
+  }
+  return held;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::schedule()
+{
+  if(!m_Running || (!m_Clock.isValid() && !m_Cancel))
+  {
+    return;
+  }
+
+  if(!m_Cancel)
+  {
+    if(!m_ComputeWatcher.isRunning())
+    {
+      int read = m_States.indexOf(State::Read);
+      if(read >= 0)
+      {
+        startCompute(read);
+      }
+    }
+
+    // Nothing changes a computed data structure any more, so the writers get it as it is
+    for(int i = 0; i < m_States.size(); i++)
+    {
+      if(m_States[i] == State::Computed && m_WriteBegin == m_Enabled.size())
+      {
+        finishDataset(i);
+      }
+      else if(m_States[i] == State::Computed)
+      {
+        submitIO(i, State::Writing, m_WriteBegin, m_Enabled.size());
+      }
+    }
+
+    if(!m_States.contains(State::Reading))
+    {
+      startRead();
+    }
+  }
+
+  if(!m_Jobs.isEmpty() || m_ComputeWatcher.isRunning() || (!m_Cancel && m_Done < m_Datasets.size()))
+  {
+    return;
+  }
+
+  Summary summary;
+  summary.datasets = m_Datasets.size();
+  summary.canceled = m_Cancel;
+  summary.milliseconds = m_Clock.isValid() ? m_Clock.elapsed() : 0;
+  for(int i = 0; i < m_Datasets.size(); i++)
+  {
+    const Dataset& dataset = m_Datasets[i];
+    summary.readMilliseconds += dataset.readMilliseconds;
+    summary.computeMilliseconds += dataset.computeMilliseconds;
+    summary.writeMilliseconds += dataset.writeMilliseconds;
+    if(m_States[i] == State::Done)
+    {
+      summary.succeeded += (dataset.err >= 0) ? 1 : 0;
+      summary.failed += (dataset.err < 0) ? 1 : 0;
+    }
+  }
+
+  m_Running = false;
+  m_Pipeline = FilterPipeline::Pointer();
+  m_Filters.clear();
+  m_Data.clear();
+  if(m_Clock.isValid())
+  {
+    PipelineMemoryGovernor::Instance()->executionFinished(this);
+  }
+  emit finished(summary);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchPipelineRunner::startRead()
+{
+  int next = m_States.indexOf(State::Pending);
+  if(next < 0 || m_States.contains(State::Read))
+  {
+    return false;
+  }
+  int held = heldDatasets();
+  if(held > 0 && m_Budget > 0 && (held + 1) * m_DatasetBytes > m_Budget)
+  {
+    return false;
+  }
+
+  const QString& input = m_Datasets[next].input;
+  FilterPipeline::FilterContainerType filters = m_Pipeline->getFilterContainer();
+  QVector<AbstractFilter::Pointer> copies;
+  for(int index : m_Enabled)
+  {
+    AbstractFilter::Pointer copy = filters[index]->newFilterInstance(true);
+    if(index == m_InputFilter)
+    {
+      copy->setProperty(m_InputProperty.toLatin1().constData(), input);
+    }
+    else if(PipelineDataFlow::IsOutputFilter(copy))
+    {
+      // Every dataset writes its own files: output files get the input's name appended and writers that take a
+      // directory, usually together with a file prefix, write into a directory of their own
+      for(FilterParameter::Pointer parameter : copy->getFilterParameters())
+      {
+        QByteArray propertyName = parameter->getPropertyName().toLatin1();
+        QString value = copy->property(propertyName.constData()).toString();
+        if(value.isEmpty())
+        {
+          continue;
+        }
+        if(std::dynamic_pointer_cast<OutputFileFilterParameter>(parameter))
+        {
+          copy->setProperty(propertyName.constData(), OutputPath(value, input));
+        }
+        else if(std::dynamic_pointer_cast<OutputPathFilterParameter>(parameter))
+        {
+          QString directory = OutputDirectory(value, input);
+          QDir().mkpath(directory);
+          copy->setProperty(propertyName.constData(), directory);
+        }
+      }
+    }
+    copies.push_back(copy);
+  }
+  m_Filters[next] = copies;
+  m_Data[next] = DataContainerArray::New();
+
+  submitIO(next, State::Reading, 0, m_ComputeBegin);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::startCompute(int dataset)
+{
+  m_States[dataset] = State::Computing;
+  QVector<AbstractFilter::Pointer> filters = m_Filters[dataset].mid(m_ComputeBegin, m_WriteBegin - m_ComputeBegin);
+  DataContainerArray::Pointer dca = m_Data[dataset];
+  m_ComputeWatcher.setFuture(QtConcurrent::run([this, dataset, filters, dca] { return runStage(dataset, filters, dca); }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::submitIO(int dataset, State state, int begin, int end)
+{
+  m_States[dataset] = state;
+  AsyncWriteService::Job job;
+  job.owner = this;
+  job.label = QFileInfo(m_Datasets[dataset].input).fileName();
+  job.filters = m_Filters[dataset].mid(begin, end - begin);
+  job.dca = m_Data[dataset];
+  job.write = (state == State::Writing);
+  m_Jobs.insert(AsyncWriteService::Instance()->submit(job), dataset);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchPipelineRunner::StageResult BatchPipelineRunner::runStage(int dataset, QVector<AbstractFilter::Pointer> filters, DataContainerArray::Pointer dca)
+{
+  SV_TRACE_SCOPE_CATEGORY("Batch Compute", "execute");
+
+  StageResult result;
+  result.dataset = dataset;
+  QElapsedTimer timer;
+  timer.start();
+
+  for(AbstractFilter::Pointer filter : filters)
+  {
+    if(m_Cancel)
+    {
+      result.canceled = true;
+      break;
+    }
+    {
+      QMutexLocker locker(&m_Mutex);
+      m_CurrentFilters.push_back(filter);
+    }
+
+    connect(filter.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(filterMessage(const PipelineMessage&)), Qt::DirectConnection);
+    filter->setDataContainerArray(dca);
+    filter->execute();
+
+    QMutexLocker locker(&m_Mutex);
+    m_CurrentFilters.removeAll(filter);
+    if(filter->getCancel())
+    {
+      result.canceled = true;
+      break;
+    }
+    if(filter->getErrorCondition() < 0)
+    {
+      result.err = filter->getErrorCondition();
+      result.errorMessage = tr("%1 failed with error %2").arg(filter->getHumanLabel()).arg(result.err);
+      if(!m_LastError.isEmpty())
+      {
+        result.errorMessage += ": " + m_LastError;
+      }
+      break;
+    }
+  }
+
+  result.milliseconds = timer.elapsed();
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::filterMessage(const PipelineMessage& msg)
+{
+  if(msg.getType() == PipelineMessage::MessageType::Error)
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_LastError = msg.getText();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::ioFinished(const AsyncWriteService::Result& result)
+{
+  if(result.owner != this || !m_Jobs.contains(result.id))
+  {
+    return;
+  }
+
+  StageResult stage;
+  stage.dataset = m_Jobs.take(result.id);
+  stage.milliseconds = result.milliseconds;
+  stage.canceled = result.canceled;
+  stage.err = result.err;
+  stage.errorMessage = result.errorMessage;
+  stageFinished(stage, (m_States[stage.dataset] == State::Reading) ? State::Read : State::Done);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::computeFinished()
+{
+  stageFinished(m_ComputeWatcher.result(), State::Computed);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::stageFinished(const StageResult& result, State next)
+{
+  Dataset& dataset = m_Datasets[result.dataset];
+  State state = m_States[result.dataset];
+  if(state == State::Reading)
+  {
+    dataset.readMilliseconds = result.milliseconds;
+  }
+  else if(state == State::Computing)
+  {
+    dataset.computeMilliseconds = result.milliseconds;
+  }
+  else
+  {
+    dataset.writeMilliseconds = result.milliseconds;
+  }
+
+  if(result.canceled)
+  {
+    // A canceled dataset is neither finished nor failed
+    m_States[result.dataset] = State::Pending;
+    m_Filters[result.dataset].clear();
+    m_Data[result.dataset] = DataContainerArray::NullPointer();
+  }
+  else if(result.err < 0 || next == State::Done)
+  {
+    dataset.err = result.err;
+    dataset.errorMessage = result.errorMessage;
+    finishDataset(result.dataset);
+  }
+  else
+  {
+    m_States[result.dataset] = next;
+  }
+
+  schedule();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchPipelineRunner::finishDataset(int dataset)
+{
+  // The data structure goes as soon as the dataset is written, which makes room for the next read
+  m_States[dataset] = State::Done;
+  m_Filters[dataset].clear();
+  m_Data[dataset] = DataContainerArray::NullPointer();
+  m_Done++;
+  emit datasetFinished(m_Datasets[dataset], m_Done, m_Datasets.size());
+}
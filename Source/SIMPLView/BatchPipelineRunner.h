@@ -0,0 +1,233 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "SIMPLView/AsyncWriteService.h"
+
+/**
+ * @brief The BatchPipelineRunner class runs one pipeline on a list of input files, one dataset per file. The
+ * pipeline is split into three stages: the readers it starts with, the writers it ends with, and everything in
+ * between. The stages of consecutive datasets overlap, so that the next dataset is read and the previous one is
+ * written while the current one is computed.
+ *
+ * Computing runs on a worker thread of its own. Reads and writes go to the I/O thread of the AsyncWriteService,
+ * which drains writes first; a dataset's writes are handed over as soon as it is computed, so the compute lane never
+ * waits for the disk. A new dataset is only read while the datasets that are held in memory, including those that
+ * wait to be written, each counted with the preflight's peak memory prediction, fit into the memory governor's
+ * budget; one dataset is always allowed.
+ *
+ * Every dataset runs on copies of the pipeline's filters. The chosen reader parameter is set to the dataset's
+ * file; every OutputFileFilterParameter of a writer gets the name of the input file appended, see OutputPath(), and
+ * every OutputPathFilterParameter points into a directory of the dataset's own, see OutputDirectory().
+ */
+class BatchPipelineRunner : public QObject
+{
+  Q_OBJECT
+
+public:
+  BatchPipelineRunner(QObject* parent = nullptr);
+  ~BatchPipelineRunner() override;
+
+  /**
+   * @brief The outcome of one dataset
+   */
+  struct Dataset
+  {
+    int index = -1;
+    QString input;
+    qint64 readMilliseconds = 0;
+    qint64 computeMilliseconds = 0;
+    qint64 writeMilliseconds = 0;
+    int err = 0;
+    QString errorMessage;
+  };
+
+  /**
+   * @brief The outcome of the whole batch. The stage times add up to more than the elapsed time by as much as
+   * the stages overlapped.
+   */
+  struct Summary
+  {
+    int datasets = 0;
+    int succeeded = 0;
+    int failed = 0;
+    bool canceled = false;
+    qint64 milliseconds = 0;
+    qint64 readMilliseconds = 0;
+    qint64 computeMilliseconds = 0;
+    qint64 writeMilliseconds = 0;
+  };
+
+  /**
+   * @brief Returns the path a writer writes to for one dataset: the input's base name is appended to the base
+   * name of the path, for example out/Result.dream3d becomes out/Result_Slice_042.dream3d
+   * @param path
+   * @param input
+   * @return
+   */
+  static QString OutputPath(const QString& path, const QString& input);
+
+  /**
+   * @brief Returns the directory a writer that takes a directory writes to for one dataset: a subdirectory named
+   * after the input's base name, for example out becomes out/Slice_042
+   * @param directory
+   * @param input
+   * @return
+   */
+  static QString OutputDirectory(const QString& directory, const QString& input);
+
+  /**
+   * @brief Starts the batch once the memory governor admits it. The finished signal is emitted when all datasets
+   * have been written or have failed.
+   * @param pipeline A pipeline that has been preflighted
+   * @param filterIndex The reader whose parameter is set to each input
+   * @param propertyName
+   * @param inputs
+   * @return False if a batch is already running or there is nothing to run
+   */
+  bool start(FilterPipeline::Pointer pipeline, int filterIndex, const QString& propertyName, const QStringList& inputs);
+
+  /**
+   * @brief isRunning
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief Stops the running stages after their current filter and starts no others
+   */
+  void cancel();
+
+signals:
+  /**
+   * @brief Emitted when a dataset has been written or has failed
+   * @param dataset
+   * @param done The number of datasets that are finished
+   * @param count
+   */
+  void datasetFinished(const BatchPipelineRunner::Dataset& dataset, int done, int count);
+
+  void finished(const BatchPipelineRunner::Summary& summary);
+
+protected slots:
+  void ioFinished(const AsyncWriteService::Result& result);
+  void computeFinished();
+
+  /**
+   * @brief Runs on a worker thread and keeps the last error a filter reported
+   * @param msg
+   */
+  void filterMessage(const PipelineMessage& msg);
+
+private:
+  enum class State : int
+  {
+    Pending,
+    Reading,
+    Read,
+    Computing,
+    Computed,
+    Writing,
+    Done
+  };
+
+  /**
+   * @brief One stage of one dataset as it runs on a worker thread
+   */
+  struct StageResult
+  {
+    int dataset = -1;
+    qint64 milliseconds = 0;
+    bool canceled = false;
+    int err = 0;
+    QString errorMessage;
+  };
+
+  QFutureWatcher<StageResult> m_ComputeWatcher;
+  std::atomic<bool> m_Cancel;
+  bool m_Running = false;
+  QMutex m_Mutex;
+  QVector<AbstractFilter::Pointer> m_CurrentFilters;
+  QString m_LastError;
+  QHash<int, int> m_Jobs; // The datasets of the queued and running I/O jobs by job ID
+
+  FilterPipeline::Pointer m_Pipeline;
+  QVector<int> m_Enabled; // Indices of the filters that run, in pipeline order
+  int m_ComputeBegin = 0; // Where the stages start in m_Enabled
+  int m_WriteBegin = 0;
+  int m_InputFilter = -1;
+  QString m_InputProperty;
+  qint64 m_DatasetBytes = 0;
+  qint64 m_Budget = 0;
+
+  QVector<Dataset> m_Datasets;
+  QVector<State> m_States;
+  QVector<QVector<AbstractFilter::Pointer>> m_Filters;
+  QVector<DataContainerArray::Pointer> m_Data;
+  int m_Done = 0;
+  QElapsedTimer m_Clock;
+
+  void begin();
+  void schedule();
+  bool startRead();
+  void startCompute(int dataset);
+  void submitIO(int dataset, State state, int begin, int end);
+  StageResult runStage(int dataset, QVector<AbstractFilter::Pointer> filters, DataContainerArray::Pointer dca);
+  void stageFinished(const StageResult& result, State next);
+  void finishDataset(int dataset);
+  int heldDatasets() const;
+
+public:
+  BatchPipelineRunner(const BatchPipelineRunner&) = delete;            // Copy Constructor Not Implemented
+  BatchPipelineRunner(BatchPipelineRunner&&) = delete;                 // Move Constructor Not Implemented
+  BatchPipelineRunner& operator=(const BatchPipelineRunner&) = delete; // Copy Assignment Not Implemented
+  BatchPipelineRunner& operator=(BatchPipelineRunner&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,446 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "EventLoopWatchdog.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMap>
+#include <QtCore/QPair>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+
+#if defined(Q_OS_LINUX)
+#include <csignal>
+#include <cstdlib>
+#include <execinfo.h>
+#include <pthread.h>
+#endif
+
+namespace
+{
+const int k_HeartbeatInterval = 100;
+const int k_PollInterval = 100;
+const int k_DefaultThreshold = 2000;
+const int k_StackTimeout = 500;
+const qint64 k_MaxReportFileSize = 512 * 1024;
+const int k_MaxReportFiles = 3;
+const QString k_ReportFileName("EventLoopStalls");
+
+// The action the GUI thread is busy with. Only ever points at string literals.
+std::atomic<const char*> s_CurrentAction(nullptr);
+
+#if defined(Q_OS_LINUX)
+const int k_MaxFrames = 64;
+void* s_Frames[k_MaxFrames];
+std::atomic<int> s_FrameCount(0);
+std::atomic<bool> s_StackReady(false);
+pthread_t s_GuiThread;
+
+/**
+ * @brief Runs on the GUI thread when the watchdog interrupts it. Only records the raw frames; they are
+ * turned into symbols on the watchdog thread.
+ */
+void CaptureStackHandler(int)
+{
+  s_FrameCount.store(backtrace(s_Frames, k_MaxFrames));
+  s_StackReady.store(true);
+}
+
+/**
+ * @brief Interrupts the GUI thread and returns its stack as text
+ */
+QString CaptureGuiStack()
+{
+  s_StackReady.store(false);
+  if(pthread_kill(s_GuiThread, SIGUSR2) != 0)
+  {
+    return QString("    <the GUI thread could not be interrupted>\n");
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  while(!s_StackReady.load() && timer.elapsed() < k_StackTimeout)
+  {
+    QThread::msleep(5);
+  }
+  if(!s_StackReady.load())
+  {
+    return QString("    <the GUI thread did not answer in time>\n");
+  }
+
+  int count = s_FrameCount.load();
+  QString stack;
+  char** symbols = backtrace_symbols(s_Frames, count);
+  if(nullptr == symbols)
+  {
+    return QString("    <the stack could not be symbolized>\n");
+  }
+  // The first two frames are the handler itself and the signal trampoline
+  for(int i = 2; i < count; i++)
+  {
+    stack.append(QString("    #%1 %2\n").arg(i - 2, 2).arg(QString::fromLocal8Bit(symbols[i])));
+  }
+  free(symbols);
+  return stack;
+}
+#else
+QString CaptureGuiStack()
+{
+  return QString("    <stack capture is only available on Linux>\n");
+}
+#endif
+
+/**
+ * @brief Worker thread that runs EventLoopWatchdog::watch()
+ */
+class WatchdogThread : public QThread
+{
+public:
+  WatchdogThread(EventLoopWatchdog* watchdog)
+  : m_Watchdog(watchdog)
+  {
+  }
+
+protected:
+  void run() override
+  {
+    m_Watchdog->watch();
+  }
+
+private:
+  EventLoopWatchdog* m_Watchdog = nullptr;
+};
+
+/**
+ * @brief Returns the path of the report file with the given rotation index; 0 is the current file
+ */
+QString ReportFile(int index)
+{
+  QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+  QString fileName = (index == 0) ? k_ReportFileName + ".log" : QString("%1.%2.log").arg(k_ReportFileName).arg(index);
+  return dirPath + "/" + fileName;
+}
+}
+
+EventLoopWatchdog* EventLoopWatchdog::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EventLoopWatchdog::ActionScope::ActionScope(const char* action)
+: m_Previous(s_CurrentAction.exchange(action))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EventLoopWatchdog::ActionScope::~ActionScope()
+{
+  s_CurrentAction.store(m_Previous);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EventLoopWatchdog::EventLoopWatchdog(QObject* parent)
+: QObject(parent)
+, m_LastBeat(0)
+, m_Running(false)
+, m_Threshold(k_DefaultThreshold)
+{
+  m_HeartbeatTimer.setInterval(k_HeartbeatInterval);
+  connect(&m_HeartbeatTimer, &QTimer::timeout, this, &EventLoopWatchdog::heartbeat);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EventLoopWatchdog::~EventLoopWatchdog()
+{
+  stop();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EventLoopWatchdog* EventLoopWatchdog::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new EventLoopWatchdog();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EventLoopWatchdog::start()
+{
+  if(m_Running.load())
+  {
+    return;
+  }
+
+#if defined(Q_OS_LINUX)
+  s_GuiThread = pthread_self();
+
+  struct sigaction action;
+  action.sa_handler = CaptureStackHandler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGUSR2, &action, nullptr);
+
+  // The first call to backtrace() loads libgcc, which must not happen inside the signal handler
+  void* frames[1];
+  backtrace(frames, 1);
+#endif
+
+  m_Clock.start();
+  m_LastBeat.store(m_Clock.elapsed());
+  m_HeartbeatTimer.start();
+
+  m_Running.store(true);
+  m_Thread = new WatchdogThread(this);
+  m_Thread->start(QThread::LowPriority);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EventLoopWatchdog::stop()
+{
+  if(!m_Running.load())
+  {
+    return;
+  }
+
+  m_Running.store(false);
+  m_HeartbeatTimer.stop();
+  m_Thread->wait();
+  delete m_Thread;
+  m_Thread = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EventLoopWatchdog::setThreshold(int msecs)
+{
+  m_Threshold.store(qMax(k_HeartbeatInterval * 2, msecs));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int EventLoopWatchdog::getThreshold() const
+{
+  return m_Threshold.load();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EventLoopWatchdog::heartbeat()
+{
+  m_LastBeat.store(m_Clock.elapsed());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EventLoopWatchdog::watch()
+{
+  while(m_Running.load())
+  {
+    QThread::msleep(k_PollInterval);
+
+    qint64 lastBeat = m_LastBeat.load();
+    qint64 blockedFor = m_Clock.elapsed() - lastBeat;
+    if(blockedFor < m_Threshold.load())
+    {
+      continue;
+    }
+
+    // The event loop is stuck: record what it is doing now, while it is still stuck, and write it out at once in
+    // case it never recovers
+    QString startedAt = QDateTime::fromMSecsSinceEpoch(QDateTime::currentMSecsSinceEpoch() - blockedFor).toString(Qt::ISODate);
+    const char* currentAction = s_CurrentAction.load();
+    QString action = (nullptr != currentAction) ? QString::fromLatin1(currentAction) : QString("unknown");
+    QString stack = CaptureGuiStack();
+    appendReport(QString("=== Stall at %1 during %2, blocked for %3 ms so far\n").arg(startedAt, action).arg(blockedFor) + stack + "\n");
+    qWarning() << "The event loop has been blocked for" << blockedFor << "ms during" << action;
+
+    while(m_Running.load() && m_LastBeat.load() == lastBeat)
+    {
+      QThread::msleep(k_PollInterval);
+    }
+    if(m_LastBeat.load() == lastBeat)
+    {
+      // Stopped while the event loop was still stuck
+      break;
+    }
+
+    qint64 duration = m_LastBeat.load() - lastBeat;
+    appendReport(QString("=== Stall at %1 ended after %2 ms\n\n").arg(startedAt).arg(duration));
+    qWarning() << "The event loop was blocked for" << duration << "ms during" << action;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EventLoopWatchdog::appendReport(const QString& text)
+{
+  QString filePath = ReportFile(0);
+  QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+  if(QFileInfo(filePath).size() > k_MaxReportFileSize)
+  {
+    QFile::remove(ReportFile(k_MaxReportFiles - 1));
+    for(int i = k_MaxReportFiles - 2; i >= 0; i--)
+    {
+      QFile::rename(ReportFile(i), ReportFile(i + 1));
+    }
+  }
+
+  QFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+  {
+    qWarning() << "Could not write the event loop stall report to" << filePath;
+    return;
+  }
+
+  QTextStream out(&file);
+  out << text;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString EventLoopWatchdog::ReportFilePath()
+{
+  return ReportFile(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString EventLoopWatchdog::ReadReports()
+{
+  QString reports;
+  for(int i = k_MaxReportFiles - 1; i >= 0; i--)
+  {
+    QFile file(ReportFile(i));
+    if(file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+      reports.append(QString::fromUtf8(file.readAll()));
+    }
+  }
+  return reports;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString EventLoopWatchdog::Summarize(const QString& reports)
+{
+  QRegularExpression startExp("^=== Stall at (\\S+) during (.*), blocked for (\\d+) ms so far$", QRegularExpression::MultilineOption);
+  QRegularExpression endExp("^=== Stall at (\\S+) ended after (\\d+) ms$", QRegularExpression::MultilineOption);
+
+  // A stall that has no end line never recovered, or the application was killed; it counts with the time it
+  // had been blocked for when it was written
+  QMap<QString, qint64> ended;
+  QRegularExpressionMatchIterator endIter = endExp.globalMatch(reports);
+  while(endIter.hasNext())
+  {
+    QRegularExpressionMatch match = endIter.next();
+    ended[match.captured(1)] = match.captured(2).toLongLong();
+  }
+
+  int count = 0;
+  int unfinished = 0;
+  qint64 total = 0;
+  qint64 longest = 0;
+  QString longestAt;
+  QMap<QString, QPair<int, qint64>> perAction;
+
+  QRegularExpressionMatchIterator iter = startExp.globalMatch(reports);
+  while(iter.hasNext())
+  {
+    QRegularExpressionMatch match = iter.next();
+    qint64 duration = ended.value(match.captured(1), match.captured(3).toLongLong());
+    QString action = match.captured(2).trimmed();
+
+    count++;
+    unfinished += ended.contains(match.captured(1)) ? 0 : 1;
+    total += duration;
+    if(duration > longest)
+    {
+      longest = duration;
+      longestAt = match.captured(1);
+    }
+    QPair<int, qint64>& entry = perAction[action];
+    entry.first++;
+    entry.second += duration;
+  }
+
+  if(count == 0)
+  {
+    return QObject::tr("No event loop stalls have been recorded.");
+  }
+
+  QStringList lines;
+  lines << QObject::tr("%1 stalls, %2 s in total").arg(count).arg(total / 1000.0, 0, 'f', 1);
+  lines << QObject::tr("Longest: %1 ms at %2").arg(longest).arg(longestAt);
+  if(unfinished > 0)
+  {
+    lines << QObject::tr("%1 stalls did not end while they were watched").arg(unfinished);
+  }
+  lines << QString() << QObject::tr("By action:");
+  for(QMap<QString, QPair<int, qint64>>::const_iterator actionIter = perAction.constBegin(); actionIter != perAction.constEnd(); ++actionIter)
+  {
+    lines << QObject::tr("    %1: %2 stalls, %3 ms").arg(actionIter.key()).arg(actionIter.value().first).arg(actionIter.value().second);
+  }
+  return lines.join("\n");
+}
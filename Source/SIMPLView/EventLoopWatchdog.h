@@ -0,0 +1,158 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+
+class QThread;
+
+/**
+ * @brief The EventLoopWatchdog class detects stalls of the GUI event loop. A timer on the GUI thread
+ * records a heartbeat and a separate thread checks that the heartbeat keeps advancing. When the event loop
+ * has not run for longer than the threshold the watchdog captures the GUI thread's stack (on Linux, by
+ * interrupting the thread with SIGUSR2) together with the action that the GUI thread announced through an
+ * ActionScope. The stack and the action are appended to a rotating report file in the application data
+ * folder right away, so a stall that never ends is on disk before the application is killed; once the event
+ * loop runs again a second line records how long the stall lasted.
+ */
+class EventLoopWatchdog : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~EventLoopWatchdog() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static EventLoopWatchdog* Instance();
+
+  /**
+   * @brief Marks the GUI thread as busy with a named action for the lifetime of the scope. The name must be
+   * a string literal because the watchdog thread reads it while the scope is alive.
+   */
+  class ActionScope
+  {
+  public:
+    ActionScope(const char* action);
+    ~ActionScope();
+
+  private:
+    const char* m_Previous = nullptr;
+
+  public:
+    ActionScope(const ActionScope&) = delete;            // Copy Constructor Not Implemented
+    ActionScope(ActionScope&&) = delete;                 // Move Constructor Not Implemented
+    ActionScope& operator=(const ActionScope&) = delete; // Copy Assignment Not Implemented
+    ActionScope& operator=(ActionScope&&) = delete;      // Move Assignment Not Implemented
+  };
+
+  /**
+   * @brief Starts the heartbeat and the watchdog thread. Must be called on the GUI thread.
+   */
+  void start();
+
+  /**
+   * @brief Stops the watchdog thread
+   */
+  void stop();
+
+  /**
+   * @brief Sets how long the event loop may be blocked before it counts as a stall
+   * @param msecs
+   */
+  void setThreshold(int msecs);
+
+  /**
+   * @brief getThreshold
+   * @return
+   */
+  int getThreshold() const;
+
+  /**
+   * @brief Returns the path of the current report file
+   * @return
+   */
+  static QString ReportFilePath();
+
+  /**
+   * @brief Returns the contents of the report files, oldest first
+   * @return
+   */
+  static QString ReadReports();
+
+  /**
+   * @brief Summarizes the reports: the number of stalls, the longest one and the time lost per action
+   * @param reports
+   * @return
+   */
+  static QString Summarize(const QString& reports);
+
+  /**
+   * @brief Runs on the watchdog thread
+   */
+  void watch();
+
+protected:
+  EventLoopWatchdog(QObject* parent = nullptr);
+
+protected slots:
+  void heartbeat();
+
+private:
+  static EventLoopWatchdog* self;
+
+  QTimer m_HeartbeatTimer;
+  QElapsedTimer m_Clock;
+  QThread* m_Thread = nullptr;
+  std::atomic<qint64> m_LastBeat;
+  std::atomic<bool> m_Running;
+  std::atomic<int> m_Threshold;
+
+  void appendReport(const QString& text);
+
+public:
+  EventLoopWatchdog(const EventLoopWatchdog&) = delete;            // Copy Constructor Not Implemented
+  EventLoopWatchdog(EventLoopWatchdog&&) = delete;                 // Move Constructor Not Implemented
+  EventLoopWatchdog& operator=(const EventLoopWatchdog&) = delete; // Copy Assignment Not Implemented
+  EventLoopWatchdog& operator=(EventLoopWatchdog&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,416 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ExecutionEventLog.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
+
+#include "SIMPLView/TraceRecorder.h"
+
+namespace
+{
+const QString k_LogFileName("ExecutionEvents");
+
+// Pending events are written at least this often even if nobody wakes the writer
+const unsigned long k_FlushInterval = 1000;
+
+/**
+ * @brief The thread that appends the recorded events to the log file
+ */
+class ExecutionLogThread : public QThread
+{
+public:
+  ExecutionLogThread(ExecutionEventLog* log)
+  : m_Log(log)
+  {
+  }
+
+protected:
+  void run() override
+  {
+    m_Log->writeEntries();
+  }
+
+private:
+  ExecutionEventLog* m_Log = nullptr;
+};
+
+/**
+ * @brief Returns the process wide monotonic clock of the log
+ */
+const QElapsedTimer& Clock()
+{
+  static QElapsedTimer clock = [] {
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+  }();
+  return clock;
+}
+}
+
+ExecutionEventLog* ExecutionEventLog::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionEventLog::ExecutionEventLog()
+{
+  Clock();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionEventLog::~ExecutionEventLog()
+{
+  stop();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionEventLog* ExecutionEventLog::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new ExecutionEventLog();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ExecutionEventLog::Timestamp()
+{
+  return Clock().nsecsElapsed();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ExecutionEventLog::LogFilePath(int index)
+{
+  QString dirPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+  QString fileName = (index == 0) ? k_LogFileName + ".jsonl" : QString("%1.%2.jsonl").arg(k_LogFileName).arg(index);
+  return dirPath + "/" + fileName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ExecutionEventLog::MessageTypeName(PipelineMessage::MessageType type)
+{
+  switch(type)
+  {
+  case PipelineMessage::MessageType::Error:
+    return "error";
+  case PipelineMessage::MessageType::Warning:
+    return "warning";
+  case PipelineMessage::MessageType::StatusMessage:
+    return "status";
+  case PipelineMessage::MessageType::StandardOutputMessage:
+    return "stdout";
+  case PipelineMessage::MessageType::ProgressValue:
+    return "progress";
+  case PipelineMessage::MessageType::StatusMessageAndProgressValue:
+    return "status_progress";
+  default:
+    break;
+  }
+  return "unknown";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::start()
+{
+  if(nullptr != m_Thread)
+  {
+    return;
+  }
+
+  m_Stopping = false;
+  m_Thread = new ExecutionLogThread(this);
+  m_Thread->start(QThread::LowPriority);
+
+  QJsonObject fields;
+  fields["pid"] = QCoreApplication::applicationPid();
+  fields["wall"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+  fields["application"] = QCoreApplication::applicationName();
+  fields["version"] = QCoreApplication::applicationVersion();
+  record("session_start", QString(), 0, -1, fields);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::stop()
+{
+  if(nullptr == m_Thread)
+  {
+    return;
+  }
+
+  record("session_end", QString(), 0, -1);
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_Stopping = true;
+    m_Pending.wakeAll();
+  }
+  m_Thread->wait();
+  delete m_Thread;
+  m_Thread = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ExecutionEventLog::newPipelineId()
+{
+  QMutexLocker locker(&m_Mutex);
+  return QString("%1-%2").arg(QCoreApplication::applicationPid()).arg(m_NextPipelineId++);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::record(const QString& type, const QString& pipelineId, int run, int filterIndex, const QJsonObject& fields)
+{
+  Entry entry;
+  entry.timestamp = Timestamp();
+  entry.type = type;
+  entry.pipelineId = pipelineId;
+  entry.run = run;
+  entry.filterIndex = filterIndex;
+  entry.fields = fields;
+
+  QMutexLocker locker(&m_Mutex);
+  m_Entries.push_back(entry);
+  // Errors and the end of a run are worth having on disk right away in case the application goes down with them
+  if(type == "error" || type == "execution_finished")
+  {
+    m_Pending.wakeAll();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::recordMessage(const QString& pipelineId, int run, const PipelineMessage& msg)
+{
+  QJsonObject fields;
+  fields["class"] = msg.getFilterClassName();
+  fields["label"] = msg.getFilterHumanLabel();
+  if(msg.getType() == PipelineMessage::MessageType::ProgressValue || msg.getType() == PipelineMessage::MessageType::StatusMessageAndProgressValue)
+  {
+    fields["progress"] = msg.getProgressValue();
+  }
+  if(msg.getType() != PipelineMessage::MessageType::ProgressValue)
+  {
+    fields["code"] = msg.getCode();
+    fields["text"] = msg.getText();
+  }
+
+  QString type = MessageTypeName(msg.getType());
+  if(type != "error" && type != "warning")
+  {
+    fields["kind"] = type;
+    type = "message";
+  }
+  record(type, pipelineId, run, msg.getPipelineIndex(), fields);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::writeEntries()
+{
+  QVector<Entry> entries;
+  bool stopping = false;
+  while(!stopping)
+  {
+    {
+      QMutexLocker locker(&m_Mutex);
+      if(m_Entries.isEmpty() && !m_Stopping)
+      {
+        m_Pending.wait(&m_Mutex, k_FlushInterval);
+      }
+      entries.swap(m_Entries);
+      stopping = m_Stopping;
+    }
+
+    if(entries.isEmpty())
+    {
+      continue;
+    }
+
+    QString filePath = LogFilePath(0);
+    if(!m_File.isOpen())
+    {
+      QDir().mkpath(QFileInfo(filePath).absolutePath());
+      m_File.setFileName(filePath);
+      if(!m_File.open(QIODevice::WriteOnly | QIODevice::Append))
+      {
+        qWarning() << "Could not open the execution event log" << filePath;
+        entries.clear();
+        continue;
+      }
+    }
+
+    {
+      SV_TRACE_SCOPE_CATEGORY("Write Execution Events", "io");
+      for(const Entry& entry : entries)
+      {
+        writeEntry(entry);
+      }
+      entries.clear();
+      m_File.flush();
+    }
+
+    if(m_File.size() > MaxFileSize)
+    {
+      m_File.close();
+      QFile::remove(LogFilePath(MaxFiles - 1));
+      for(int i = MaxFiles - 2; i >= 0; i--)
+      {
+        QFile::rename(LogFilePath(i), LogFilePath(i + 1));
+      }
+    }
+  }
+
+  m_File.close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::writeEntry(const Entry& entry)
+{
+  if(entry.pipelineId.isEmpty() || entry.run <= 0)
+  {
+    writeLine(entry.timestamp, entry.type, entry.pipelineId, entry.run, entry.filterIndex, entry.fields);
+    return;
+  }
+
+  // A run moves on to the next filter when its messages start to carry the next pipeline index
+  QString key = QString("%1/%2").arg(entry.pipelineId).arg(entry.run);
+  bool isMessage = (entry.type == "message" || entry.type == "warning" || entry.type == "error");
+  if(isMessage && entry.filterIndex >= 0)
+  {
+    OpenFilter& open = m_OpenFilters[key];
+    if(open.index != entry.filterIndex)
+    {
+      closeFilter(key, entry);
+
+      OpenFilter& next = m_OpenFilters[key];
+      next.index = entry.filterIndex;
+      next.started = entry.timestamp;
+      next.className = entry.fields["class"].toString();
+      next.humanLabel = entry.fields["label"].toString();
+
+      QJsonObject fields;
+      fields["class"] = next.className;
+      fields["label"] = next.humanLabel;
+      writeLine(entry.timestamp, "filter_start", entry.pipelineId, entry.run, entry.filterIndex, fields);
+    }
+  }
+
+  if(entry.type == "execution_finished" || entry.type == "cancel")
+  {
+    closeFilter(key, entry);
+    if(entry.type == "execution_finished")
+    {
+      m_OpenFilters.remove(key);
+    }
+  }
+
+  writeLine(entry.timestamp, entry.type, entry.pipelineId, entry.run, entry.filterIndex, entry.fields);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::closeFilter(const QString& key, const Entry& entry)
+{
+  QHash<QString, OpenFilter>::iterator iter = m_OpenFilters.find(key);
+  if(iter == m_OpenFilters.end() || iter.value().index < 0)
+  {
+    return;
+  }
+
+  const OpenFilter& open = iter.value();
+  QJsonObject fields;
+  fields["class"] = open.className;
+  fields["label"] = open.humanLabel;
+  fields["duration_ns"] = entry.timestamp - open.started;
+  writeLine(entry.timestamp, "filter_end", entry.pipelineId, entry.run, open.index, fields);
+  iter.value().index = -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionEventLog::writeLine(qint64 timestamp, const QString& type, const QString& pipelineId, int run, int filterIndex, QJsonObject fields)
+{
+  fields["t"] = timestamp;
+  fields["type"] = type;
+  if(!pipelineId.isEmpty())
+  {
+    fields["pipeline"] = pipelineId;
+  }
+  if(run > 0)
+  {
+    fields["run"] = run;
+  }
+  if(filterIndex >= 0)
+  {
+    fields["filter"] = filterIndex;
+  }
+
+  m_File.write(QJsonDocument(fields).toJson(QJsonDocument::Compact));
+  m_File.write("\n");
+}
@@ -0,0 +1,181 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+
+class QThread;
+
+/**
+ * @brief The ExecutionEventLog class keeps an append-only record of everything that happens to the pipelines
+ * of the application: every PipelineMessage, preflights, execution requests, cancels, errors and the end of each
+ * run. Each event is one Json object on its own line (JSON Lines) in ExecutionEvents.jsonl in the application
+ * data folder, with a monotonic timestamp in nanoseconds ("t"), the pipeline ID ("pipeline"), the run number
+ * ("run") and the filter index ("filter") where they apply.
+ *
+ * Events are recorded from any thread without touching the disk; a background thread serializes and appends
+ * them and rotates the file by size. The writer also infers filter_start and filter_end events from the change
+ * of pipeline index between consecutive messages of a run, so that a log can be summarized per filter.
+ */
+class ExecutionEventLog
+{
+public:
+  ~ExecutionEventLog();
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static ExecutionEventLog* Instance();
+
+  /**
+   * @brief Returns the monotonic time in nanoseconds since the log was created
+   * @return
+   */
+  static qint64 Timestamp();
+
+  /**
+   * @brief Returns the path of a log file; index 0 is the current file, higher indices are older
+   * @param index
+   * @return
+   */
+  static QString LogFilePath(int index = 0);
+
+  /**
+   * @brief Returns a name for a message type as it appears in the log
+   * @param type
+   * @return
+   */
+  static QString MessageTypeName(PipelineMessage::MessageType type);
+
+  /**
+   * @brief Starts the writer thread and records the start of the session
+   */
+  void start();
+
+  /**
+   * @brief Writes what is still pending and stops the writer thread
+   */
+  void stop();
+
+  /**
+   * @brief Returns a new ID that identifies one pipeline window's events for the rest of the session
+   * @return
+   */
+  QString newPipelineId();
+
+  /**
+   * @brief Records an event. Safe to call from any thread; never waits for the disk.
+   * @param type
+   * @param pipelineId
+   * @param run The run number, or 0 for events that do not belong to a run
+   * @param filterIndex The filter index, or -1 for events that do not belong to a filter
+   * @param fields Additional fields of the event
+   */
+  void record(const QString& type, const QString& pipelineId, int run, int filterIndex, const QJsonObject& fields = QJsonObject());
+
+  /**
+   * @brief Records a message of a running pipeline
+   * @param pipelineId
+   * @param run
+   * @param msg
+   */
+  void recordMessage(const QString& pipelineId, int run, const PipelineMessage& msg);
+
+  /**
+   * @brief Runs on the writer thread
+   */
+  void writeEntries();
+
+  static const qint64 MaxFileSize = 8 * 1024 * 1024;
+  static const int MaxFiles = 5;
+
+protected:
+  ExecutionEventLog();
+
+private:
+  static ExecutionEventLog* self;
+
+  struct Entry
+  {
+    qint64 timestamp = 0;
+    QString type;
+    QString pipelineId;
+    int run = 0;
+    int filterIndex = -1;
+    QJsonObject fields;
+  };
+
+  /**
+   * @brief The filter that a run is currently in, as seen by the writer
+   */
+  struct OpenFilter
+  {
+    int index = -1;
+    qint64 started = 0;
+    QString className;
+    QString humanLabel;
+  };
+
+  QMutex m_Mutex;
+  QWaitCondition m_Pending;
+  QVector<Entry> m_Entries;
+  bool m_Stopping = false;
+  int m_NextPipelineId = 1;
+  QThread* m_Thread = nullptr;
+
+  // Only used by the writer thread
+  QFile m_File;
+  QHash<QString, OpenFilter> m_OpenFilters;
+
+  void writeEntry(const Entry& entry);
+  void writeLine(qint64 timestamp, const QString& type, const QString& pipelineId, int run, int filterIndex, QJsonObject fields);
+  void closeFilter(const QString& key, const Entry& entry);
+
+public:
+  ExecutionEventLog(const ExecutionEventLog&) = delete;            // Copy Constructor Not Implemented
+  ExecutionEventLog(ExecutionEventLog&&) = delete;                 // Move Constructor Not Implemented
+  ExecutionEventLog& operator=(const ExecutionEventLog&) = delete; // Copy Assignment Not Implemented
+  ExecutionEventLog& operator=(ExecutionEventLog&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,449 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ExecutionHistory.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+#include <QtCore/QVariant>
+
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlQuery>
+
+namespace
+{
+const QString k_FileName("ExecutionHistory.sqlite");
+const QString k_WriterConnection("ExecutionHistoryWriter");
+const int k_SchemaVersion = 1;
+
+/**
+ * @brief The thread that inserts the recorded runs into the database
+ */
+class ExecutionHistoryThread : public QThread
+{
+public:
+  ExecutionHistoryThread(ExecutionHistory* history)
+  : m_History(history)
+  {
+  }
+
+protected:
+  void run() override
+  {
+    m_History->writeRuns();
+  }
+
+private:
+  ExecutionHistory* m_History = nullptr;
+};
+
+/**
+ * @brief Returns a time as it is stored in the database; the format sorts like the times it holds
+ */
+QString TimeString(const QDateTime& time)
+{
+  return time.toUTC().toString(Qt::ISODateWithMs);
+}
+}
+
+ExecutionHistory* ExecutionHistory::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionHistory::ExecutionHistory() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionHistory::~ExecutionHistory()
+{
+  stop();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionHistory* ExecutionHistory::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new ExecutionHistory();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ExecutionHistory::DatabasePath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/" + k_FileName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionHistory::Open(const QString& connectionName, const QString& filePath, QString* errorMessage)
+{
+  QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+  QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+  db.setDatabaseName(filePath);
+  // The writer and a history view may use the database at the same time
+  db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+  if(!db.open())
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = db.lastError().text();
+    }
+    return false;
+  }
+
+  QStringList statements;
+  statements << "PRAGMA journal_mode=WAL"
+             << "CREATE TABLE IF NOT EXISTS runs (id INTEGER PRIMARY KEY AUTOINCREMENT, started TEXT NOT NULL, pipeline_hash TEXT, pipeline_name TEXT, "
+                "host TEXT, version TEXT, plugin_versions TEXT, input_tuples INTEGER, seconds REAL, peak_memory INTEGER, status TEXT)"
+             << "CREATE TABLE IF NOT EXISTS filter_timings (run_id INTEGER NOT NULL REFERENCES runs(id) ON DELETE CASCADE, filter_index INTEGER, "
+                "class_name TEXT NOT NULL, seconds REAL)"
+             << "CREATE INDEX IF NOT EXISTS runs_started ON runs(started)"
+             << "CREATE INDEX IF NOT EXISTS filter_timings_class ON filter_timings(class_name, run_id)"
+             << QString("PRAGMA user_version=%1").arg(k_SchemaVersion);
+
+  QSqlQuery query(db);
+  for(const QString& statement : statements)
+  {
+    if(!query.exec(statement))
+    {
+      if(nullptr != errorMessage)
+      {
+        *errorMessage = query.lastError().text();
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionHistory::OpenReadOnly(const QString& connectionName, const QString& filePath, QString* errorMessage)
+{
+  QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+  db.setDatabaseName(filePath);
+  // In WAL mode readers do not wait for the writer, so a short timeout only covers a checkpoint in progress
+  db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=100");
+  if(!db.open())
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = db.lastError().text();
+    }
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionHistory::Close(const QString& connectionName)
+{
+  {
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    db.close();
+  }
+  QSqlDatabase::removeDatabase(connectionName);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ExecutionHistory::Run> ExecutionHistory::RecentRuns(const QSqlDatabase& db, int limit)
+{
+  QVector<Run> runs;
+  QSqlQuery query(db);
+  query.prepare("SELECT started, pipeline_hash, pipeline_name, host, version, plugin_versions, input_tuples, seconds, peak_memory, status "
+                "FROM runs ORDER BY id DESC LIMIT ?");
+  query.addBindValue(limit);
+  if(!query.exec())
+  {
+    qDebug() << "Could not read the execution history:" << query.lastError().text();
+    return runs;
+  }
+
+  while(query.next())
+  {
+    Run run;
+    run.started = QDateTime::fromString(query.value(0).toString(), Qt::ISODateWithMs).toLocalTime();
+    run.pipelineHash = query.value(1).toString();
+    run.pipelineName = query.value(2).toString();
+    run.host = query.value(3).toString();
+    run.version = query.value(4).toString();
+    run.pluginVersions = query.value(5).toString();
+    run.inputTuples = query.value(6).toLongLong();
+    run.seconds = query.value(7).toDouble();
+    run.peakMemory = query.value(8).toLongLong();
+    run.status = query.value(9).toString();
+    runs.push_back(run);
+  }
+  return runs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ExecutionHistory::Trend> ExecutionHistory::FilterTrends(const QSqlDatabase& db, int recentDays, int baselineDays, const QString& className)
+{
+  QDateTime now = QDateTime::currentDateTime();
+  QString recentStart = TimeString(now.addDays(-recentDays));
+  QString baselineStart = TimeString(now.addDays(-recentDays - baselineDays));
+
+  // Times per million tuples only compare runs on different inputs fairly if every run knows its input size
+  QString sql = "SELECT f.class_name, "
+                "SUM(CASE WHEN r.started < ? THEN 1 ELSE 0 END), "
+                "SUM(CASE WHEN r.started >= ? THEN 1 ELSE 0 END), "
+                "AVG(CASE WHEN r.started < ? THEN f.seconds END), "
+                "AVG(CASE WHEN r.started >= ? THEN f.seconds END), "
+                "AVG(CASE WHEN r.started < ? AND r.input_tuples > 0 THEN f.seconds * 1000000.0 / r.input_tuples END), "
+                "AVG(CASE WHEN r.started >= ? AND r.input_tuples > 0 THEN f.seconds * 1000000.0 / r.input_tuples END), "
+                "SUM(CASE WHEN r.input_tuples > 0 THEN 0 ELSE 1 END) "
+                "FROM filter_timings f JOIN runs r ON r.id = f.run_id "
+                "WHERE r.status = 'finished' AND r.started >= ?";
+  if(!className.isEmpty())
+  {
+    sql += " AND f.class_name = ?";
+  }
+  sql += " GROUP BY f.class_name";
+
+  QVector<Trend> trends;
+  QSqlQuery query(db);
+  query.prepare(sql);
+  for(int i = 0; i < 6; i++)
+  {
+    query.addBindValue(recentStart);
+  }
+  query.addBindValue(baselineStart);
+  if(!className.isEmpty())
+  {
+    query.addBindValue(className);
+  }
+  if(!query.exec())
+  {
+    qDebug() << "Could not query the execution history:" << query.lastError().text();
+    return trends;
+  }
+
+  while(query.next())
+  {
+    Trend trend;
+    trend.className = query.value(0).toString();
+    trend.baselineCount = query.value(1).toInt();
+    trend.recentCount = query.value(2).toInt();
+    trend.normalized = (query.value(7).toInt() == 0);
+    trend.baseline = query.value(trend.normalized ? 5 : 3).toDouble();
+    trend.recent = query.value(trend.normalized ? 6 : 4).toDouble();
+    trends.push_back(trend);
+  }
+
+  std::sort(trends.begin(), trends.end(), [](const Trend& a, const Trend& b) { return a.change() > b.change(); });
+  return trends;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionHistory::IsRegression(const Trend& trend, double threshold)
+{
+  return trend.baselineCount >= MinimumSamples && trend.recentCount >= MinimumSamples && trend.change() > threshold;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionHistory::start()
+{
+  if(nullptr != m_Thread)
+  {
+    return;
+  }
+
+  m_Stopping = false;
+  m_Thread = new ExecutionHistoryThread(this);
+  m_Thread->start(QThread::LowPriority);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionHistory::stop()
+{
+  if(nullptr == m_Thread)
+  {
+    return;
+  }
+
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_Stopping = true;
+    m_Pending.wakeAll();
+  }
+  m_Thread->wait();
+  delete m_Thread;
+  m_Thread = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionHistory::record(const Run& run)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Runs.push_back(run);
+  m_Pending.wakeAll();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionHistory::writeRuns()
+{
+  bool open = false;
+  QVector<Run> runs;
+  bool stopping = false;
+  while(!stopping)
+  {
+    {
+      QMutexLocker locker(&m_Mutex);
+      if(m_Runs.isEmpty() && !m_Stopping)
+      {
+        m_Pending.wait(&m_Mutex);
+      }
+      runs.swap(m_Runs);
+      stopping = m_Stopping;
+    }
+
+    if(runs.isEmpty())
+    {
+      continue;
+    }
+
+    // The database is only opened once there is something to write
+    if(!open)
+    {
+      QString errorMessage;
+      open = Open(k_WriterConnection, DatabasePath(), &errorMessage);
+      if(!open)
+      {
+        qWarning() << "Could not open the execution history" << DatabasePath() << ":" << errorMessage;
+        Close(k_WriterConnection);
+        runs.clear();
+        continue;
+      }
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(k_WriterConnection, false);
+    for(const Run& run : runs)
+    {
+      if(!Insert(db, run))
+      {
+        qWarning() << "Could not write a run to the execution history:" << db.lastError().text();
+      }
+    }
+    runs.clear();
+  }
+
+  if(open)
+  {
+    Close(k_WriterConnection);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionHistory::Insert(QSqlDatabase& db, const Run& run)
+{
+  if(!db.transaction())
+  {
+    return false;
+  }
+
+  QSqlQuery query(db);
+  query.prepare("INSERT INTO runs (started, pipeline_hash, pipeline_name, host, version, plugin_versions, input_tuples, seconds, peak_memory, status) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+  query.addBindValue(TimeString(run.started));
+  query.addBindValue(run.pipelineHash);
+  query.addBindValue(run.pipelineName);
+  query.addBindValue(run.host);
+  query.addBindValue(run.version);
+  query.addBindValue(run.pluginVersions);
+  query.addBindValue(run.inputTuples);
+  query.addBindValue(run.seconds);
+  query.addBindValue(run.peakMemory);
+  query.addBindValue(run.status);
+  if(!query.exec())
+  {
+    db.rollback();
+    return false;
+  }
+
+  QVariant runId = query.lastInsertId();
+  query.prepare("INSERT INTO filter_timings (run_id, filter_index, class_name, seconds) VALUES (?, ?, ?, ?)");
+  for(const FilterTiming& filter : run.filters)
+  {
+    query.addBindValue(runId);
+    query.addBindValue(filter.index);
+    query.addBindValue(filter.className);
+    query.addBindValue(filter.seconds);
+    if(!query.exec())
+    {
+      db.rollback();
+      return false;
+    }
+  }
+
+  return db.commit();
+}
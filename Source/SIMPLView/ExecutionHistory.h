@@ -0,0 +1,217 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+class QSqlDatabase;
+class QThread;
+
+/**
+ * @brief The ExecutionHistory class stores the metadata of every pipeline run in a SQLite database,
+ * ExecutionHistory.sqlite in the application data folder: when and where it ran, a hash of the pipeline,
+ * the input size, the SIMPLView and plugin versions, the peak memory, the outcome and the time spent in each
+ * filter. The database answers questions such as whether a filter became slower after an update; see
+ * FilterTrends() and the ExecutionHistoryQuery tool.
+ *
+ * Runs are recorded from the GUI thread without touching the disk; a background thread owns the database
+ * connection and inserts them. This class only depends on QtCore and QtSql so that the tools can use the
+ * queries too.
+ */
+class ExecutionHistory
+{
+public:
+  ~ExecutionHistory();
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static ExecutionHistory* Instance();
+
+  /**
+   * @brief The time one filter of a run took
+   */
+  struct FilterTiming
+  {
+    int index = -1;
+    QString className;
+    double seconds = 0.0;
+  };
+
+  /**
+   * @brief One pipeline run
+   */
+  struct Run
+  {
+    QDateTime started;
+    QString pipelineHash;
+    QString pipelineName;
+    QString host;
+    QString version;
+    QString pluginVersions; // Json object of plugin name to version
+    qint64 inputTuples = 0;
+    double seconds = 0.0;
+    qint64 peakMemory = 0;
+    QString status; // "finished", "canceled" or "failed"
+    QVector<FilterTiming> filters;
+  };
+
+  /**
+   * @brief How the time of one filter class changed between a baseline period and a recent period.
+   * Times are normalized to seconds per million input tuples where the runs know their input size.
+   */
+  struct Trend
+  {
+    QString className;
+    int baselineCount = 0;
+    int recentCount = 0;
+    double baseline = 0.0;
+    double recent = 0.0;
+    bool normalized = false;
+
+    double change() const
+    {
+      return (baseline > 0.0) ? (recent - baseline) / baseline : 0.0;
+    }
+  };
+
+  /**
+   * @brief Returns the path of the database
+   * @return
+   */
+  static QString DatabasePath();
+
+  /**
+   * @brief Opens the database under its own connection name and creates the tables if needed. The connection
+   * may only be used from the thread that opened it.
+   * @param connectionName
+   * @param filePath
+   * @param errorMessage
+   * @return True on success
+   */
+  static bool Open(const QString& connectionName, const QString& filePath, QString* errorMessage = nullptr);
+
+  /**
+   * @brief Opens an existing database for reading only, without creating or changing anything, so that viewing
+   * the history stays cheap and never waits for the writer. Same threading rules as Open().
+   * @param connectionName
+   * @param filePath
+   * @param errorMessage
+   * @return True on success
+   */
+  static bool OpenReadOnly(const QString& connectionName, const QString& filePath, QString* errorMessage = nullptr);
+
+  /**
+   * @brief Closes and removes a connection that Open() created
+   * @param connectionName
+   */
+  static void Close(const QString& connectionName);
+
+  /**
+   * @brief Returns the most recent runs, newest first, without their filter timings
+   * @param db
+   * @param limit
+   * @return
+   */
+  static QVector<Run> RecentRuns(const QSqlDatabase& db, int limit);
+
+  /**
+   * @brief Compares the finished runs of the last recentDays to those of the baselineDays before them
+   * @param db
+   * @param recentDays
+   * @param baselineDays
+   * @param className Only this filter class, or all classes if empty
+   * @return The trends, largest slowdown first
+   */
+  static QVector<Trend> FilterTrends(const QSqlDatabase& db, int recentDays, int baselineDays, const QString& className = QString());
+
+  /**
+   * @brief Returns whether a trend is a regression: slower by more than threshold with at least MinimumSamples
+   * timings on both sides
+   * @param trend
+   * @param threshold 0.2 for 20%
+   * @return
+   */
+  static bool IsRegression(const Trend& trend, double threshold);
+
+  /**
+   * @brief Starts the writer thread
+   */
+  void start();
+
+  /**
+   * @brief Writes what is still pending and stops the writer thread
+   */
+  void stop();
+
+  /**
+   * @brief Queues a run for the writer. Never waits for the disk.
+   * @param run
+   */
+  void record(const Run& run);
+
+  /**
+   * @brief Runs on the writer thread
+   */
+  void writeRuns();
+
+  static const int MinimumSamples = 3;
+
+protected:
+  ExecutionHistory();
+
+private:
+  static ExecutionHistory* self;
+
+  QMutex m_Mutex;
+  QWaitCondition m_Pending;
+  QVector<Run> m_Runs;
+  bool m_Stopping = false;
+  QThread* m_Thread = nullptr;
+
+  static bool Insert(QSqlDatabase& db, const Run& run);
+
+public:
+  ExecutionHistory(const ExecutionHistory&) = delete;            // Copy Constructor Not Implemented
+  ExecutionHistory(ExecutionHistory&&) = delete;                 // Move Constructor Not Implemented
+  ExecutionHistory& operator=(const ExecutionHistory&) = delete; // Copy Assignment Not Implemented
+  ExecutionHistory& operator=(ExecutionHistory&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,123 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ExecutionHistoryDialog.h"
+
+#include <QtCore/QDir>
+#include <QtGui/QColor>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QTabWidget>
+#include <QtWidgets/QTableWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/FilterTimingHistory.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionHistoryDialog::ExecutionHistoryDialog(const QString& filePath, const QVector<ExecutionHistory::Run>& runs, const QVector<ExecutionHistory::Trend>& trends, QWidget* parent)
+: QDialog(parent)
+{
+  setWindowTitle(tr("Execution History"));
+  resize(1000, 600);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  QTabWidget* tabs = new QTabWidget(this);
+  layout->addWidget(tabs);
+
+  QStringList runHeaders = {tr("Started"), tr("Status"), tr("Time"), tr("Input Tuples"), tr("Peak Memory (MB)"), tr("Pipeline"), tr("Hash"), tr("Host"), tr("Version")};
+  QTableWidget* runTable = new QTableWidget(runs.size(), runHeaders.size(), tabs);
+  runTable->setHorizontalHeaderLabels(runHeaders);
+  runTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  for(int row = 0; row < runs.size(); row++)
+  {
+    const ExecutionHistory::Run& run = runs[row];
+    runTable->setItem(row, 0, new QTableWidgetItem(run.started.toString("yyyy-MM-dd HH:mm:ss")));
+    runTable->setItem(row, 1, new QTableWidgetItem(run.status));
+    runTable->setItem(row, 2, new QTableWidgetItem(FilterTimingHistory::FormatDuration(run.seconds)));
+    runTable->setItem(row, 3, new QTableWidgetItem(QString::number(run.inputTuples)));
+    runTable->setItem(row, 4, new QTableWidgetItem(QString::number(run.peakMemory / (1024.0 * 1024.0), 'f', 0)));
+    runTable->setItem(row, 5, new QTableWidgetItem(run.pipelineName));
+    runTable->setItem(row, 6, new QTableWidgetItem(run.pipelineHash));
+    runTable->setItem(row, 7, new QTableWidgetItem(run.host));
+    runTable->setItem(row, 8, new QTableWidgetItem(run.version));
+    runTable->item(row, 8)->setToolTip(run.pluginVersions);
+  }
+  runTable->resizeColumnsToContents();
+  tabs->addTab(runTable, tr("Runs"));
+
+  // Slower by more than 20% in the last week than in the 30 days before is worth a look
+  const double threshold = 0.2;
+  QStringList trendHeaders = {tr("Filter"), tr("Baseline"), tr("Timings"), tr("Last 7 Days"), tr("Timings"), tr("Change")};
+  QTableWidget* trendTable = new QTableWidget(trends.size(), trendHeaders.size(), tabs);
+  trendTable->setHorizontalHeaderLabels(trendHeaders);
+  trendTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  for(int row = 0; row < trends.size(); row++)
+  {
+    const ExecutionHistory::Trend& trend = trends[row];
+    QString unit = trend.normalized ? tr(" s/M tuples") : tr(" s");
+    trendTable->setItem(row, 0, new QTableWidgetItem(trend.className));
+    trendTable->setItem(row, 1, new QTableWidgetItem(QString::number(trend.baseline, 'g', 3) + unit));
+    trendTable->setItem(row, 2, new QTableWidgetItem(QString::number(trend.baselineCount)));
+    trendTable->setItem(row, 3, new QTableWidgetItem(QString::number(trend.recent, 'g', 3) + unit));
+    trendTable->setItem(row, 4, new QTableWidgetItem(QString::number(trend.recentCount)));
+    bool compared = (trend.baselineCount > 0 && trend.recentCount > 0);
+    trendTable->setItem(row, 5, new QTableWidgetItem(compared ? QString("%1%").arg(trend.change() * 100.0, 0, 'f', 1) : QString("-")));
+    if(ExecutionHistory::IsRegression(trend, threshold))
+    {
+      for(int column = 0; column < trendHeaders.size(); column++)
+      {
+        trendTable->item(row, column)->setForeground(QColor(Qt::red));
+      }
+    }
+  }
+  trendTable->resizeColumnsToContents();
+  tabs->addTab(trendTable, tr("Filter Trends"));
+
+  QLabel* pathLabel = new QLabel(tr("The history is stored in %1. The ExecutionHistoryQuery tool reports the same trends on the command line.").arg(QDir::toNativeSeparators(filePath)), this);
+  pathLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  pathLabel->setWordWrap(true);
+  layout->addWidget(pathLabel);
+
+  QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+  connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+  layout->addWidget(buttons);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionHistoryDialog::~ExecutionHistoryDialog() = default;
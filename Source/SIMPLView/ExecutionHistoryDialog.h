@@ -0,0 +1,67 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtWidgets/QDialog>
+
+#include "SIMPLView/ExecutionHistory.h"
+
+/**
+ * @brief The ExecutionHistoryDialog class shows the recent runs from the execution history and, per filter, the
+ * average time of the last week next to the 30 days before it. Filters that became noticeably slower are shown in red.
+ */
+class ExecutionHistoryDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief ExecutionHistoryDialog
+   * @param filePath The database the history was read from
+   * @param runs
+   * @param trends
+   * @param parent
+   */
+  ExecutionHistoryDialog(const QString& filePath, const QVector<ExecutionHistory::Run>& runs, const QVector<ExecutionHistory::Trend>& trends, QWidget* parent = nullptr);
+  ~ExecutionHistoryDialog() override;
+
+  ExecutionHistoryDialog(const ExecutionHistoryDialog&) = delete;            // Copy Constructor Not Implemented
+  ExecutionHistoryDialog(ExecutionHistoryDialog&&) = delete;                 // Move Constructor Not Implemented
+  ExecutionHistoryDialog& operator=(const ExecutionHistoryDialog&) = delete; // Copy Assignment Not Implemented
+  ExecutionHistoryDialog& operator=(ExecutionHistoryDialog&&) = delete;      // Move Assignment Not Implemented
+};
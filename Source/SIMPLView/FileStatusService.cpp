@@ -0,0 +1,355 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FileStatusService.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTimer>
+
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsCache.h"
+
+namespace
+{
+const QString k_TimeoutKey("File Check Timeout");
+const int k_DefaultTimeout = 2000;
+
+// How long an answer is good for before it is checked again
+const qint64 k_MaxAge = 30000;
+
+// Every unreachable mount holds on to a thread until its check returns
+const int k_MaxThreads = 8;
+}
+
+FileStatusService* FileStatusService::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FileStatusService::FileStatusService(QObject* parent)
+: QObject(parent)
+, m_MountPoints(MountPoints())
+, m_TimeoutTimer(new QTimer(this))
+{
+  m_Pool.setMaxThreadCount(k_MaxThreads);
+  m_TimeoutTimer->setInterval(250);
+  connect(m_TimeoutTimer, &QTimer::timeout, this, &FileStatusService::checkTimeouts);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FileStatusService::~FileStatusService() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FileStatusService* FileStatusService::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new FileStatusService();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FileStatusService::Timeout()
+{
+  return SettingsCache::Instance()->value(SIMPLView::ApplicationSettings::GroupName, k_TimeoutKey, QVariant(k_DefaultTimeout)).toInt();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FileStatusService::Describe(Status status)
+{
+  switch(status)
+  {
+  case Status::Checking:
+    return tr("checking...");
+  case Status::Missing:
+    return tr("missing");
+  case Status::Unreachable:
+    return tr("unreachable");
+  default:
+    return QString();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FileStatusService::Info FileStatusService::Check(const QString& path)
+{
+  QFileInfo fi(path);
+  Info info;
+  info.status = fi.exists() ? Status::Exists : Status::Missing;
+  if(info.status == Status::Exists)
+  {
+    info.directory = fi.isDir();
+    info.size = fi.size();
+    info.lastModified = fi.lastModified().toMSecsSinceEpoch();
+  }
+  info.checkedAt = QDateTime::currentMSecsSinceEpoch();
+  return info;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList FileStatusService::MountPoints()
+{
+  QStringList mountPoints;
+#if defined(Q_OS_LINUX)
+  // The mount table is read without touching any of the mounts, unlike QStorageInfo
+  QFile file("/proc/self/mounts");
+  if(file.open(QIODevice::ReadOnly))
+  {
+    for(const QByteArray& line : file.readAll().split('\n'))
+    {
+      QList<QByteArray> fields = line.split(' ');
+      if(fields.size() > 1)
+      {
+        mountPoints.push_back(QString::fromLocal8Bit(fields[1]).replace("\\040", " "));
+      }
+    }
+  }
+#endif
+  std::sort(mountPoints.begin(), mountPoints.end(), [](const QString& a, const QString& b) { return a.size() > b.size(); });
+  return mountPoints;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FileStatusService::mountOf(const QString& path) const
+{
+  QString clean = QDir::cleanPath(QDir::fromNativeSeparators(path));
+
+  // A Windows share is //server/share
+  if(clean.startsWith("//"))
+  {
+    return "//" + clean.mid(2).section('/', 0, 1);
+  }
+  for(const QString& mountPoint : m_MountPoints)
+  {
+    if(clean == mountPoint || clean.startsWith(mountPoint.endsWith('/') ? mountPoint : mountPoint + "/"))
+    {
+      return mountPoint;
+    }
+  }
+#if defined(Q_OS_MAC)
+  if(clean.startsWith("/Volumes/"))
+  {
+    return "/Volumes/" + clean.section('/', 2, 2);
+  }
+#endif
+  // A drive letter, or the root
+  return clean.section('/', 0, 0) + "/";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FileStatusService::Info FileStatusService::info(const QString& path)
+{
+  QString mountPoint = mountOf(path);
+  const Mount& mount = m_Mounts[mountPoint];
+  bool queued = mount.current == path || mount.queue.contains(path);
+
+  if(m_Cache.contains(path))
+  {
+    Info cached = m_Cache[path];
+    bool fresh = (cached.status == Status::Unreachable) ? mount.unresponsive : (QDateTime::currentMSecsSinceEpoch() - cached.checkedAt < k_MaxAge);
+    if(fresh || cached.status == Status::Checking || queued)
+    {
+      return cached;
+    }
+  }
+
+  enqueue(path);
+  return m_Cache.value(path);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FileStatusService::refresh(const QString& path)
+{
+  QString mountPoint = mountOf(path);
+  const Mount& mount = m_Mounts[mountPoint];
+  if(mount.current != path && !mount.queue.contains(path))
+  {
+    m_Cache.remove(path);
+    enqueue(path);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FileStatusService::enqueue(const QString& path)
+{
+  QString mountPoint = mountOf(path);
+  Mount& mount = m_Mounts[mountPoint];
+  if(mount.unresponsive)
+  {
+    Info info;
+    info.status = Status::Unreachable;
+    info.checkedAt = QDateTime::currentMSecsSinceEpoch();
+    m_Cache.insert(path, info);
+    return;
+  }
+
+  if(!m_Cache.contains(path))
+  {
+    m_Cache.insert(path, Info());
+  }
+  mount.queue.push_back(path);
+  startNext(mountPoint);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FileStatusService::startNext(const QString& mountPoint)
+{
+  Mount& mount = m_Mounts[mountPoint];
+  if(nullptr == mount.watcher)
+  {
+    mount.watcher = new QFutureWatcher<Info>(this);
+    connect(mount.watcher, &QFutureWatcher<Info>::finished, this, [this, mountPoint] { checkFinished(mountPoint); });
+  }
+  if(mount.watcher->isRunning() || mount.queue.isEmpty() || mount.unresponsive)
+  {
+    return;
+  }
+
+  mount.current = mount.queue.takeFirst();
+  mount.started.start();
+  mount.watcher->setFuture(QtConcurrent::run(&m_Pool, &FileStatusService::Check, mount.current));
+  if(!m_TimeoutTimer->isActive())
+  {
+    m_TimeoutTimer->start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FileStatusService::checkFinished(const QString& mountPoint)
+{
+  Mount& mount = m_Mounts[mountPoint];
+  QString path = mount.current;
+  Info info = mount.watcher->result();
+  mount.current.clear();
+
+  // The hanging check has come back, so whatever was reported unreachable is checked again
+  if(mount.unresponsive)
+  {
+    mount.unresponsive = false;
+    for(auto iter = m_Cache.constBegin(); iter != m_Cache.constEnd(); ++iter)
+    {
+      if(iter.value().status == Status::Unreachable && mountOf(iter.key()) == mountPoint)
+      {
+        mount.queue.push_back(iter.key());
+      }
+    }
+  }
+  startNext(mountPoint);
+
+  // Last, since whoever receives the signal may ask about other paths
+  setInfo(path, info);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FileStatusService::checkTimeouts()
+{
+  int timeout = Timeout();
+  bool waiting = false;
+  QStringList unreachable;
+  for(auto iter = m_Mounts.begin(); iter != m_Mounts.end(); ++iter)
+  {
+    Mount& mount = iter.value();
+    if(nullptr == mount.watcher || !mount.watcher->isRunning() || mount.unresponsive)
+    {
+      continue;
+    }
+    if(mount.started.elapsed() < timeout)
+    {
+      waiting = true;
+      continue;
+    }
+
+    mount.unresponsive = true;
+    unreachable.push_back(mount.current);
+    unreachable.append(mount.queue);
+    mount.queue.clear();
+  }
+
+  if(!waiting)
+  {
+    m_TimeoutTimer->stop();
+  }
+
+  Info info;
+  info.status = Status::Unreachable;
+  info.checkedAt = QDateTime::currentMSecsSinceEpoch();
+  for(const QString& path : unreachable)
+  {
+    setInfo(path, info);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FileStatusService::setInfo(const QString& path, const Info& info)
+{
+  m_Cache.insert(path, info);
+  emit infoChanged(path, info);
+}
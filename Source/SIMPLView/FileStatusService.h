@@ -0,0 +1,166 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
+
+class QTimer;
+
+/**
+ * @brief The FileStatusService class finds out whether files exist without ever waiting for the file system on the
+ * GUI thread. info() answers from a cache and checks unknown or outdated paths on a worker thread; the infoChanged
+ * signal reports the answer.
+ *
+ * Checks are queued per mount, so that a slow network share only delays the paths on it. A mount whose check takes
+ * longer than Timeout() is considered unreachable: its paths are reported as such without being checked until the
+ * hanging check returns, after which they are checked again.
+ */
+class FileStatusService : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~FileStatusService() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static FileStatusService* Instance();
+
+  enum class Status : int
+  {
+    Checking,
+    Exists,
+    Missing,
+    Unreachable
+  };
+
+  /**
+   * @brief What is known about one path
+   */
+  struct Info
+  {
+    Status status = Status::Checking;
+    bool directory = false;
+    qint64 size = 0;
+    qint64 lastModified = 0; // Milliseconds since the epoch
+    qint64 checkedAt = 0;
+  };
+
+  /**
+   * @brief Returns how long a check may take in milliseconds before its mount is considered unreachable. The
+   * setting is shared by all windows.
+   * @return
+   */
+  static int Timeout();
+
+  /**
+   * @brief Returns the text that menus and views append to an entry, empty if the path exists
+   * @param status
+   * @return
+   */
+  static QString Describe(Status status);
+
+  /**
+   * @brief Returns what is known about a path and checks it in the background if that is nothing or outdated.
+   * A path that was known keeps its status while it is checked again. Never waits.
+   * @param path
+   * @return
+   */
+  Info info(const QString& path);
+
+  /**
+   * @brief Forgets what is known about a path and checks it again
+   * @param path
+   */
+  void refresh(const QString& path);
+
+signals:
+  /**
+   * @brief Emitted when a check has finished or a path has become unreachable
+   * @param path
+   * @param info
+   */
+  void infoChanged(const QString& path, const FileStatusService::Info& info);
+
+protected:
+  FileStatusService(QObject* parent = nullptr);
+
+protected slots:
+  void checkTimeouts();
+
+private:
+  static FileStatusService* self;
+
+  /**
+   * @brief The checks of the paths on one mount
+   */
+  struct Mount
+  {
+    QStringList queue;
+    QString current;
+    QElapsedTimer started;
+    bool unresponsive = false;
+    QFutureWatcher<Info>* watcher = nullptr;
+  };
+
+  QHash<QString, Info> m_Cache;
+  QHash<QString, Mount> m_Mounts;
+  QStringList m_MountPoints; // Longest first
+  QThreadPool m_Pool;
+  QTimer* m_TimeoutTimer = nullptr;
+
+  static Info Check(const QString& path);
+  static QStringList MountPoints();
+  QString mountOf(const QString& path) const;
+  void enqueue(const QString& path);
+  void startNext(const QString& mountPoint);
+  void checkFinished(const QString& mountPoint);
+  void setInfo(const QString& path, const Info& info);
+
+public:
+  FileStatusService(const FileStatusService&) = delete;            // Copy Constructor Not Implemented
+  FileStatusService(FileStatusService&&) = delete;                 // Move Constructor Not Implemented
+  FileStatusService& operator=(const FileStatusService&) = delete; // Copy Assignment Not Implemented
+  FileStatusService& operator=(FileStatusService&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,155 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FilterSearchDialog.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEvent>
+#include <QtGui/QKeyEvent>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QListWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/FilterSearchIndex.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchDialog::FilterSearchDialog(QWidget* parent)
+: QDialog(parent)
+, m_Query(new QLineEdit(this))
+, m_Results(new QListWidget(this))
+, m_Status(new QLabel(this))
+{
+  setWindowTitle(tr("Find Filter"));
+  resize(520, 420);
+
+  m_Query->setPlaceholderText(tr("Filter name, parameter or words from the documentation"));
+  m_Query->setClearButtonEnabled(true);
+  m_Query->installEventFilter(this);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(m_Query);
+  layout->addWidget(m_Results);
+  layout->addWidget(m_Status);
+
+  connect(m_Query, &QLineEdit::textChanged, this, &FilterSearchDialog::search);
+  connect(m_Query, &QLineEdit::returnPressed, this, &FilterSearchDialog::choose);
+  connect(m_Results, &QListWidget::itemActivated, this, &FilterSearchDialog::choose);
+  connect(FilterSearchIndex::Instance(), &FilterSearchIndex::ready, this, [this] { search(m_Query->text()); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchDialog::~FilterSearchDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchDialog::showEvent(QShowEvent* event)
+{
+  QDialog::showEvent(event);
+  m_Query->selectAll();
+  m_Query->setFocus();
+  search(m_Query->text());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterSearchDialog::eventFilter(QObject* watched, QEvent* event)
+{
+  // The query keeps the focus; moving through the results is done from there
+  if(watched == m_Query && event->type() == QEvent::KeyPress)
+  {
+    int key = static_cast<QKeyEvent*>(event)->key();
+    if(key == Qt::Key_Up || key == Qt::Key_Down || key == Qt::Key_PageUp || key == Qt::Key_PageDown)
+    {
+      QApplication::sendEvent(m_Results, event);
+      return true;
+    }
+  }
+  return QDialog::eventFilter(watched, event);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchDialog::search(const QString& query)
+{
+  m_Results->clear();
+  FilterSearchIndex* index = FilterSearchIndex::Instance();
+  if(!index->isReady())
+  {
+    m_Status->setText(tr("The search index is being built..."));
+    return;
+  }
+  if(query.trimmed().isEmpty())
+  {
+    m_Status->clear();
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  QVector<FilterSearchIndex::Match> matches = index->search(query);
+  double milliseconds = timer.nsecsElapsed() / 1000000.0;
+
+  for(const FilterSearchIndex::Match& match : matches)
+  {
+    QListWidgetItem* item = new QListWidgetItem(tr("%1    %2 / %3").arg(match.humanLabel).arg(match.groupName).arg(match.subGroupName), m_Results);
+    item->setData(Qt::UserRole, match.className);
+    item->setToolTip(tr("%1, matched in: %2").arg(match.className).arg(FilterSearchIndex::FieldName(match.field)));
+  }
+  m_Results->setCurrentRow(0);
+  m_Status->setText(tr("%1 filters in %2 ms").arg(matches.size()).arg(milliseconds, 0, 'f', 2));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchDialog::choose()
+{
+  QListWidgetItem* item = m_Results->currentItem();
+  if(nullptr == item)
+  {
+    return;
+  }
+  emit filterChosen(item->data(Qt::UserRole).toString());
+  accept();
+}
@@ -0,0 +1,427 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FilterSearchIndex.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
+
+#include "SIMPLib/FilterParameters/FilterParameter.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+
+#include "SIMPLView/HelpArchive.h"
+#include "SIMPLView/TraceRecorder.h"
+
+namespace
+{
+// A prefix only stands in for so many words, otherwise a single letter would visit the whole vocabulary
+const int k_MaxPrefixTerms = 200;
+
+// How alike two words must be, by the share of their trigrams that they have in common
+const double k_MinSimilarity = 0.4;
+}
+
+FilterSearchIndex* FilterSearchIndex::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex::FilterSearchIndex(QObject* parent)
+: QObject(parent)
+{
+  connect(&m_Watcher, &QFutureWatcher<Data>::finished, this, &FilterSearchIndex::buildFinished);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex::~FilterSearchIndex()
+{
+  m_Watcher.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex* FilterSearchIndex::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new FilterSearchIndex();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList FilterSearchIndex::Tokenize(const QString& text)
+{
+  QStringList tokens;
+  QString word;
+  QChar previous;
+  for(const QChar& c : text)
+  {
+    if(c.isLetterOrDigit())
+    {
+      if(!word.isEmpty() && c.isUpper() && previous.isLower())
+      {
+        tokens.push_back(word.toLower());
+        word.clear();
+      }
+      word += c;
+    }
+    else if(!word.isEmpty())
+    {
+      tokens.push_back(word.toLower());
+      word.clear();
+    }
+    previous = c;
+  }
+  if(!word.isEmpty())
+  {
+    tokens.push_back(word.toLower());
+  }
+  return tokens;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterSearchIndex::FieldName(Field field)
+{
+  switch(field)
+  {
+  case Field::Name:
+    return tr("Name");
+  case Field::ClassName:
+    return tr("Class Name");
+  case Field::Parameter:
+    return tr("Parameter");
+  case Field::Group:
+    return tr("Group");
+  default:
+    return tr("Documentation");
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double FilterSearchIndex::Weight(Field field)
+{
+  switch(field)
+  {
+  case Field::Name:
+    return 10.0;
+  case Field::ClassName:
+    return 6.0;
+  case Field::Parameter:
+    return 4.0;
+  case Field::Group:
+    return 3.0;
+  default:
+    return 1.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<quint64> FilterSearchIndex::Trigrams(const QString& term)
+{
+  QVector<quint64> trigrams;
+  QString padded = "^" + term + "$";
+  for(int i = 0; i + 2 < padded.size(); i++)
+  {
+    quint64 key = (static_cast<quint64>(padded[i].unicode()) << 32) | (static_cast<quint64>(padded[i + 1].unicode()) << 16) | padded[i + 2].unicode();
+    if(!trigrams.contains(key))
+    {
+      trigrams.push_back(key);
+    }
+  }
+  return trigrams;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterSearchIndex::DocumentationText(const HelpArchive& archive, const QString& className)
+{
+  // The archive has the text of every page ready; loose files are only read when there is no archive
+  if(archive.isOpen())
+  {
+    return archive.text(archive.pageName(className));
+  }
+
+  static const QString helpDirectory = HelpArchive::HelpDirectory();
+  for(const QString& suffix : {QString(".html"), QString(".md")})
+  {
+    QFile file(helpDirectory + "/" + className + suffix);
+    if(file.open(QIODevice::ReadOnly))
+    {
+      return HelpArchive::PageText(file.readAll());
+    }
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex::Data FilterSearchIndex::Build()
+{
+  SV_TRACE_SCOPE_CATEGORY("Build Filter Search Index", "startup");
+
+  QElapsedTimer timer;
+  timer.start();
+  Data data;
+
+  // The most important field a term appears in, by term and filter
+  QHash<QString, QHash<int, Field>> occurrences;
+  auto add = [&occurrences](const QString& text, int document, Field field) {
+    for(const QString& token : Tokenize(text))
+    {
+      if(token.size() < 2)
+      {
+        continue;
+      }
+      QHash<int, Field>& documents = occurrences[token];
+      if(!documents.contains(document) || static_cast<int>(field) < static_cast<int>(documents[document]))
+      {
+        documents[document] = field;
+      }
+    }
+  };
+
+  // Opened here rather than shared with the help server, so that the worker thread has an archive of its own
+  HelpArchive archive;
+  QString archivePath = HelpArchive::DefaultFilePath();
+  if(QFile::exists(archivePath))
+  {
+    archive.open(archivePath);
+  }
+
+  FilterManager::Collection factories = FilterManager::Instance()->getFactories();
+  for(IFilterFactory::Pointer factory : factories)
+  {
+    AbstractFilter::Pointer filter = factory->create();
+    if(nullptr == filter.get())
+    {
+      continue;
+    }
+
+    Document document;
+    document.className = filter->getNameOfClass();
+    document.humanLabel = filter->getHumanLabel();
+    document.groupName = filter->getGroupName();
+    document.subGroupName = filter->getSubGroupName();
+    int index = data.documents.size();
+    data.documents.push_back(document);
+
+    add(document.humanLabel, index, Field::Name);
+    add(document.className, index, Field::ClassName);
+    add(document.groupName + " " + document.subGroupName, index, Field::Group);
+    for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+    {
+      add(parameter->getHumanLabel(), index, Field::Parameter);
+    }
+    add(DocumentationText(archive, document.className), index, Field::Documentation);
+  }
+
+  data.terms = occurrences.keys();
+  std::sort(data.terms.begin(), data.terms.end());
+  data.postings.resize(data.terms.size());
+  data.trigramCounts.resize(data.terms.size());
+  for(int term = 0; term < data.terms.size(); term++)
+  {
+    const QHash<int, Field>& documents = occurrences[data.terms[term]];
+    for(auto iter = documents.constBegin(); iter != documents.constEnd(); ++iter)
+    {
+      Posting posting;
+      posting.document = iter.key();
+      posting.field = iter.value();
+      data.postings[term].push_back(posting);
+    }
+
+    QVector<quint64> trigrams = Trigrams(data.terms[term]);
+    data.trigramCounts[term] = trigrams.size();
+    for(quint64 trigram : trigrams)
+    {
+      data.trigrams[trigram].push_back(term);
+    }
+  }
+
+  data.milliseconds = timer.elapsed();
+  return data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchIndex::build()
+{
+  if(m_Watcher.isRunning())
+  {
+    m_BuildAgain = true;
+    return;
+  }
+  m_Watcher.setFuture(QtConcurrent::run(&FilterSearchIndex::Build));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchIndex::buildFinished()
+{
+  m_Data = m_Watcher.result();
+  m_Ready = true;
+  emit ready(m_Data.documents.size(), m_Data.terms.size(), m_Data.milliseconds);
+
+  // The filters changed while the index was built
+  if(m_BuildAgain)
+  {
+    m_BuildAgain = false;
+    build();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterSearchIndex::isReady() const
+{
+  return m_Ready;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<FilterSearchIndex::Match> FilterSearchIndex::search(const QString& query, int limit) const
+{
+  QStringList tokens = Tokenize(query);
+  QHash<int, double> scores;
+  QHash<int, int> matchedTokens;
+  QHash<int, QPair<double, Field>> bestFields;
+
+  for(const QString& token : tokens)
+  {
+    // The best match of this word in each filter
+    QHash<int, QPair<double, Field>> best;
+    auto visit = [this, &best](int term, double quality) {
+      for(const Posting& posting : m_Data.postings[term])
+      {
+        double score = Weight(posting.field) * quality;
+        if(!best.contains(posting.document) || best[posting.document].first < score)
+        {
+          best[posting.document] = qMakePair(score, posting.field);
+        }
+      }
+    };
+
+    QSet<int> visited;
+    auto first = std::lower_bound(m_Data.terms.begin(), m_Data.terms.end(), token);
+    for(auto iter = first; iter != m_Data.terms.end() && iter->startsWith(token) && visited.size() < k_MaxPrefixTerms; ++iter)
+    {
+      int term = static_cast<int>(iter - m_Data.terms.begin());
+      visited.insert(term);
+      visit(term, (*iter == token) ? 1.0 : 0.75);
+    }
+
+    // Typing mistakes: words that share most of their trigrams with the query word
+    if(token.size() >= 3)
+    {
+      QVector<quint64> trigrams = Trigrams(token);
+      QHash<int, int> shared;
+      for(quint64 trigram : trigrams)
+      {
+        for(int term : m_Data.trigrams.value(trigram))
+        {
+          shared[term]++;
+        }
+      }
+      for(auto iter = shared.constBegin(); iter != shared.constEnd(); ++iter)
+      {
+        double similarity = iter.value() / static_cast<double>(trigrams.size() + m_Data.trigramCounts[iter.key()] - iter.value());
+        if(similarity >= k_MinSimilarity && !visited.contains(iter.key()))
+        {
+          visit(iter.key(), 0.5 * similarity);
+        }
+      }
+    }
+
+    for(auto iter = best.constBegin(); iter != best.constEnd(); ++iter)
+    {
+      scores[iter.key()] += iter.value().first;
+      matchedTokens[iter.key()]++;
+      if(!bestFields.contains(iter.key()) || bestFields[iter.key()].first < iter.value().first)
+      {
+        bestFields[iter.key()] = iter.value();
+      }
+    }
+  }
+
+  // Only filters that match every word
+  QVector<Match> matches;
+  for(auto iter = scores.constBegin(); iter != scores.constEnd(); ++iter)
+  {
+    if(matchedTokens[iter.key()] < tokens.size())
+    {
+      continue;
+    }
+    const Document& document = m_Data.documents[iter.key()];
+    Match match;
+    match.className = document.className;
+    match.humanLabel = document.humanLabel;
+    match.groupName = document.groupName;
+    match.subGroupName = document.subGroupName;
+    match.score = iter.value();
+    match.field = bestFields[iter.key()].second;
+    matches.push_back(match);
+  }
+
+  std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) { return (a.score != b.score) ? a.score > b.score : a.humanLabel < b.humanLabel; });
+  if(matches.size() > limit)
+  {
+    matches.resize(limit);
+  }
+  return matches;
+}
@@ -0,0 +1,195 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+class HelpArchive;
+
+/**
+ * @brief The FilterSearchIndex class answers ranked searches over every filter that is loaded: its name, class
+ * name, group and subgroup, the labels of its parameters and the text of its documentation. The index is built on
+ * a worker thread once the plugins are loaded and is only read afterwards, so a search costs a few hash lookups
+ * instead of a pass over all filters.
+ *
+ * Every word of the query has to match a word of the filter, exactly, as a prefix or, for words of three letters
+ * or more, approximately through the trigrams they share. Matches in the name count most and matches in the
+ * documentation least.
+ */
+class FilterSearchIndex : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~FilterSearchIndex() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static FilterSearchIndex* Instance();
+
+  /**
+   * @brief Where a query word matched, in order of importance
+   */
+  enum class Field : int
+  {
+    Name,
+    ClassName,
+    Parameter,
+    Group,
+    Documentation
+  };
+
+  /**
+   * @brief One filter that matches a query
+   */
+  struct Match
+  {
+    QString className;
+    QString humanLabel;
+    QString groupName;
+    QString subGroupName;
+    double score = 0.0;
+    Field field = Field::Name; // Where the best match was
+  };
+
+  /**
+   * @brief Splits text into lower case words, also at the humps of camel case
+   * @param text
+   * @return
+   */
+  static QStringList Tokenize(const QString& text);
+
+  /**
+   * @brief Returns the name of a field for display
+   * @param field
+   * @return
+   */
+  static QString FieldName(Field field);
+
+  /**
+   * @brief Rebuilds the index from the filters the FilterManager knows in the background. The current index answers
+   * searches until the new one is ready.
+   */
+  void build();
+
+  /**
+   * @brief isReady
+   * @return
+   */
+  bool isReady() const;
+
+  /**
+   * @brief Returns the best matches for a query, best first
+   * @param query
+   * @param limit
+   * @return
+   */
+  QVector<Match> search(const QString& query, int limit = 50) const;
+
+signals:
+  /**
+   * @brief Emitted when a build has finished
+   * @param filters
+   * @param terms
+   * @param milliseconds
+   */
+  void ready(int filters, int terms, qint64 milliseconds);
+
+protected:
+  FilterSearchIndex(QObject* parent = nullptr);
+
+protected slots:
+  void buildFinished();
+
+private:
+  static FilterSearchIndex* self;
+
+  /**
+   * @brief One filter as the index knows it
+   */
+  struct Document
+  {
+    QString className;
+    QString humanLabel;
+    QString groupName;
+    QString subGroupName;
+  };
+
+  /**
+   * @brief One filter that contains a term and the most important field it contains it in
+   */
+  struct Posting
+  {
+    int document = -1;
+    Field field = Field::Name;
+  };
+
+  /**
+   * @brief Everything a search reads. Built on the worker thread and never changed afterwards.
+   */
+  struct Data
+  {
+    QVector<Document> documents;
+    QStringList terms;                  // Sorted, so that the terms with a prefix are adjacent
+    QVector<QVector<Posting>> postings; // By term
+    QVector<int> trigramCounts;         // By term
+    QHash<quint64, QVector<int>> trigrams;
+    qint64 milliseconds = 0;
+  };
+
+  Data m_Data;
+  QFutureWatcher<Data> m_Watcher;
+  bool m_Ready = false;
+  bool m_BuildAgain = false;
+
+  static Data Build();
+  static QString DocumentationText(const HelpArchive& archive, const QString& className);
+  static QVector<quint64> Trigrams(const QString& term);
+  static double Weight(Field field);
+
+public:
+  FilterSearchIndex(const FilterSearchIndex&) = delete;            // Copy Constructor Not Implemented
+  FilterSearchIndex(FilterSearchIndex&&) = delete;                 // Move Constructor Not Implemented
+  FilterSearchIndex& operator=(const FilterSearchIndex&) = delete; // Copy Assignment Not Implemented
+  FilterSearchIndex& operator=(FilterSearchIndex&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,283 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FilterTimingHistory.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+#include "SIMPLView/PipelineDataFlow.h"
+
+namespace
+{
+const QString k_FileName("FilterTimings.json");
+const int k_FileVersion = 1;
+
+// Filters that never ran before are predicted with the median of the others, or this if none ran before
+const double k_UnknownFilterSeconds = 1.0;
+}
+
+FilterTimingHistory* FilterTimingHistory::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingHistory::FilterTimingHistory()
+{
+  load();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingHistory::~FilterTimingHistory()
+{
+  save();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingHistory* FilterTimingHistory::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new FilterTimingHistory();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double FilterTimingHistory::Prediction::total() const
+{
+  double sum = 0.0;
+  for(double seconds : filterSeconds)
+  {
+    sum += seconds;
+  }
+  return sum;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterTimingHistory::FilePath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/" + k_FileName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 FilterTimingHistory::InputSize(FilterPipeline::Pointer pipeline)
+{
+  qint64 largest = 0;
+  PipelineDataFlow::VisitAttributeMatrices(PipelineDataFlow::PreflightedStructure(pipeline), [&largest](const DataArrayPath&, AttributeMatrix::Pointer am) {
+    largest = std::max(largest, static_cast<qint64>(am->getNumberOfTuples()));
+  });
+  return largest;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterTimingHistory::FormatDuration(double seconds)
+{
+  qint64 total = static_cast<qint64>(seconds + 0.5);
+  if(total >= 3600)
+  {
+    return QString("%1h %2m").arg(total / 3600).arg((total % 3600) / 60, 2, 10, QChar('0'));
+  }
+  if(total >= 60)
+  {
+    return QString("%1m %2s").arg(total / 60).arg(total % 60, 2, 10, QChar('0'));
+  }
+  return QString("%1s").arg(total);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingHistory::Prediction FilterTimingHistory::predict(FilterPipeline::Pointer pipeline) const
+{
+  Prediction prediction;
+  if(nullptr == pipeline.get())
+  {
+    return prediction;
+  }
+
+  prediction.tuples = InputSize(pipeline);
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  prediction.filterSeconds.fill(0.0, filters.size());
+
+  QVector<double> known;
+  QVector<int> unknown;
+  for(int i = 0; i < filters.size(); i++)
+  {
+    AbstractFilter::Pointer filter = filters[i];
+    if(nullptr == filter.get() || !filter->getEnabled())
+    {
+      continue;
+    }
+
+    QHash<QString, Entry>::const_iterator iter = m_Entries.constFind(filter->getNameOfClass());
+    if(iter == m_Entries.constEnd())
+    {
+      unknown.push_back(i);
+      continue;
+    }
+
+    const Entry& entry = iter.value();
+    double seconds = (prediction.tuples > 0 && entry.secondsPerTuple > 0.0) ? entry.secondsPerTuple * prediction.tuples : entry.seconds;
+    prediction.filterSeconds[i] = seconds;
+    known.push_back(seconds);
+  }
+
+  double fallback = k_UnknownFilterSeconds;
+  if(!known.isEmpty())
+  {
+    std::sort(known.begin(), known.end());
+    fallback = known[known.size() / 2];
+  }
+  for(int i : unknown)
+  {
+    prediction.filterSeconds[i] = fallback;
+  }
+  prediction.unknownFilters = unknown.size();
+
+  return prediction;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingHistory::record(const QString& className, double seconds, qint64 tuples)
+{
+  if(className.isEmpty() || seconds < 0.0)
+  {
+    return;
+  }
+
+  // A plain mean over the first runs, then an exponentially weighted average that follows changes
+  Entry& entry = m_Entries[className];
+  entry.runs++;
+  int window = MaxRunsAveraged;
+  double weight = 1.0 / std::min(entry.runs, window);
+  entry.seconds += weight * (seconds - entry.seconds);
+  if(tuples > 0)
+  {
+    double secondsPerTuple = seconds / tuples;
+    entry.secondsPerTuple = (entry.secondsPerTuple > 0.0) ? entry.secondsPerTuple + weight * (secondsPerTuple - entry.secondsPerTuple) : secondsPerTuple;
+  }
+  m_Modified = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingHistory::load()
+{
+  QFile file(FilePath());
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return;
+  }
+
+  QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+  if(root["version"].toInt() != k_FileVersion)
+  {
+    return;
+  }
+
+  QJsonObject filters = root["filters"].toObject();
+  for(QJsonObject::const_iterator iter = filters.constBegin(); iter != filters.constEnd(); ++iter)
+  {
+    QJsonObject object = iter.value().toObject();
+    Entry entry;
+    entry.secondsPerTuple = object["seconds_per_tuple"].toDouble();
+    entry.seconds = object["seconds"].toDouble();
+    entry.runs = object["runs"].toInt();
+    if(entry.runs > 0)
+    {
+      m_Entries.insert(iter.key(), entry);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingHistory::save()
+{
+  if(!m_Modified)
+  {
+    return;
+  }
+
+  QJsonObject filters;
+  for(QHash<QString, Entry>::const_iterator iter = m_Entries.constBegin(); iter != m_Entries.constEnd(); ++iter)
+  {
+    QJsonObject object;
+    object["seconds_per_tuple"] = iter.value().secondsPerTuple;
+    object["seconds"] = iter.value().seconds;
+    object["runs"] = iter.value().runs;
+    filters[iter.key()] = object;
+  }
+
+  QJsonObject root;
+  root["version"] = k_FileVersion;
+  root["filters"] = filters;
+
+  QDir().mkpath(QFileInfo(FilePath()).absolutePath());
+  QSaveFile file(FilePath());
+  if(!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(root).toJson()) < 0 || !file.commit())
+  {
+    qDebug() << "Could not write the filter timing history to" << FilePath() << ":" << file.errorString();
+    return;
+  }
+  m_Modified = false;
+}
@@ -0,0 +1,147 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The FilterTimingHistory class remembers how long each filter class took in earlier runs and predicts
+ * how long a pipeline will take before it executes. Runtimes are normalized by the size of the pipeline's
+ * input, the tuple count of its largest attribute matrix as known after the preflight, so that a history
+ * recorded on a small volume still predicts a large one. Each filter keeps an exponentially weighted average
+ * that starts as a plain mean, so the estimates settle within a few runs and then follow changes.
+ *
+ * The history is stored as Json in FilterTimings.json in the application data folder. It is only used from
+ * the GUI thread.
+ */
+class FilterTimingHistory
+{
+public:
+  ~FilterTimingHistory();
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static FilterTimingHistory* Instance();
+
+  /**
+   * @brief The predicted runtime of one pipeline
+   */
+  struct Prediction
+  {
+    qint64 tuples = 0;
+    QVector<double> filterSeconds; // Indexed like the filters of the pipeline; 0 for disabled filters
+    int unknownFilters = 0;        // Filters without a history, predicted from the others
+
+    bool isValid() const
+    {
+      return !filterSeconds.isEmpty();
+    }
+    double total() const;
+  };
+
+  /**
+   * @brief Returns the size that runtimes are normalized by: the tuple count of the largest attribute matrix
+   * of the preflighted pipeline
+   * @param pipeline
+   * @return
+   */
+  static qint64 InputSize(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Formats a duration in seconds as "1h 02m", "3m 07s" or "12s"
+   * @param seconds
+   * @return
+   */
+  static QString FormatDuration(double seconds);
+
+  /**
+   * @brief Predicts the runtime of each filter of a preflighted pipeline
+   * @param pipeline
+   * @return
+   */
+  Prediction predict(FilterPipeline::Pointer pipeline) const;
+
+  /**
+   * @brief Records how long one filter took
+   * @param className
+   * @param seconds
+   * @param tuples The input size of the run from InputSize()
+   */
+  void record(const QString& className, double seconds, qint64 tuples);
+
+  /**
+   * @brief Writes the history if it changed since it was last written
+   */
+  void save();
+
+  /**
+   * @brief Returns the path of the history file
+   * @return
+   */
+  static QString FilePath();
+
+  static const int MaxRunsAveraged = 4;
+
+protected:
+  FilterTimingHistory();
+
+private:
+  static FilterTimingHistory* self;
+
+  struct Entry
+  {
+    double secondsPerTuple = 0.0;
+    double seconds = 0.0;
+    int runs = 0;
+  };
+
+  QHash<QString, Entry> m_Entries;
+  bool m_Modified = false;
+
+  void load();
+
+public:
+  FilterTimingHistory(const FilterTimingHistory&) = delete;            // Copy Constructor Not Implemented
+  FilterTimingHistory(FilterTimingHistory&&) = delete;                 // Move Constructor Not Implemented
+  FilterTimingHistory& operator=(const FilterTimingHistory&) = delete; // Copy Assignment Not Implemented
+  FilterTimingHistory& operator=(FilterTimingHistory&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,453 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "HelpArchive.h"
+
+#include <cstring>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFileInfo>
+#include <QtCore/QObject>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSaveFile>
+#include <QtCore/QVector>
+#include <QtCore/QtEndian>
+
+namespace
+{
+const char k_Magic[4] = {'S', 'V', 'H', 'A'};
+const int k_HeaderSize = 12;
+
+// Name length, data offset and size, text offset and size
+const int k_EntrySize = 2 + 8 + 4 + 8 + 4;
+
+/**
+ * @brief Appends an integer in little endian order
+ */
+template <typename T> void AppendInteger(QByteArray& out, T value)
+{
+  char bytes[sizeof(T)];
+  qToLittleEndian<T>(value, reinterpret_cast<uchar*>(bytes));
+  out.append(bytes, sizeof(T));
+}
+
+/**
+ * @brief Returns true if a path names an HTML page
+ */
+bool IsPage(const QString& name)
+{
+  return name.endsWith(".html", Qt::CaseInsensitive) || name.endsWith(".htm", Qt::CaseInsensitive);
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+HelpArchive::HelpArchive() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+HelpArchive::~HelpArchive()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString HelpArchive::FileExtension()
+{
+  return QString("svhelp");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString HelpArchive::HelpDirectory()
+{
+  QDir dir(QCoreApplication::applicationDirPath());
+#if defined(Q_OS_MAC)
+  if(dir.dirName() == "MacOS")
+  {
+    dir.cdUp();
+    if(QFileInfo(dir.absolutePath() + "/Resources/Help").exists())
+    {
+      dir.cd("Resources");
+    }
+    else
+    {
+      dir.cdUp();
+      dir.cdUp();
+    }
+  }
+#endif
+  QString path = dir.absoluteFilePath("Help/" + QCoreApplication::applicationName());
+  if(!QFileInfo(path).isDir() && !QFileInfo(path + "." + FileExtension()).isFile())
+  {
+    // Running from the build tree
+    dir.cdUp();
+    path = dir.absoluteFilePath("Help/" + QCoreApplication::applicationName());
+  }
+  return path;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString HelpArchive::DefaultFilePath()
+{
+  return HelpDirectory() + "." + FileExtension();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString HelpArchive::PageText(const QByteArray& html)
+{
+  static const QRegularExpression blocks("<(script|style)[^>]*>.*?</\\1>", QRegularExpression::DotMatchesEverythingOption | QRegularExpression::CaseInsensitiveOption);
+  static const QRegularExpression tags("<[^>]*>|&[a-z]+;");
+  static const QRegularExpression spaces("\\s+");
+
+  QString text = QString::fromUtf8(html);
+  return text.remove(blocks).replace(tags, " ").replace(spaces, " ").trimmed();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int HelpArchive::Create(const QString& helpDirectory, const QString& filePath, QString* errorMessage, bool* changed)
+{
+  if(nullptr != changed)
+  {
+    *changed = false;
+  }
+
+  QDir root(helpDirectory);
+  if(!root.exists())
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = QObject::tr("The help directory %1 does not exist").arg(helpDirectory);
+    }
+    return -1;
+  }
+
+  QStringList names;
+  QDirIterator iter(root.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+  while(iter.hasNext())
+  {
+    names.push_back(root.relativeFilePath(iter.next()));
+  }
+  names.sort();
+
+  QVector<QByteArray> nameBytes;
+  QVector<QByteArray> blobs; // Data and text, alternating
+  for(const QString& name : names)
+  {
+    QFile file(root.absoluteFilePath(name));
+    if(!file.open(QIODevice::ReadOnly))
+    {
+      if(nullptr != errorMessage)
+      {
+        *errorMessage = QObject::tr("Could not read %1: %2").arg(file.fileName()).arg(file.errorString());
+      }
+      return -2;
+    }
+    QString entryName = name;
+    QByteArray data = file.readAll();
+
+    // Markdown without a rendered page next to it is still better shown than missing
+    if(name.endsWith(".md", Qt::CaseInsensitive))
+    {
+      entryName = name.left(name.size() - 3) + ".html";
+      if(names.contains(entryName))
+      {
+        continue;
+      }
+      QString title = QFileInfo(name).completeBaseName().toHtmlEscaped();
+      QString page = QString("<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>%1</title></head>\n<body><pre>%2</pre></body></html>\n").arg(title, QString::fromUtf8(data).toHtmlEscaped());
+      data = page.toUtf8();
+    }
+
+    QByteArray nameUtf8 = entryName.toUtf8();
+    if(nameUtf8.size() > 0xFFFF)
+    {
+      continue;
+    }
+    nameBytes.push_back(nameUtf8);
+    blobs.push_back(qCompress(data, 9));
+    blobs.push_back(IsPage(entryName) ? qCompress(PageText(data).toUtf8(), 9) : QByteArray());
+  }
+
+  quint64 offset = k_HeaderSize;
+  for(const QByteArray& name : nameBytes)
+  {
+    offset += k_EntrySize + name.size();
+  }
+
+  QByteArray index;
+  index.append(k_Magic, 4);
+  AppendInteger<quint16>(index, Version);
+  AppendInteger<quint16>(index, 0);
+  AppendInteger<quint32>(index, static_cast<quint32>(nameBytes.size()));
+  for(int i = 0; i < nameBytes.size(); i++)
+  {
+    const QByteArray& data = blobs[2 * i];
+    const QByteArray& text = blobs[2 * i + 1];
+    AppendInteger<quint16>(index, static_cast<quint16>(nameBytes[i].size()));
+    index.append(nameBytes[i]);
+    AppendInteger<quint64>(index, offset);
+    AppendInteger<quint32>(index, static_cast<quint32>(data.size()));
+    AppendInteger<quint64>(index, offset + data.size());
+    AppendInteger<quint32>(index, static_cast<quint32>(text.size()));
+    offset += data.size() + text.size();
+  }
+
+  // An archive that already holds exactly these bytes is left alone, so its time stamp only moves when a page did
+  QFile existing(filePath);
+  if(existing.size() == static_cast<qint64>(offset) && existing.open(QIODevice::ReadOnly))
+  {
+    bool same = (existing.read(index.size()) == index);
+    for(int i = 0; same && i < blobs.size(); i++)
+    {
+      same = (existing.read(blobs[i].size()) == blobs[i]);
+    }
+    existing.close();
+    if(same)
+    {
+      return nameBytes.size();
+    }
+  }
+
+  QSaveFile output(filePath);
+  if(!output.open(QIODevice::WriteOnly))
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = QObject::tr("Could not write %1: %2").arg(filePath).arg(output.errorString());
+    }
+    return -3;
+  }
+  output.write(index);
+  for(const QByteArray& blob : blobs)
+  {
+    output.write(blob);
+  }
+  if(!output.commit())
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = QObject::tr("Could not write %1: %2").arg(filePath).arg(output.errorString());
+    }
+    return -3;
+  }
+  if(nullptr != changed)
+  {
+    *changed = true;
+  }
+  return nameBytes.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HelpArchive::open(const QString& filePath, QString* errorMessage)
+{
+  close();
+
+  auto fail = [this, errorMessage](const QString& message) {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = message;
+    }
+    close();
+    return false;
+  };
+
+  m_File.setFileName(filePath);
+  if(!m_File.open(QIODevice::ReadOnly))
+  {
+    return fail(QObject::tr("Could not open %1: %2").arg(filePath).arg(m_File.errorString()));
+  }
+  m_Size = m_File.size();
+  m_Data = m_File.map(0, m_Size);
+  if(nullptr == m_Data || m_Size < k_HeaderSize || std::memcmp(m_Data, k_Magic, 4) != 0)
+  {
+    return fail(QObject::tr("%1 is not a help archive").arg(filePath));
+  }
+  quint16 version = qFromLittleEndian<quint16>(m_Data + 4);
+  if(version > Version)
+  {
+    return fail(QObject::tr("The help archive uses format version %1 but only versions up to %2 are supported").arg(version).arg(Version));
+  }
+
+  quint32 count = qFromLittleEndian<quint32>(m_Data + 8);
+  quint64 size = static_cast<quint64>(m_Size);
+  qint64 pos = k_HeaderSize;
+  m_Entries.reserve(static_cast<int>(qMin<quint64>(count, size / k_EntrySize)));
+  for(quint32 i = 0; i < count; i++)
+  {
+    if(m_Size - pos < 2)
+    {
+      return fail(QObject::tr("The index of %1 is truncated").arg(filePath));
+    }
+    quint16 nameSize = qFromLittleEndian<quint16>(m_Data + pos);
+    if(m_Size - pos < k_EntrySize + nameSize)
+    {
+      return fail(QObject::tr("The index of %1 is truncated").arg(filePath));
+    }
+    QString name = QString::fromUtf8(reinterpret_cast<const char*>(m_Data + pos + 2), nameSize);
+    pos += 2 + nameSize;
+
+    Entry entry;
+    entry.dataOffset = qFromLittleEndian<quint64>(m_Data + pos);
+    entry.dataSize = qFromLittleEndian<quint32>(m_Data + pos + 8);
+    entry.textOffset = qFromLittleEndian<quint64>(m_Data + pos + 12);
+    entry.textSize = qFromLittleEndian<quint32>(m_Data + pos + 20);
+    pos += k_EntrySize - 2;
+    if(entry.dataOffset > size || entry.dataSize > size - entry.dataOffset || entry.textOffset > size || entry.textSize > size - entry.textOffset)
+    {
+      return fail(QObject::tr("The entry %1 of %2 points outside of the file").arg(name).arg(filePath));
+    }
+    m_Entries.insert(name, entry);
+
+    // A filter's page is <className>.html, or <className>/index.html for generated sites; the shallowest wins
+    if(IsPage(name))
+    {
+      QString className = QFileInfo(name).completeBaseName();
+      if(className == "index")
+      {
+        className = name.section('/', -2, -2);
+      }
+      QString current = m_Pages.value(className);
+      if(!className.isEmpty() && (current.isEmpty() || current.count('/') > name.count('/')))
+      {
+        m_Pages.insert(className, name);
+      }
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void HelpArchive::close()
+{
+  m_Entries.clear();
+  m_Pages.clear();
+  if(nullptr != m_Data)
+  {
+    m_File.unmap(const_cast<uchar*>(m_Data));
+    m_Data = nullptr;
+  }
+  m_Size = 0;
+  m_File.close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HelpArchive::isOpen() const
+{
+  return nullptr != m_Data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList HelpArchive::entries() const
+{
+  QStringList names = m_Entries.keys();
+  names.sort();
+  return names;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HelpArchive::contains(const QString& name) const
+{
+  return m_Entries.contains(name);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString HelpArchive::pageName(const QString& className) const
+{
+  return m_Pages.value(className);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray HelpArchive::inflate(quint64 offset, quint32 size) const
+{
+  if(size == 0)
+  {
+    return QByteArray();
+  }
+  return qUncompress(m_Data + offset, static_cast<int>(size));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray HelpArchive::data(const QString& name) const
+{
+  QHash<QString, Entry>::const_iterator iter = m_Entries.constFind(name);
+  if(iter == m_Entries.constEnd())
+  {
+    return QByteArray();
+  }
+  return inflate(iter.value().dataOffset, iter.value().dataSize);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString HelpArchive::text(const QString& name) const
+{
+  QHash<QString, Entry>::const_iterator iter = m_Entries.constFind(name);
+  if(iter == m_Entries.constEnd())
+  {
+    return QString();
+  }
+  return QString::fromUtf8(inflate(iter.value().textOffset, iter.value().textSize));
+}
@@ -0,0 +1,180 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+/**
+ * @brief The HelpArchive class reads the filter documentation from a single file that is written once at build
+ * time, so that showing a help page does not mean finding, reading and rendering loose files. Every page is
+ * compressed on its own and found through an index at the front of the file, which is memory mapped; opening an
+ * archive only reads the index and a page is inflated when it is asked for. Next to each HTML page the archive
+ * keeps its plain text, which is what the filter search indexes.
+ *
+ * Layout (all integers little endian):
+ * @code
+ *   char[4]  magic "SVHA"
+ *   uint16   format version
+ *   uint16   flags (reserved, 0)
+ *   uint32   entry count
+ *   entries  per entry: uint16 name length, UTF-8 name, uint64 data offset, uint32 data size,
+ *            uint64 text offset, uint32 text size
+ *   blobs    the qCompress()ed data and text of every entry
+ * @endcode
+ * Names are paths relative to the help directory with '/' separators. Entries without text have a text size of 0.
+ *
+ * An open archive is only read, so a page can be asked for from several threads at once.
+ */
+class HelpArchive
+{
+public:
+  static const quint16 Version = 1;
+
+  HelpArchive();
+  ~HelpArchive();
+
+  /**
+   * @brief The suffix of help archive files
+   */
+  static QString FileExtension();
+
+  /**
+   * @brief Returns the directory the documentation build writes the help pages to
+   * @return
+   */
+  static QString HelpDirectory();
+
+  /**
+   * @brief Returns where the application looks for its help archive: next to the help directory
+   * @return
+   */
+  static QString DefaultFilePath();
+
+  /**
+   * @brief Returns the searchable text of an HTML page: the markup, scripts and style sheets removed
+   * @param html
+   * @return
+   */
+  static QString PageText(const QByteArray& html);
+
+  /**
+   * @brief Writes every file below a help directory into an archive. Markdown pages that have no HTML
+   * counterpart are stored as preformatted HTML pages. An existing archive with the same content is not rewritten.
+   * @param helpDirectory
+   * @param filePath
+   * @param errorMessage Receives a description of the problem if the archive could not be written
+   * @param changed Receives whether the archive file was written
+   * @return The number of entries in the archive, or a negative value on failure
+   */
+  static int Create(const QString& helpDirectory, const QString& filePath, QString* errorMessage = nullptr, bool* changed = nullptr);
+
+  /**
+   * @brief Maps an archive and reads its index
+   * @param filePath
+   * @param errorMessage
+   * @return True on success
+   */
+  bool open(const QString& filePath, QString* errorMessage = nullptr);
+
+  /**
+   * @brief isOpen
+   * @return
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Returns the names of all entries
+   * @return
+   */
+  QStringList entries() const;
+
+  /**
+   * @brief contains
+   * @param name
+   * @return
+   */
+  bool contains(const QString& name) const;
+
+  /**
+   * @brief Returns the entry that documents a filter, either <className>.html or <className>/index.html
+   * anywhere in the archive, or an empty string if there is none
+   * @param className
+   * @return
+   */
+  QString pageName(const QString& className) const;
+
+  /**
+   * @brief Returns the contents of an entry
+   * @param name
+   * @return
+   */
+  QByteArray data(const QString& name) const;
+
+  /**
+   * @brief Returns the searchable text of an entry
+   * @param name
+   * @return
+   */
+  QString text(const QString& name) const;
+
+private:
+  struct Entry
+  {
+    quint64 dataOffset = 0;
+    quint32 dataSize = 0;
+    quint64 textOffset = 0;
+    quint32 textSize = 0;
+  };
+
+  QFile m_File;
+  const uchar* m_Data = nullptr;
+  qint64 m_Size = 0;
+  QHash<QString, Entry> m_Entries;
+  QHash<QString, QString> m_Pages; // By class name
+
+  QByteArray inflate(quint64 offset, quint32 size) const;
+  void close();
+
+public:
+  HelpArchive(const HelpArchive&) = delete;            // Copy Constructor Not Implemented
+  HelpArchive(HelpArchive&&) = delete;                 // Move Constructor Not Implemented
+  HelpArchive& operator=(const HelpArchive&) = delete; // Copy Assignment Not Implemented
+  HelpArchive& operator=(HelpArchive&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,206 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "HelpServer.h"
+
+#include "SIMPLView/TraceRecorder.h"
+
+namespace
+{
+// Inflated pages kept in memory, in KiB
+const int k_PageCacheSize = 16 * 1024;
+}
+
+HelpServer* HelpServer::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+HelpServer::HelpServer(QObject* parent)
+: QObject(parent)
+{
+  m_Pages.setMaxCost(k_PageCacheSize);
+  m_Http = new LocalHttpServer([this](const QByteArray& path) { return page(path); }, this);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+HelpServer::~HelpServer() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+HelpServer* HelpServer::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new HelpServer();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const HelpArchive& HelpServer::archive()
+{
+  if(!m_Opened)
+  {
+    m_Opened = true;
+    QString filePath = HelpArchive::DefaultFilePath();
+    QString errorMessage;
+    if(QFile::exists(filePath) && !m_Archive.open(filePath, &errorMessage))
+    {
+      qWarning("The help archive could not be opened: %s", qPrintable(errorMessage));
+    }
+  }
+  return m_Archive;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HelpServer::isAvailable()
+{
+  return archive().isOpen();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUrl HelpServer::url(const QString& className)
+{
+  return pageUrl(archive().pageName(className));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUrl HelpServer::pageUrl(const QString& pageName)
+{
+  if(!archive().contains(pageName) || !listen())
+  {
+    return QUrl();
+  }
+
+  QUrl url;
+  url.setScheme("http");
+  url.setHost("127.0.0.1");
+  url.setPort(m_Http->serverPort());
+  url.setPath("/" + pageName);
+  return url;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool HelpServer::listen()
+{
+  if(m_Http->isListening())
+  {
+    return true;
+  }
+
+  SV_TRACE_SCOPE_CATEGORY("Start Help Server", "help");
+  QString errorMessage;
+  if(!m_Http->listen(0, &errorMessage))
+  {
+    qWarning("The help server could not start: %s", qPrintable(errorMessage));
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray HelpServer::ContentType(const QString& name)
+{
+  static const QHash<QString, QByteArray> types = {{"html", "text/html; charset=utf-8"},
+                                                   {"htm", "text/html; charset=utf-8"},
+                                                   {"css", "text/css; charset=utf-8"},
+                                                   {"js", "application/javascript; charset=utf-8"},
+                                                   {"json", "application/json"},
+                                                   {"svg", "image/svg+xml"},
+                                                   {"png", "image/png"},
+                                                   {"jpg", "image/jpeg"},
+                                                   {"jpeg", "image/jpeg"},
+                                                   {"gif", "image/gif"},
+                                                   {"ico", "image/x-icon"},
+                                                   {"woff", "font/woff"},
+                                                   {"woff2", "font/woff2"},
+                                                   {"ttf", "font/ttf"},
+                                                   {"txt", "text/plain; charset=utf-8"}};
+  return types.value(name.section('.', -1).toLower(), "application/octet-stream");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LocalHttpServer::Response HelpServer::page(const QByteArray& path)
+{
+  // Pages link to each other relative to their own location, so the path is the entry name
+  int end = path.indexOf('?');
+  if(end < 0)
+  {
+    end = path.indexOf('#');
+  }
+  QString name = QUrl::fromPercentEncoding(path.left(end < 0 ? path.size() : end));
+  while(name.startsWith('/'))
+  {
+    name.remove(0, 1);
+  }
+  if(name.isEmpty() || name.endsWith('/'))
+  {
+    name += "index.html";
+  }
+
+  QByteArray body;
+  if(QByteArray* cached = m_Pages.object(name))
+  {
+    body = *cached;
+  }
+  else if(m_Archive.contains(name))
+  {
+    body = m_Archive.data(name);
+    m_Pages.insert(name, new QByteArray(body), body.size() / 1024 + 1);
+  }
+  else
+  {
+    return LocalHttpServer::Reply("404 Not Found", "text/plain", "No such help page\n");
+  }
+  return LocalHttpServer::Reply("200 OK", ContentType(name), body);
+}
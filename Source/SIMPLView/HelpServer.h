@@ -0,0 +1,115 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QCache>
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+
+#include "SIMPLView/HelpArchive.h"
+
+#include "SIMPLView/LocalHttpServer.h"
+
+/**
+ * @brief The HelpServer class serves the pages of the help archive over HTTP on the loopback interface, straight
+ * from memory. Nothing happens until the first help page is asked for: that opens the archive, which only reads
+ * its index, and starts listening on a free port. Recently served pages are kept inflated, so going back and forth
+ * between pages does not decompress them again.
+ *
+ * When there is no archive, or it has no page for a filter, the help falls back to the documentation server.
+ */
+class HelpServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~HelpServer() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static HelpServer* Instance();
+
+  /**
+   * @brief Returns true if the help archive could be opened
+   * @return
+   */
+  bool isAvailable();
+
+  /**
+   * @brief Returns the address of a filter's help page, starting the server if it is not running yet. The
+   * address is empty if the archive has no page for the filter or the server could not start.
+   * @param className
+   * @return
+   */
+  QUrl url(const QString& className);
+
+  /**
+   * @brief Returns the address of an entry of the archive, starting the server if it is not running yet. The
+   * address is empty if there is no such entry or the server could not start.
+   * @param pageName
+   * @return
+   */
+  QUrl pageUrl(const QString& pageName);
+
+  /**
+   * @brief Returns the archive, opening it if that has not been tried yet
+   * @return
+   */
+  const HelpArchive& archive();
+
+protected:
+  HelpServer(QObject* parent = nullptr);
+
+private:
+  static HelpServer* self;
+
+  HelpArchive m_Archive;
+  bool m_Opened = false;
+  LocalHttpServer* m_Http = nullptr;
+  QCache<QString, QByteArray> m_Pages;
+
+  bool listen();
+  static QByteArray ContentType(const QString& name);
+  LocalHttpServer::Response page(const QByteArray& path);
+
+public:
+  HelpServer(const HelpServer&) = delete;            // Copy Constructor Not Implemented
+  HelpServer(HelpServer&&) = delete;                 // Move Constructor Not Implemented
+  HelpServer& operator=(const HelpServer&) = delete; // Copy Assignment Not Implemented
+  HelpServer& operator=(HelpServer&&) = delete;      // Move Assignment Not Implemented
+};
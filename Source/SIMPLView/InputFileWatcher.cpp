@@ -0,0 +1,344 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "InputFileWatcher.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSet>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
+#include "SIMPLib/Utilities/SIMPLDataPathValidator.h"
+
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsCache.h"
+
+namespace
+{
+const QString k_DebounceKey("Input Watch Debounce");
+const int k_DefaultDebounce = 1000;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFileWatcher::InputFileWatcher(QObject* parent)
+: QObject(parent)
+, m_Watcher(new QFileSystemWatcher(this))
+, m_Debounce(new QTimer(this))
+{
+  m_Debounce->setSingleShot(true);
+  connect(m_Watcher, &QFileSystemWatcher::fileChanged, this, &InputFileWatcher::fileChanged);
+  connect(m_Watcher, &QFileSystemWatcher::directoryChanged, this, &InputFileWatcher::directoryChanged);
+  connect(m_Debounce, &QTimer::timeout, this, &InputFileWatcher::debounceFinished);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFileWatcher::~InputFileWatcher() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<InputFileWatcher::Input> InputFileWatcher::Inputs(FilterPipeline::Pointer pipeline)
+{
+  QVector<Input> inputs;
+  if(nullptr == pipeline.get())
+  {
+    return inputs;
+  }
+
+  SIMPLDataPathValidator* validator = SIMPLDataPathValidator::Instance();
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  for(int i = 0; i < filters.size(); i++)
+  {
+    AbstractFilter::Pointer filter = filters[i];
+    if(!filter->getEnabled() || filter->getSubGroupName() != SIMPL::FilterSubGroups::InputFilters)
+    {
+      continue;
+    }
+
+    QSet<QString> paths;
+    for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+    {
+      QVariant value = filter->property(parameter->getPropertyName().toLatin1().constData());
+      QString path;
+      if(value.userType() == qMetaTypeId<FileListInfo_t>())
+      {
+        path = value.value<FileListInfo_t>().InputPath;
+      }
+      else if(value.userType() == QMetaType::QString)
+      {
+        path = value.toString();
+      }
+      if(path.isEmpty())
+      {
+        continue;
+      }
+
+      QFileInfo info(validator->convertToAbsolutePath(path));
+      if(!info.exists() || paths.contains(info.absoluteFilePath()))
+      {
+        continue;
+      }
+      paths.insert(info.absoluteFilePath());
+
+      Input input;
+      input.filterIndex = i;
+      input.propertyName = parameter->getPropertyName();
+      input.path = info.absoluteFilePath();
+      input.directory = info.isDir();
+      inputs.push_back(input);
+    }
+  }
+  return inputs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int InputFileWatcher::DebounceInterval()
+{
+  return SettingsCache::Instance()->value(SIMPLView::ApplicationSettings::GroupName, k_DebounceKey, QVariant(k_DefaultDebounce)).toInt();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int InputFileWatcher::watch(FilterPipeline::Pointer pipeline)
+{
+  // Every preflight hands the pipeline over again; as long as the readers and their inputs stay, so do the changes
+  QVector<Input> inputs = Inputs(pipeline);
+  bool same = m_Watching && inputs.size() == m_Inputs.size();
+  for(int i = 0; same && i < inputs.size(); i++)
+  {
+    same = inputs[i].filterIndex == m_Inputs[i].filterIndex && inputs[i].path == m_Inputs[i].path;
+  }
+  if(same)
+  {
+    return m_Inputs.size();
+  }
+
+  stop();
+  m_Inputs = inputs;
+  m_Watching = true;
+
+  // A file is also watched through its directory, because writers that replace a file by renaming a new one over
+  // it take the watch on the old file with them
+  QStringList paths;
+  for(const Input& input : m_Inputs)
+  {
+    paths.push_back(input.path);
+    if(!input.directory)
+    {
+      paths.push_back(QFileInfo(input.path).absolutePath());
+      m_Stamps.insert(input.path, Stamp(input.path));
+    }
+  }
+  paths.removeDuplicates();
+  if(!paths.isEmpty())
+  {
+    m_Watcher->addPaths(paths);
+  }
+  return m_Inputs.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputFileWatcher::stop()
+{
+  m_Debounce->stop();
+  QStringList paths = m_Watcher->files() + m_Watcher->directories();
+  if(!paths.isEmpty())
+  {
+    m_Watcher->removePaths(paths);
+  }
+  m_Inputs.clear();
+  m_Stamps.clear();
+  m_Collecting = Changes();
+  m_Settled = Changes();
+  m_Watching = false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool InputFileWatcher::isWatching() const
+{
+  return m_Watching;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool InputFileWatcher::hasChanges() const
+{
+  return !m_Settled.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFileWatcher::Changes InputFileWatcher::takeChanges()
+{
+  Changes changes = m_Settled;
+  m_Settled = Changes();
+  return changes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QPair<qint64, qint64> InputFileWatcher::Stamp(const QString& path)
+{
+  QFileInfo info(path);
+  if(!info.exists())
+  {
+    return qMakePair(qint64(-1), qint64(-1));
+  }
+  return qMakePair(info.lastModified().toMSecsSinceEpoch(), info.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputFileWatcher::addChange(const Input& input)
+{
+  qint64 now = QDateTime::currentMSecsSinceEpoch();
+  if(m_Collecting.isEmpty())
+  {
+    m_Collecting.firstChange = now;
+  }
+  m_Collecting.lastChange = now;
+  if(!m_Collecting.filterIndices.contains(input.filterIndex))
+  {
+    m_Collecting.filterIndices.push_back(input.filterIndex);
+  }
+  if(!m_Collecting.paths.contains(input.path))
+  {
+    m_Collecting.paths.push_back(input.path);
+  }
+  m_Debounce->start(DebounceInterval());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputFileWatcher::fileChanged(const QString& path)
+{
+  for(const Input& input : m_Inputs)
+  {
+    if(!input.directory && input.path == path)
+    {
+      m_Stamps.insert(input.path, Stamp(input.path));
+      addChange(input);
+    }
+  }
+  // A removed or replaced file is no longer watched; it comes back through its directory
+  if(QFileInfo::exists(path) && !m_Watcher->files().contains(path))
+  {
+    m_Watcher->addPath(path);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputFileWatcher::directoryChanged(const QString& path)
+{
+  for(const Input& input : m_Inputs)
+  {
+    if(input.directory)
+    {
+      if(input.path == path)
+      {
+        addChange(input);
+      }
+      continue;
+    }
+
+    // Other files in the directory of an input file do not matter
+    if(QFileInfo(input.path).absolutePath() != path)
+    {
+      continue;
+    }
+    QPair<qint64, qint64> stamp = Stamp(input.path);
+    if(stamp != m_Stamps.value(input.path))
+    {
+      m_Stamps.insert(input.path, stamp);
+      addChange(input);
+    }
+    if(stamp.first >= 0 && !m_Watcher->files().contains(input.path))
+    {
+      m_Watcher->addPath(input.path);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputFileWatcher::debounceFinished()
+{
+  // Changes that were not taken yet are merged, so the next run covers all of them
+  for(int index : m_Collecting.filterIndices)
+  {
+    if(!m_Settled.filterIndices.contains(index))
+    {
+      m_Settled.filterIndices.push_back(index);
+    }
+  }
+  for(const QString& path : m_Collecting.paths)
+  {
+    if(!m_Settled.paths.contains(path))
+    {
+      m_Settled.paths.push_back(path);
+    }
+  }
+  if(m_Settled.firstChange == 0)
+  {
+    m_Settled.firstChange = m_Collecting.firstChange;
+  }
+  m_Settled.lastChange = m_Collecting.lastChange;
+  m_Collecting = Changes();
+
+  if(!m_Settled.isEmpty())
+  {
+    emit changed();
+  }
+}
@@ -0,0 +1,164 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The InputFileWatcher class watches the files and directories that the reader filters of a pipeline
+ * read from and reports which readers have to run again. A reader's inputs are the values of its parameters
+ * that name an existing file or directory, and the directory of a file list such as an image stack.
+ *
+ * Changes are collected until none has arrived for the debounce interval, so that a file that is still being
+ * written or a directory that slices are dropped into one by one causes a single report. The collected changes
+ * wait in the watcher until takeChanges() is called, which lets the caller queue runs instead of overlapping them.
+ */
+class InputFileWatcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  InputFileWatcher(QObject* parent = nullptr);
+  ~InputFileWatcher() override;
+
+  /**
+   * @brief One input of a reader filter
+   */
+  struct Input
+  {
+    int filterIndex = -1;
+    QString propertyName;
+    QString path;
+    bool directory = false;
+  };
+
+  /**
+   * @brief What changed since the last call to takeChanges()
+   */
+  struct Changes
+  {
+    QVector<int> filterIndices;
+    QStringList paths;
+    qint64 firstChange = 0; // Milliseconds since the epoch
+    qint64 lastChange = 0;
+
+    bool isEmpty() const
+    {
+      return filterIndices.isEmpty();
+    }
+  };
+
+  /**
+   * @brief Returns the inputs of the enabled reader filters of a pipeline
+   * @param pipeline
+   * @return
+   */
+  static QVector<Input> Inputs(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Returns the debounce interval in milliseconds. The setting is shared by all windows.
+   * @return
+   */
+  static int DebounceInterval();
+
+  /**
+   * @brief Watches the inputs of a preflighted pipeline instead of the previous ones. If they are not the same,
+   * the changes that were not taken yet are dropped, since their filter indices may no longer be valid.
+   * @param pipeline
+   * @return The number of watched inputs
+   */
+  int watch(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Stops watching
+   */
+  void stop();
+
+  /**
+   * @brief isWatching
+   * @return
+   */
+  bool isWatching() const;
+
+  /**
+   * @brief Returns whether debounced changes are waiting to be taken
+   * @return
+   */
+  bool hasChanges() const;
+
+  /**
+   * @brief Returns the debounced changes and forgets them
+   * @return
+   */
+  Changes takeChanges();
+
+signals:
+  /**
+   * @brief Emitted when changes have settled for the debounce interval
+   */
+  void changed();
+
+protected slots:
+  void fileChanged(const QString& path);
+  void directoryChanged(const QString& path);
+  void debounceFinished();
+
+private:
+  QFileSystemWatcher* m_Watcher = nullptr;
+  QTimer* m_Debounce = nullptr;
+  bool m_Watching = false;
+  QVector<Input> m_Inputs;
+  QHash<QString, QPair<qint64, qint64>> m_Stamps; // Modification time and size of each watched file
+  Changes m_Collecting;
+  Changes m_Settled;
+
+  static QPair<qint64, qint64> Stamp(const QString& path);
+  void addChange(const Input& input);
+
+public:
+  InputFileWatcher(const InputFileWatcher&) = delete;            // Copy Constructor Not Implemented
+  InputFileWatcher(InputFileWatcher&&) = delete;                 // Move Constructor Not Implemented
+  InputFileWatcher& operator=(const InputFileWatcher&) = delete; // Copy Assignment Not Implemented
+  InputFileWatcher& operator=(InputFileWatcher&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,323 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "InputPrefetcher.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSet>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "SIMPLView/InputFileWatcher.h"
+#include "SIMPLView/PipelineMemoryGovernor.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsCache.h"
+#include "SIMPLView/TraceRecorder.h"
+
+namespace
+{
+const QString k_BudgetKey("Input Prefetch Budget");
+
+// The default budget is a small part of the machine, since the pipeline needs the rest
+const qint64 k_DefaultBudgetDivisor = 8;
+
+// Large enough to keep networked storage busy, small enough to cancel quickly
+const qint64 k_ChunkSize = 4 * 1024 * 1024;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputPrefetcher::InputPrefetcher(QObject* parent)
+: QObject(parent)
+, m_Cancel(false)
+{
+  connect(&m_Watcher, &QFutureWatcher<Summary>::finished, this, &InputPrefetcher::prefetchFinished);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputPrefetcher::~InputPrefetcher()
+{
+  m_Cancel = true;
+  m_Watcher.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList InputPrefetcher::Files(FilterPipeline::Pointer pipeline)
+{
+  QStringList files;
+  QSet<QString> seen;
+  for(const InputFileWatcher::Input& input : InputFileWatcher::Inputs(pipeline))
+  {
+    QStringList paths(input.path);
+    if(input.directory)
+    {
+      paths.clear();
+      for(const QFileInfo& info : QDir(input.path).entryInfoList(QDir::Files, QDir::Name))
+      {
+        paths.push_back(info.absoluteFilePath());
+      }
+    }
+    for(const QString& path : paths)
+    {
+      if(!seen.contains(path))
+      {
+        seen.insert(path);
+        files.push_back(path);
+      }
+    }
+  }
+  return files;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 InputPrefetcher::Budget()
+{
+  qint64 defaultBudget = PipelineMemoryGovernor::PhysicalMemory() / k_DefaultBudgetDivisor;
+  return SettingsCache::Instance()->value(SIMPLView::ApplicationSettings::GroupName, k_BudgetKey, QVariant(defaultBudget)).toLongLong();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::SetBudget(qint64 bytes)
+{
+  SettingsCache::Instance()->setValue(SIMPLView::ApplicationSettings::GroupName, k_BudgetKey, QVariant(bytes));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QPair<qint64, qint64> InputPrefetcher::Stamp(const QString& path)
+{
+  QFileInfo info(path);
+  return qMakePair(info.lastModified().toMSecsSinceEpoch(), info.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 InputPrefetcher::prefetch(const QStringList& files)
+{
+  if(m_Watcher.isRunning())
+  {
+    if(files != m_Files)
+    {
+      m_Pending = files;
+      m_HasPending = true;
+      m_Cancel = true;
+    }
+    return 0;
+  }
+
+  // What the pipelines were admitted with is theirs; the cache only gets what is left
+  qint64 budget = Budget();
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+  if(governor->getBudget() > 0)
+  {
+    budget = qMin(budget, qMax(qint64(0), governor->getBudget() - governor->getCommittedMemory()));
+  }
+
+  QVector<Item> items;
+  qint64 total = 0;
+  for(const QString& path : files)
+  {
+    QFileInfo info(path);
+    if(total >= budget)
+    {
+      break;
+    }
+    if(!info.isFile() || info.size() == 0)
+    {
+      continue;
+    }
+
+    Item item;
+    item.path = info.absoluteFilePath();
+    item.stamp = Stamp(item.path);
+    if(m_Prefetched.contains(item.path) && m_Prefetched[item.path] == item.stamp)
+    {
+      continue;
+    }
+    item.length = qMin(info.size(), budget - total);
+    total += item.length;
+    items.push_back(item);
+  }
+  if(items.isEmpty())
+  {
+    return 0;
+  }
+
+  m_Files = files;
+  m_Cancel = false;
+  m_Watcher.setFuture(QtConcurrent::run([this, items, total] { return run(items, total); }));
+  return total;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool InputPrefetcher::isRunning() const
+{
+  return m_Watcher.isRunning();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::cancel()
+{
+  m_HasPending = false;
+  m_Pending.clear();
+  m_Cancel = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputPrefetcher::Summary InputPrefetcher::run(const QVector<Item>& items, qint64 total)
+{
+  SV_TRACE_SCOPE_CATEGORY("Prefetch Inputs", "io");
+
+  Summary summary;
+  QElapsedTimer timer;
+  timer.start();
+  emit progress(0, total);
+
+  for(const Item& item : items)
+  {
+    if(m_Cancel)
+    {
+      break;
+    }
+    if(prefetchFile(item, summary.bytes, total) && item.length == item.stamp.second)
+    {
+      summary.completed.push_back(item);
+    }
+  }
+
+  summary.canceled = m_Cancel;
+  summary.milliseconds = timer.elapsed();
+  return summary;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool InputPrefetcher::prefetchFile(const Item& item, qint64& done, qint64 total)
+{
+#if defined(Q_OS_LINUX)
+  int fd = ::open(QFile::encodeName(item.path).constData(), O_RDONLY);
+  if(fd < 0)
+  {
+    return false;
+  }
+  // The hint lets the kernel queue the whole range at once; readahead() then waits chunk by chunk for progress
+  ::posix_fadvise(fd, 0, item.length, POSIX_FADV_WILLNEED);
+#else
+  QFile file(item.path);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  QByteArray buffer(static_cast<int>(k_ChunkSize), 0);
+#endif
+
+  qint64 offset = 0;
+  while(offset < item.length && !m_Cancel)
+  {
+    qint64 length = qMin(k_ChunkSize, item.length - offset);
+#if defined(Q_OS_LINUX)
+    if(::readahead(fd, offset, static_cast<size_t>(length)) != 0)
+    {
+      break;
+    }
+#else
+    if(file.read(buffer.data(), length) <= 0)
+    {
+      break;
+    }
+#endif
+    offset += length;
+
+    // About one signal per percent
+    qint64 before = done * 100 / total;
+    done += length;
+    if(done * 100 / total != before)
+    {
+      emit progress(done, total);
+    }
+  }
+
+#if defined(Q_OS_LINUX)
+  ::close(fd);
+#endif
+  return offset >= item.length;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::prefetchFinished()
+{
+  Summary summary = m_Watcher.result();
+  for(const Item& item : summary.completed)
+  {
+    m_Prefetched.insert(item.path, item.stamp);
+  }
+  emit finished(summary.bytes, summary.milliseconds, summary.canceled);
+
+  if(m_HasPending)
+  {
+    m_HasPending = false;
+    prefetch(m_Pending);
+    m_Pending.clear();
+  }
+}
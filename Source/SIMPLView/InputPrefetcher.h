@@ -0,0 +1,158 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The InputPrefetcher class reads the input files of a pipeline into the operating system's page cache on
+ * a worker thread, so that the readers find them there instead of waiting for slow or networked storage. On Linux
+ * the kernel is asked to read ahead without copying anything; elsewhere the files are read and the data dropped.
+ *
+ * At most Budget() bytes are prefetched per request, and never more than the memory governor has left, so the
+ * cache is not filled with data that pushes out the pipeline's own. Files are prefetched in order and the last one
+ * may be cut short; readers usually start at the beginning of a file. A file that was prefetched completely and has
+ * not changed since is skipped the next time.
+ */
+class InputPrefetcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  InputPrefetcher(QObject* parent = nullptr);
+  ~InputPrefetcher() override;
+
+  /**
+   * @brief Returns the files that the enabled reader filters of a pipeline read, with the files of an input
+   * directory in name order
+   * @param pipeline
+   * @return
+   */
+  static QStringList Files(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Returns the most bytes one request prefetches. Zero turns prefetching off. The setting is shared by
+   * all windows.
+   * @return
+   */
+  static qint64 Budget();
+
+  /**
+   * @brief Sets the budget
+   * @param bytes
+   */
+  static void SetBudget(qint64 bytes);
+
+  /**
+   * @brief Starts prefetching files in the background. A running prefetch of other files is canceled and this
+   * one starts when it has stopped.
+   * @param files
+   * @return The number of bytes that will be prefetched, zero if nothing is new or the request waits
+   */
+  qint64 prefetch(const QStringList& files);
+
+  /**
+   * @brief isRunning
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief Stops prefetching after the current chunk and drops a waiting request
+   */
+  void cancel();
+
+signals:
+  /**
+   * @brief Emitted from the worker thread a few times per second
+   * @param done
+   * @param total
+   */
+  void progress(qint64 done, qint64 total);
+
+  void finished(qint64 bytes, qint64 milliseconds, bool canceled);
+
+protected slots:
+  void prefetchFinished();
+
+private:
+  /**
+   * @brief One file and how much of it to prefetch
+   */
+  struct Item
+  {
+    QString path;
+    qint64 length = 0;
+    QPair<qint64, qint64> stamp;
+  };
+
+  /**
+   * @brief The outcome of one request
+   */
+  struct Summary
+  {
+    qint64 bytes = 0;
+    qint64 milliseconds = 0;
+    bool canceled = false;
+    QVector<Item> completed;
+  };
+
+  QFutureWatcher<Summary> m_Watcher;
+  std::atomic<bool> m_Cancel;
+  QStringList m_Files;
+  QStringList m_Pending;
+  bool m_HasPending = false;
+  QHash<QString, QPair<qint64, qint64>> m_Prefetched; // Modification time and size of each file in the cache
+
+  static QPair<qint64, qint64> Stamp(const QString& path);
+  Summary run(const QVector<Item>& items, qint64 total);
+  bool prefetchFile(const Item& item, qint64& done, qint64 total);
+
+public:
+  InputPrefetcher(const InputPrefetcher&) = delete;            // Copy Constructor Not Implemented
+  InputPrefetcher(InputPrefetcher&&) = delete;                 // Move Constructor Not Implemented
+  InputPrefetcher& operator=(const InputPrefetcher&) = delete; // Copy Assignment Not Implemented
+  InputPrefetcher& operator=(InputPrefetcher&&) = delete;      // Move Assignment Not Implemented
+};
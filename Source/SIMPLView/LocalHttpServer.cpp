@@ -0,0 +1,196 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "LocalHttpServer.h"
+
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+namespace
+{
+// Requests larger than this are not GET requests of a client that the servers know
+const int k_MaxRequestSize = 16 * 1024;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LocalHttpServer::LocalHttpServer(const Handler& handler, QObject* parent)
+: QObject(parent)
+, m_Handler(handler)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LocalHttpServer::~LocalHttpServer() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LocalHttpServer::listen(quint16 port, QString* errorMessage)
+{
+  if(isListening())
+  {
+    return true;
+  }
+
+  m_Server = new QTcpServer(this);
+  connect(m_Server, &QTcpServer::newConnection, this, &LocalHttpServer::acceptConnection);
+  if(!m_Server->listen(QHostAddress::LocalHost, port))
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = m_Server->errorString();
+    }
+    delete m_Server;
+    m_Server = nullptr;
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LocalHttpServer::close()
+{
+  if(nullptr == m_Server)
+  {
+    return;
+  }
+  m_Server->close();
+  m_Server->deleteLater();
+  m_Server = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LocalHttpServer::isListening() const
+{
+  return nullptr != m_Server;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+quint16 LocalHttpServer::serverPort() const
+{
+  return (nullptr != m_Server) ? m_Server->serverPort() : 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+LocalHttpServer::Response LocalHttpServer::Reply(const QByteArray& status, const QByteArray& contentType, const QByteArray& body)
+{
+  Response response;
+  response.status = status;
+  response.contentType = contentType;
+  response.body = body;
+  return response;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LocalHttpServer::acceptConnection()
+{
+  QTcpServer* server = qobject_cast<QTcpServer*>(sender());
+  if(nullptr == server)
+  {
+    return;
+  }
+  while(server->hasPendingConnections())
+  {
+    QTcpSocket* socket = server->nextPendingConnection();
+    connect(socket, &QTcpSocket::readyRead, this, &LocalHttpServer::readRequest);
+    connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LocalHttpServer::readRequest()
+{
+  QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+  if(nullptr == socket)
+  {
+    return;
+  }
+
+  // The request is complete once the blank line after the headers has arrived; the body is never needed
+  QByteArray request = socket->peek(k_MaxRequestSize);
+  if(!request.contains("\r\n\r\n") && !request.contains("\n\n"))
+  {
+    if(request.size() >= k_MaxRequestSize)
+    {
+      respond(socket, Reply("413 Payload Too Large", "text/plain", "Request too large\n"));
+    }
+    return;
+  }
+
+  QList<QByteArray> requestLine = request.left(request.indexOf('\n')).trimmed().split(' ');
+  QByteArray method = requestLine.value(0);
+  QByteArray path = requestLine.value(1);
+  if(method != "GET")
+  {
+    respond(socket, Reply("405 Method Not Allowed", "text/plain", "Only GET is supported\n"));
+    return;
+  }
+  respond(socket, m_Handler(path));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LocalHttpServer::respond(QTcpSocket* socket, const Response& response)
+{
+  socket->readAll();
+  socket->disconnect(this);
+
+  QByteArray out = "HTTP/1.1 " + response.status + "\r\n";
+  out += "Content-Type: " + response.contentType + "\r\n";
+  out += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+  out += "Connection: close\r\n\r\n";
+  out += response.body;
+
+  socket->write(out);
+  socket->disconnectFromHost();
+}
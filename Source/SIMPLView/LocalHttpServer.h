@@ -0,0 +1,125 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief The LocalHttpServer class is the HTTP plumbing that the application's small servers share. It listens on
+ * the loopback interface, reads one GET request per connection and writes the response that its handler returns,
+ * then closes the connection. Only the request line is looked at; headers and bodies are ignored.
+ */
+class LocalHttpServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief What the handler answers a request with
+   */
+  struct Response
+  {
+    QByteArray status = "200 OK";
+    QByteArray contentType = "text/plain";
+    QByteArray body;
+  };
+
+  /**
+   * @brief Returns the response to a GET request for a path. The path is the request target as it was sent,
+   * including any query.
+   */
+  using Handler = std::function<Response(const QByteArray& path)>;
+
+  LocalHttpServer(const Handler& handler, QObject* parent = nullptr);
+  ~LocalHttpServer() override;
+
+  /**
+   * @brief Starts listening on the loopback interface
+   * @param port 0 picks a free port
+   * @param errorMessage Receives the reason if the server could not start
+   * @return True on success
+   */
+  bool listen(quint16 port, QString* errorMessage = nullptr);
+
+  /**
+   * @brief Stops listening
+   */
+  void close();
+
+  /**
+   * @brief isListening
+   * @return
+   */
+  bool isListening() const;
+
+  /**
+   * @brief Returns the port the server listens on
+   * @return
+   */
+  quint16 serverPort() const;
+
+  /**
+   * @brief Builds a response
+   * @param status
+   * @param contentType
+   * @param body
+   * @return
+   */
+  static Response Reply(const QByteArray& status, const QByteArray& contentType, const QByteArray& body);
+
+protected slots:
+  void acceptConnection();
+  void readRequest();
+
+private:
+  Handler m_Handler;
+  QTcpServer* m_Server = nullptr;
+
+  void respond(QTcpSocket* socket, const Response& response);
+
+public:
+  LocalHttpServer(const LocalHttpServer&) = delete;            // Copy Constructor Not Implemented
+  LocalHttpServer(LocalHttpServer&&) = delete;                 // Move Constructor Not Implemented
+  LocalHttpServer& operator=(const LocalHttpServer&) = delete; // Copy Assignment Not Implemented
+  LocalHttpServer& operator=(LocalHttpServer&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,305 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MetricsServer.h"
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLView/LocalHttpServer.h"
+#include "SIMPLView/PipelineMemoryGovernor.h"
+#include "SIMPLView/ResourceSampler.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsCache.h"
+
+namespace
+{
+const QString k_EnabledKey("Metrics Server Enabled");
+const QString k_PortKey("Metrics Server Port");
+
+// Filters range from milliseconds to hours
+const QVector<double> k_FilterBounds = {0.01, 0.1, 0.5, 1.0, 5.0, 10.0, 30.0, 60.0, 300.0, 900.0, 3600.0};
+
+// Preflights should stay well below a second
+const QVector<double> k_PreflightBounds = {0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0};
+
+/**
+ * @brief Escapes a label value as the text format requires
+ */
+QByteArray EscapeLabel(const QString& value)
+{
+  QByteArray escaped = value.toUtf8();
+  escaped.replace('\\', "\\\\");
+  escaped.replace('"', "\\\"");
+  escaped.replace('\n', "\\n");
+  return escaped;
+}
+}
+
+MetricsServer* MetricsServer::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MetricsServer::MetricsServer(QObject* parent)
+: QObject(parent)
+, m_StartTime(QDateTime::currentDateTime())
+{
+  m_Port = static_cast<quint16>(SettingsCache::Instance()->value(SIMPLView::ApplicationSettings::GroupName, k_PortKey, QVariant(DefaultPort)).toUInt());
+  m_PreflightDurations.counts.resize(k_PreflightBounds.size());
+
+  m_Http = new LocalHttpServer([this](const QByteArray& path) {
+    if(path == "/metrics" || path.startsWith("/metrics?"))
+    {
+      return LocalHttpServer::Reply("200 OK", "text/plain; version=0.0.4; charset=utf-8", metrics());
+    }
+    return LocalHttpServer::Reply("404 Not Found", "text/plain", "Metrics are served at /metrics\n");
+  }, this);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MetricsServer::~MetricsServer() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MetricsServer* MetricsServer::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new MetricsServer();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MetricsServer::restore()
+{
+  if(SettingsCache::Instance()->value(SIMPLView::ApplicationSettings::GroupName, k_EnabledKey, QVariant(false)).toBool())
+  {
+    QString errorMessage;
+    if(!setEnabled(true, &errorMessage))
+    {
+      qWarning("The metrics server could not start: %s", qPrintable(errorMessage));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MetricsServer::setEnabled(bool enabled, QString* errorMessage)
+{
+  if(enabled == isEnabled())
+  {
+    return true;
+  }
+
+  if(enabled)
+  {
+    QString error;
+    if(!m_Http->listen(m_Port, &error))
+    {
+      if(nullptr != errorMessage)
+      {
+        *errorMessage = tr("Port %1: %2").arg(m_Port).arg(error);
+      }
+      return false;
+    }
+  }
+  else
+  {
+    m_Http->close();
+  }
+
+  SettingsCache::Instance()->setValue(SIMPLView::ApplicationSettings::GroupName, k_EnabledKey, QVariant(enabled));
+  emit enabledChanged(enabled);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MetricsServer::isEnabled() const
+{
+  return m_Http->isListening();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+quint16 MetricsServer::getPort() const
+{
+  return m_Port;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MetricsServer::pipelineFinished(bool canceled)
+{
+  if(canceled)
+  {
+    m_PipelinesCanceled++;
+  }
+  else
+  {
+    m_PipelinesFinished++;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MetricsServer::observeFilter(const QString& className, double seconds)
+{
+  Histogram& histogram = m_FilterDurations[className];
+  if(histogram.counts.isEmpty())
+  {
+    histogram.counts.resize(k_FilterBounds.size());
+  }
+  Observe(histogram, k_FilterBounds, seconds);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MetricsServer::observePreflight(double seconds)
+{
+  Observe(m_PreflightDurations, k_PreflightBounds, seconds);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MetricsServer::setPluginLoadTime(double seconds, int pluginCount)
+{
+  m_PluginLoadSeconds = seconds;
+  m_PluginCount = pluginCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MetricsServer::Observe(Histogram& histogram, const QVector<double>& bounds, double value)
+{
+  for(int i = 0; i < bounds.size(); i++)
+  {
+    if(value <= bounds[i])
+    {
+      histogram.counts[i]++;
+    }
+  }
+  histogram.count++;
+  histogram.sum += value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MetricsServer::AppendHistogram(QByteArray& out, const QByteArray& name, const QByteArray& labels, const Histogram& histogram, const QVector<double>& bounds)
+{
+  QByteArray prefix = labels.isEmpty() ? QByteArray() : labels + ",";
+  for(int i = 0; i < bounds.size(); i++)
+  {
+    out += name + "_bucket{" + prefix + "le=\"" + QByteArray::number(bounds[i], 'g', 6) + "\"} " + QByteArray::number(histogram.counts[i]) + "\n";
+  }
+  out += name + "_bucket{" + prefix + "le=\"+Inf\"} " + QByteArray::number(histogram.count) + "\n";
+
+  QByteArray braces = labels.isEmpty() ? QByteArray() : "{" + labels + "}";
+  out += name + "_sum" + braces + " " + QByteArray::number(histogram.sum, 'g', 10) + "\n";
+  out += name + "_count" + braces + " " + QByteArray::number(histogram.count) + "\n";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray MetricsServer::metrics() const
+{
+  QByteArray out;
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+
+  out += "# HELP simplview_pipelines_executed_total Pipelines that ran to the end or were canceled.\n";
+  out += "# TYPE simplview_pipelines_executed_total counter\n";
+  out += "simplview_pipelines_executed_total{status=\"finished\"} " + QByteArray::number(m_PipelinesFinished) + "\n";
+  out += "simplview_pipelines_executed_total{status=\"canceled\"} " + QByteArray::number(m_PipelinesCanceled) + "\n";
+
+  out += "# HELP simplview_pipelines_running Pipelines that are executing.\n";
+  out += "# TYPE simplview_pipelines_running gauge\n";
+  out += "simplview_pipelines_running " + QByteArray::number(governor->getRunningPipelines().size()) + "\n";
+
+  out += "# HELP simplview_pipeline_queue_depth Pipelines waiting for memory before they can execute.\n";
+  out += "# TYPE simplview_pipeline_queue_depth gauge\n";
+  out += "simplview_pipeline_queue_depth " + QByteArray::number(governor->getQueueLength()) + "\n";
+
+  out += "# HELP simplview_filter_duration_seconds Time each filter spent executing.\n";
+  out += "# TYPE simplview_filter_duration_seconds histogram\n";
+  for(QMap<QString, Histogram>::const_iterator iter = m_FilterDurations.constBegin(); iter != m_FilterDurations.constEnd(); ++iter)
+  {
+    AppendHistogram(out, "simplview_filter_duration_seconds", "filter=\"" + EscapeLabel(iter.key()) + "\"", iter.value(), k_FilterBounds);
+  }
+
+  out += "# HELP simplview_preflight_duration_seconds Time a preflight of the pipeline took.\n";
+  out += "# TYPE simplview_preflight_duration_seconds histogram\n";
+  AppendHistogram(out, "simplview_preflight_duration_seconds", QByteArray(), m_PreflightDurations, k_PreflightBounds);
+
+  if(ResourceSampler::IsSupported())
+  {
+    out += "# HELP simplview_resident_memory_bytes Resident memory of the process.\n";
+    out += "# TYPE simplview_resident_memory_bytes gauge\n";
+    out += "simplview_resident_memory_bytes " + QByteArray::number(ResourceSampler::CurrentResidentBytes()) + "\n";
+  }
+
+  out += "# HELP simplview_memory_budget_bytes Memory budget of the pipeline memory governor.\n";
+  out += "# TYPE simplview_memory_budget_bytes gauge\n";
+  out += "simplview_memory_budget_bytes " + QByteArray::number(governor->getBudget()) + "\n";
+
+  out += "# HELP simplview_plugin_load_seconds Time spent loading plugins at startup.\n";
+  out += "# TYPE simplview_plugin_load_seconds gauge\n";
+  out += "simplview_plugin_load_seconds " + QByteArray::number(m_PluginLoadSeconds, 'g', 6) + "\n";
+
+  out += "# HELP simplview_plugins_loaded Plugins loaded at startup.\n";
+  out += "# TYPE simplview_plugins_loaded gauge\n";
+  out += "simplview_plugins_loaded " + QByteArray::number(m_PluginCount) + "\n";
+
+  out += "# HELP simplview_uptime_seconds Time since the application started.\n";
+  out += "# TYPE simplview_uptime_seconds gauge\n";
+  out += "simplview_uptime_seconds " + QByteArray::number(m_StartTime.secsTo(QDateTime::currentDateTime())) + "\n";
+
+  return out;
+}
@@ -0,0 +1,168 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QMap>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+class LocalHttpServer;
+
+/**
+ * @brief The MetricsServer class serves the application's metrics in the Prometheus text format over HTTP so
+ * that long running SIMPLView sessions can be scraped by a monitoring system. The server is off by default;
+ * when it is enabled it only listens on the loopback interface and answers GET /metrics. Any HTTP client
+ * works for a quick look:
+ * @code
+ *   curl http://127.0.0.1:9464/metrics
+ * @endcode
+ *
+ * The counters are fed from the GUI thread by the same places that show pipeline messages and finished
+ * pipelines; the memory governor's queue and the resident memory are read when a scrape arrives.
+ */
+class MetricsServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~MetricsServer() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static MetricsServer* Instance();
+
+  static const quint16 DefaultPort = 9464;
+
+  /**
+   * @brief Starts the server if it was enabled in an earlier session
+   */
+  void restore();
+
+  /**
+   * @brief Starts or stops the server and remembers the choice
+   * @param enabled
+   * @param errorMessage Receives the reason if the server could not start
+   * @return True if the server is in the requested state
+   */
+  bool setEnabled(bool enabled, QString* errorMessage = nullptr);
+
+  /**
+   * @brief isEnabled
+   * @return
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief Returns the port the server listens on, or would listen on once enabled
+   * @return
+   */
+  quint16 getPort() const;
+
+  /**
+   * @brief Records a finished pipeline
+   * @param canceled
+   */
+  void pipelineFinished(bool canceled);
+
+  /**
+   * @brief Records how long one filter ran
+   * @param className
+   * @param seconds
+   */
+  void observeFilter(const QString& className, double seconds);
+
+  /**
+   * @brief Records how long a preflight took
+   * @param seconds
+   */
+  void observePreflight(double seconds);
+
+  /**
+   * @brief Records how long loading the plugins took at startup
+   * @param seconds
+   * @param pluginCount
+   */
+  void setPluginLoadTime(double seconds, int pluginCount);
+
+  /**
+   * @brief Returns the current metrics in the Prometheus text exposition format
+   * @return
+   */
+  QByteArray metrics() const;
+
+signals:
+  void enabledChanged(bool enabled);
+
+protected:
+  MetricsServer(QObject* parent = nullptr);
+
+private:
+  static MetricsServer* self;
+
+  /**
+   * @brief A cumulative histogram with fixed bucket bounds
+   */
+  struct Histogram
+  {
+    QVector<quint64> counts;
+    quint64 count = 0;
+    double sum = 0.0;
+  };
+
+  LocalHttpServer* m_Http = nullptr;
+  quint16 m_Port = DefaultPort;
+  QDateTime m_StartTime;
+
+  quint64 m_PipelinesFinished = 0;
+  quint64 m_PipelinesCanceled = 0;
+  QMap<QString, Histogram> m_FilterDurations;
+  Histogram m_PreflightDurations;
+  double m_PluginLoadSeconds = 0.0;
+  int m_PluginCount = 0;
+
+  static void Observe(Histogram& histogram, const QVector<double>& bounds, double value);
+  static void AppendHistogram(QByteArray& out, const QByteArray& name, const QByteArray& labels, const Histogram& histogram, const QVector<double>& bounds);
+
+public:
+  MetricsServer(const MetricsServer&) = delete;            // Copy Constructor Not Implemented
+  MetricsServer(MetricsServer&&) = delete;                 // Move Constructor Not Implemented
+  MetricsServer& operator=(const MetricsServer&) = delete; // Copy Assignment Not Implemented
+  MetricsServer& operator=(MetricsServer&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,182 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineArrayReleaser.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+#include "SIMPLView/PipelineMemoryGovernor.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsCache.h"
+
+namespace
+{
+const QString k_EnabledKey("Release Unused Arrays");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineArrayReleaser::PipelineArrayReleaser(QObject* parent)
+: QObject(parent)
+, m_ReleasedCount(0)
+, m_ReleasedBytes(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineArrayReleaser::~PipelineArrayReleaser()
+{
+  clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineArrayReleaser::IsEnabled()
+{
+  return SettingsCache::Instance()->value(SIMPLView::ApplicationSettings::GroupName, k_EnabledKey, QVariant(false)).toBool();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineArrayReleaser::SetEnabled(bool enabled)
+{
+  SettingsCache::Instance()->setValue(SIMPLView::ApplicationSettings::GroupName, k_EnabledKey, QVariant(enabled));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineDataFlow::ReleasePlan PipelineArrayReleaser::plan(FilterPipeline::Pointer pipeline)
+{
+  clear();
+
+  PipelineDataFlow::ReleasePlan releasePlan = PipelineDataFlow::PlanReleases(pipeline);
+  if(releasePlan.isEmpty())
+  {
+    return releasePlan;
+  }
+
+  // The pipeline view executes the same filter objects that it preflights
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  QMutexLocker locker(&m_Mutex);
+  for(int i = 0; i < filters.size() && i < releasePlan.releaseAfter.size(); i++)
+  {
+    if(releasePlan.releaseAfter[i].isEmpty())
+    {
+      continue;
+    }
+    AbstractFilter::Pointer filter = filters[i];
+    m_ReleaseAfter.insert(filter.get(), releasePlan.releaseAfter[i]);
+    m_Filters.push_back(filter);
+    connect(filter.get(), SIGNAL(filterCompleted(AbstractFilter*)), this, SLOT(filterCompleted(AbstractFilter*)), Qt::DirectConnection);
+  }
+  return releasePlan;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineArrayReleaser::clear()
+{
+  QMutexLocker locker(&m_Mutex);
+  for(const AbstractFilter::Pointer& filter : m_Filters)
+  {
+    disconnect(filter.get(), SIGNAL(filterCompleted(AbstractFilter*)), this, SLOT(filterCompleted(AbstractFilter*)));
+  }
+  m_Filters.clear();
+  m_ReleaseAfter.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineArrayReleaser::takeReleased(qint64* bytes)
+{
+  if(nullptr != bytes)
+  {
+    *bytes = m_ReleasedBytes.exchange(0);
+  }
+  return m_ReleasedCount.exchange(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineArrayReleaser::filterCompleted(AbstractFilter* filter)
+{
+  // Only executions run off the GUI thread; a preflight still needs every array for the filters after this one
+  if(QThread::currentThread() == QCoreApplication::instance()->thread() || filter->getErrorCondition() < 0 || filter->getCancel())
+  {
+    return;
+  }
+
+  QVector<DataArrayPath> paths;
+  {
+    QMutexLocker locker(&m_Mutex);
+    paths = m_ReleaseAfter.value(filter);
+  }
+
+  DataContainerArray::Pointer dca = filter->getDataContainerArray();
+  if(paths.isEmpty() || nullptr == dca.get())
+  {
+    return;
+  }
+
+  for(const DataArrayPath& path : paths)
+  {
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(path);
+    if(nullptr == am.get())
+    {
+      continue;
+    }
+    // The memory goes when the last reference does, which is here unless a filter kept one
+    IDataArray::Pointer array = am->removeAttributeArray(path.getDataArrayName());
+    if(nullptr != array.get())
+    {
+      m_ReleasedCount++;
+      m_ReleasedBytes += PipelineMemoryGovernor::ArrayBytes(array);
+    }
+  }
+}
@@ -0,0 +1,116 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "SIMPLView/PipelineDataFlow.h"
+
+/**
+ * @brief The PipelineArrayReleaser class removes intermediate arrays from the data structure while a pipeline
+ * executes, as soon as the last filter that uses them has completed. The plan comes from
+ * PipelineDataFlow::PlanReleases() after every preflight.
+ *
+ * The releases happen on the execution thread, directly from the filterCompleted signal of each filter and
+ * therefore before the next filter starts. Preflights run on the GUI thread and are never touched.
+ */
+class PipelineArrayReleaser : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineArrayReleaser(QObject* parent = nullptr);
+  ~PipelineArrayReleaser() override;
+
+  /**
+   * @brief Returns whether releasing is switched on. The setting is shared by all windows.
+   * @return
+   */
+  static bool IsEnabled();
+
+  /**
+   * @brief Stores whether releasing is switched on
+   * @param enabled
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * @brief Plans the releases for a preflighted pipeline and watches its filters
+   * @param pipeline
+   * @return The plan
+   */
+  PipelineDataFlow::ReleasePlan plan(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Stops watching the filters of the last plan
+   */
+  void clear();
+
+  /**
+   * @brief Returns the number of arrays released since the last call and resets it
+   * @param bytes Receives the bytes they held
+   * @return
+   */
+  int takeReleased(qint64* bytes = nullptr);
+
+protected slots:
+  /**
+   * @brief Runs on the execution thread after each filter
+   * @param filter
+   */
+  void filterCompleted(AbstractFilter* filter);
+
+private:
+  QMutex m_Mutex;
+  QHash<AbstractFilter*, QVector<DataArrayPath>> m_ReleaseAfter;
+  QVector<AbstractFilter::Pointer> m_Filters;
+  std::atomic<int> m_ReleasedCount;
+  std::atomic<qint64> m_ReleasedBytes;
+
+public:
+  PipelineArrayReleaser(const PipelineArrayReleaser&) = delete;            // Copy Constructor Not Implemented
+  PipelineArrayReleaser(PipelineArrayReleaser&&) = delete;                 // Move Constructor Not Implemented
+  PipelineArrayReleaser& operator=(const PipelineArrayReleaser&) = delete; // Copy Assignment Not Implemented
+  PipelineArrayReleaser& operator=(PipelineArrayReleaser&&) = delete;      // Move Assignment Not Implemented
+};
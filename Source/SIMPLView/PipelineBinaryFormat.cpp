@@ -0,0 +1,555 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineBinaryFormat.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QVector>
+#include <QtCore/QtEndian>
+
+namespace
+{
+const char k_Magic[4] = {'S', 'V', 'P', 'B'};
+const int k_HeaderSize = 8;
+const int k_MaxDepth = 128;
+
+// The largest magnitude for which every integer is exactly representable as a double
+const double k_MaxExactInteger = 9007199254740992.0;
+
+// Value tags
+const quint8 k_NullTag = 0;
+const quint8 k_FalseTag = 1;
+const quint8 k_TrueTag = 2;
+const quint8 k_IntegerTag = 3;
+const quint8 k_DoubleTag = 4;
+const quint8 k_StringTag = 5;
+const quint8 k_ArrayTag = 6;
+const quint8 k_ObjectTag = 7;
+
+/**
+ * @brief Writes the body of the document while collecting the string table
+ */
+class Encoder
+{
+public:
+  QByteArray body;
+  QVector<QByteArray> strings;
+
+  void writeVarint(quint64 value)
+  {
+    while(value >= 0x80)
+    {
+      body.append(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    body.append(static_cast<char>(value));
+  }
+
+  void writeString(const QString& str)
+  {
+    QHash<QString, quint32>::const_iterator iter = m_StringIndex.constFind(str);
+    if(iter != m_StringIndex.constEnd())
+    {
+      writeVarint(iter.value());
+      return;
+    }
+    quint32 index = static_cast<quint32>(strings.size());
+    m_StringIndex.insert(str, index);
+    strings.push_back(str.toUtf8());
+    writeVarint(index);
+  }
+
+  void writeValue(const QJsonValue& value)
+  {
+    switch(value.type())
+    {
+    case QJsonValue::Bool:
+      body.append(static_cast<char>(value.toBool() ? k_TrueTag : k_FalseTag));
+      break;
+    case QJsonValue::Double:
+    {
+      double d = value.toDouble();
+      if(std::floor(d) == d && std::fabs(d) <= k_MaxExactInteger && !(d == 0.0 && std::signbit(d)))
+      {
+        qint64 i = static_cast<qint64>(d);
+        body.append(static_cast<char>(k_IntegerTag));
+        writeVarint((static_cast<quint64>(i) << 1) ^ static_cast<quint64>(i >> 63));
+      }
+      else
+      {
+        body.append(static_cast<char>(k_DoubleTag));
+        quint64 bits = 0;
+        std::memcpy(&bits, &d, sizeof(d));
+        char bytes[8];
+        qToLittleEndian<quint64>(bits, reinterpret_cast<uchar*>(bytes));
+        body.append(bytes, 8);
+      }
+      break;
+    }
+    case QJsonValue::String:
+      body.append(static_cast<char>(k_StringTag));
+      writeString(value.toString());
+      break;
+    case QJsonValue::Array:
+    {
+      QJsonArray array = value.toArray();
+      body.append(static_cast<char>(k_ArrayTag));
+      writeVarint(static_cast<quint64>(array.size()));
+      for(const QJsonValue& item : array)
+      {
+        writeValue(item);
+      }
+      break;
+    }
+    case QJsonValue::Object:
+      writeObject(value.toObject());
+      break;
+    default:
+      body.append(static_cast<char>(k_NullTag));
+      break;
+    }
+  }
+
+  void writeObject(const QJsonObject& object)
+  {
+    body.append(static_cast<char>(k_ObjectTag));
+    writeVarint(static_cast<quint64>(object.size()));
+    for(QJsonObject::const_iterator iter = object.constBegin(); iter != object.constEnd(); ++iter)
+    {
+      writeString(iter.key());
+      writeValue(iter.value());
+    }
+  }
+
+private:
+  QHash<QString, quint32> m_StringIndex;
+};
+
+/**
+ * @brief Reads a document written by the Encoder. Every read is bounds checked so that a truncated
+ * or corrupt file produces an error instead of undefined behavior.
+ */
+class Decoder
+{
+public:
+  Decoder(const QByteArray& data)
+  : m_Data(reinterpret_cast<const uchar*>(data.constData()))
+  , m_Size(data.size())
+  {
+  }
+
+  QString error;
+
+  bool readHeader()
+  {
+    if(m_Size < k_HeaderSize || std::memcmp(m_Data, k_Magic, 4) != 0)
+    {
+      error = QObject::tr("The data is not a binary pipeline");
+      return false;
+    }
+    quint16 version = qFromLittleEndian<quint16>(m_Data + 4);
+    if(version > PipelineBinaryFormat::Version)
+    {
+      error = QObject::tr("The binary pipeline uses format version %1 but only versions up to %2 are supported").arg(version).arg(PipelineBinaryFormat::Version);
+      return false;
+    }
+    m_Pos = k_HeaderSize;
+    return true;
+  }
+
+  bool readStringTable()
+  {
+    quint64 count = 0;
+    if(!readVarint(count) || count > static_cast<quint64>(m_Size))
+    {
+      return fail();
+    }
+    m_Strings.reserve(static_cast<int>(count));
+    for(quint64 i = 0; i < count; i++)
+    {
+      quint64 length = 0;
+      if(!readVarint(length) || length > static_cast<quint64>(m_Size - m_Pos))
+      {
+        return fail();
+      }
+      m_Strings.push_back(QString::fromUtf8(reinterpret_cast<const char*>(m_Data + m_Pos), static_cast<int>(length)));
+      m_Pos += static_cast<int>(length);
+    }
+    return true;
+  }
+
+  bool readValue(QJsonValue& value, int depth)
+  {
+    if(depth > k_MaxDepth || m_Pos >= m_Size)
+    {
+      return fail();
+    }
+
+    quint8 tag = m_Data[m_Pos++];
+    switch(tag)
+    {
+    case k_NullTag:
+      value = QJsonValue(QJsonValue::Null);
+      return true;
+    case k_FalseTag:
+      value = QJsonValue(false);
+      return true;
+    case k_TrueTag:
+      value = QJsonValue(true);
+      return true;
+    case k_IntegerTag:
+    {
+      quint64 zigzag = 0;
+      if(!readVarint(zigzag))
+      {
+        return fail();
+      }
+      qint64 i = static_cast<qint64>(zigzag >> 1) ^ -static_cast<qint64>(zigzag & 1);
+      value = QJsonValue(static_cast<double>(i));
+      return true;
+    }
+    case k_DoubleTag:
+    {
+      if(m_Size - m_Pos < 8)
+      {
+        return fail();
+      }
+      quint64 bits = qFromLittleEndian<quint64>(m_Data + m_Pos);
+      m_Pos += 8;
+      double d = 0.0;
+      std::memcpy(&d, &bits, sizeof(d));
+      value = QJsonValue(d);
+      return true;
+    }
+    case k_StringTag:
+    {
+      QString str;
+      if(!readString(str))
+      {
+        return false;
+      }
+      value = QJsonValue(str);
+      return true;
+    }
+    case k_ArrayTag:
+    {
+      quint64 count = 0;
+      if(!readVarint(count) || count > static_cast<quint64>(m_Size - m_Pos))
+      {
+        return fail();
+      }
+      QJsonArray array;
+      for(quint64 i = 0; i < count; i++)
+      {
+        QJsonValue item;
+        if(!readValue(item, depth + 1))
+        {
+          return false;
+        }
+        array.append(item);
+      }
+      value = array;
+      return true;
+    }
+    case k_ObjectTag:
+    {
+      quint64 count = 0;
+      if(!readVarint(count) || count > static_cast<quint64>(m_Size - m_Pos))
+      {
+        return fail();
+      }
+      QJsonObject object;
+      for(quint64 i = 0; i < count; i++)
+      {
+        QString key;
+        QJsonValue item;
+        if(!readString(key) || !readValue(item, depth + 1))
+        {
+          return false;
+        }
+        object.insert(key, item);
+      }
+      value = object;
+      return true;
+    }
+    default:
+      error = QObject::tr("Unknown value tag %1 at byte %2").arg(tag).arg(m_Pos - 1);
+      return false;
+    }
+  }
+
+  bool atEnd() const
+  {
+    return m_Pos == m_Size;
+  }
+
+private:
+  const uchar* m_Data = nullptr;
+  int m_Size = 0;
+  int m_Pos = 0;
+  QVector<QString> m_Strings;
+
+  bool fail()
+  {
+    if(error.isEmpty())
+    {
+      error = QObject::tr("The binary pipeline is truncated or corrupt near byte %1").arg(m_Pos);
+    }
+    return false;
+  }
+
+  bool readVarint(quint64& value)
+  {
+    value = 0;
+    int shift = 0;
+    while(m_Pos < m_Size && shift < 64)
+    {
+      quint8 byte = m_Data[m_Pos++];
+      value |= static_cast<quint64>(byte & 0x7F) << shift;
+      if((byte & 0x80) == 0)
+      {
+        return true;
+      }
+      shift += 7;
+    }
+    return false;
+  }
+
+  bool readString(QString& str)
+  {
+    quint64 index = 0;
+    if(!readVarint(index) || index >= static_cast<quint64>(m_Strings.size()))
+    {
+      return fail();
+    }
+    str = m_Strings[static_cast<int>(index)];
+    return true;
+  }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool WriteFileContents(const QString& filePath, const QByteArray& contents, QString* errorMessage)
+{
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = QObject::tr("Could not open '%1' for writing: %2").arg(filePath).arg(file.errorString());
+    }
+    return false;
+  }
+  file.write(contents);
+  if(!file.commit())
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = QObject::tr("Could not write '%1': %2").arg(filePath).arg(file.errorString());
+    }
+    return false;
+  }
+  return true;
+}
+}
+
+const quint16 PipelineBinaryFormat::Version;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineBinaryFormat::FileExtension()
+{
+  return QString("svpb");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineBinaryFormat::IsBinaryPipeline(const QByteArray& data)
+{
+  return data.size() >= k_HeaderSize && std::memcmp(data.constData(), k_Magic, 4) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineBinaryFormat::IsBinaryPipelineFile(const QString& filePath)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  return IsBinaryPipeline(file.read(k_HeaderSize));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray PipelineBinaryFormat::Encode(const QJsonObject& root)
+{
+  Encoder encoder;
+  encoder.writeObject(root);
+
+  QByteArray output;
+  output.reserve(encoder.body.size() + k_HeaderSize + encoder.strings.size() * 16);
+  output.append(k_Magic, 4);
+
+  char header[4];
+  qToLittleEndian<quint16>(Version, reinterpret_cast<uchar*>(header));
+  qToLittleEndian<quint16>(0, reinterpret_cast<uchar*>(header + 2));
+  output.append(header, 4);
+
+  // The string table goes in front of the body so the decoder can resolve indices as it goes
+  QByteArray body;
+  body.swap(encoder.body);
+  encoder.writeVarint(static_cast<quint64>(encoder.strings.size()));
+  for(const QByteArray& str : encoder.strings)
+  {
+    encoder.writeVarint(static_cast<quint64>(str.size()));
+    encoder.body.append(str);
+  }
+  output.append(encoder.body);
+  output.append(body);
+
+  return output;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineBinaryFormat::Decode(const QByteArray& data, QJsonObject& root, QString* errorMessage)
+{
+  Decoder decoder(data);
+  QJsonValue value;
+  bool ok = decoder.readHeader() && decoder.readStringTable() && decoder.readValue(value, 0);
+  if(ok && (!value.isObject() || !decoder.atEnd()))
+  {
+    decoder.error = QObject::tr("The binary pipeline has unexpected trailing data");
+    ok = false;
+  }
+
+  if(!ok)
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = decoder.error;
+    }
+    return false;
+  }
+
+  root = value.toObject();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineBinaryFormat::ReadDocument(const QString& filePath, QJsonObject& root, QString* errorMessage)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = QObject::tr("Could not open '%1': %2").arg(filePath).arg(file.errorString());
+    }
+    return false;
+  }
+  QByteArray contents = file.readAll();
+
+  if(IsBinaryPipeline(contents))
+  {
+    return Decode(contents, root, errorMessage);
+  }
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(contents, &parseError);
+  if(parseError.error != QJsonParseError::NoError || !doc.isObject())
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = QObject::tr("Could not parse '%1': %2").arg(filePath).arg(parseError.errorString());
+    }
+    return false;
+  }
+  root = doc.object();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineBinaryFormat::ConvertJsonToBinary(const QString& jsonFilePath, const QString& binaryFilePath, QString* errorMessage)
+{
+  QJsonObject root;
+  if(!ReadDocument(jsonFilePath, root, errorMessage))
+  {
+    return -1;
+  }
+  if(!WriteFileContents(binaryFilePath, Encode(root), errorMessage))
+  {
+    return -2;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineBinaryFormat::ConvertBinaryToJson(const QString& binaryFilePath, const QString& jsonFilePath, QString* errorMessage)
+{
+  QJsonObject root;
+  if(!ReadDocument(binaryFilePath, root, errorMessage))
+  {
+    return -1;
+  }
+  QJsonDocument doc(root);
+  if(!WriteFileContents(jsonFilePath, doc.toJson(QJsonDocument::Indented), errorMessage))
+  {
+    return -2;
+  }
+  return 0;
+}
@@ -0,0 +1,132 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+/**
+ * @brief The PipelineBinaryFormat class converts between the Json pipeline document and a compact binary
+ * encoding of the same document. The conversion is lossless in both directions: decoding an encoded
+ * document gives back an identical QJsonObject.
+ *
+ * Layout (all integers little endian, "varint" is an unsigned LEB128 value):
+ * @code
+ *   char[4]  magic "SVPB"
+ *   uint16   format version
+ *   uint16   flags (reserved, 0)
+ *   varint   string count, followed by (varint length, UTF-8 bytes) per string
+ *   value    the root object
+ * @endcode
+ * Every object key and every string value is stored once in the string table and referenced by index,
+ * so filter class names and parameter names that repeat through a pipeline cost a single varint each.
+ * Values are tagged with one byte; numbers that hold an exact integer are stored as zig-zag varints and
+ * all other numbers as 8 byte IEEE doubles.
+ */
+class PipelineBinaryFormat
+{
+public:
+  static const quint16 Version = 1;
+
+  /**
+   * @brief The suffix used for binary pipeline files
+   */
+  static QString FileExtension();
+
+  /**
+   * @brief Returns true if the data starts with the binary pipeline signature
+   * @param data
+   * @return
+   */
+  static bool IsBinaryPipeline(const QByteArray& data);
+
+  /**
+   * @brief Returns true if the file starts with the binary pipeline signature
+   * @param filePath
+   * @return
+   */
+  static bool IsBinaryPipelineFile(const QString& filePath);
+
+  /**
+   * @brief Encodes a pipeline document
+   * @param root
+   * @return
+   */
+  static QByteArray Encode(const QJsonObject& root);
+
+  /**
+   * @brief Decodes a binary pipeline document
+   * @param data
+   * @param root Receives the decoded document
+   * @param errorMessage Receives a description of the problem if the decode fails
+   * @return True on success
+   */
+  static bool Decode(const QByteArray& data, QJsonObject& root, QString* errorMessage = nullptr);
+
+  /**
+   * @brief Reads a pipeline file in either format into a Json object
+   * @param filePath
+   * @param root
+   * @param errorMessage
+   * @return True on success
+   */
+  static bool ReadDocument(const QString& filePath, QJsonObject& root, QString* errorMessage = nullptr);
+
+  /**
+   * @brief Converts a Json pipeline file to the binary encoding
+   * @param jsonFilePath
+   * @param binaryFilePath
+   * @param errorMessage
+   * @return 0 on success, a negative value otherwise
+   */
+  static int ConvertJsonToBinary(const QString& jsonFilePath, const QString& binaryFilePath, QString* errorMessage = nullptr);
+
+  /**
+   * @brief Converts a binary pipeline file back to Json
+   * @param binaryFilePath
+   * @param jsonFilePath
+   * @param errorMessage
+   * @return 0 on success, a negative value otherwise
+   */
+  static int ConvertBinaryToJson(const QString& binaryFilePath, const QString& jsonFilePath, QString* errorMessage = nullptr);
+
+  PipelineBinaryFormat() = delete;
+  PipelineBinaryFormat(const PipelineBinaryFormat&) = delete;            // Copy Constructor Not Implemented
+  PipelineBinaryFormat(PipelineBinaryFormat&&) = delete;                 // Move Constructor Not Implemented
+  PipelineBinaryFormat& operator=(const PipelineBinaryFormat&) = delete; // Copy Assignment Not Implemented
+  PipelineBinaryFormat& operator=(PipelineBinaryFormat&&) = delete;      // Move Assignment Not Implemented
+};
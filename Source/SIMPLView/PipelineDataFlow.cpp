@@ -0,0 +1,505 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineDataFlow.h"
+
+#include <algorithm>
+
+#include <QtCore/QObject>
+#include <QtCore/QVariant>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/DataContainers/DataContainerArrayProxy.h"
+#include "SIMPLib/FilterParameters/FilterParameter.h"
+
+#include "SIMPLView/PipelineMemoryGovernor.h"
+
+namespace
+{
+/**
+ * @brief Returns the paths that a filter parameter value holds
+ */
+QVector<DataArrayPath> PathsOf(const QVariant& value)
+{
+  QVector<DataArrayPath> paths;
+  if(value.userType() == qMetaTypeId<DataArrayPath>())
+  {
+    paths.push_back(value.value<DataArrayPath>());
+  }
+  else if(value.userType() == qMetaTypeId<QVector<DataArrayPath>>())
+  {
+    paths = value.value<QVector<DataArrayPath>>();
+  }
+
+  paths.erase(std::remove_if(paths.begin(), paths.end(), [](const DataArrayPath& path) { return path.getDataContainerName().isEmpty(); }), paths.end());
+  return paths;
+}
+
+/**
+ * @brief Returns true if any path of a covers any path of b or the other way round
+ */
+bool Overlap(const QVector<DataArrayPath>& a, const QVector<DataArrayPath>& b)
+{
+  for(const DataArrayPath& x : a)
+  {
+    for(const DataArrayPath& y : b)
+    {
+      if(PipelineDataFlow::Covers(x, y) || PipelineDataFlow::Covers(y, x))
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Returns true if the lists share a name
+ */
+bool Overlap(const QStringList& a, const QStringList& b)
+{
+  return std::any_of(a.begin(), a.end(), [&b](const QString& name) { return !name.isEmpty() && b.contains(name); });
+}
+
+/**
+ * @brief Returns what a filter writes. A filter that creates nothing works in place on the attribute
+ * matrices it reads from.
+ */
+QVector<DataArrayPath> WrittenPaths(const PipelineDataFlow::FilterAccess& access)
+{
+  if(!access.creates.isEmpty() || !access.createdNames.isEmpty())
+  {
+    return access.creates;
+  }
+  QVector<DataArrayPath> written;
+  for(const DataArrayPath& path : access.reads)
+  {
+    written.push_back(DataArrayPath(path.getDataContainerName(), path.getAttributeMatrixName(), QString()));
+  }
+  return written;
+}
+
+/**
+ * @brief Returns true if the path names exactly one array
+ */
+bool IsArrayPath(const DataArrayPath& path)
+{
+  return !path.getAttributeMatrixName().isEmpty() && !path.getDataArrayName().isEmpty();
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineDataFlow::Covers(const DataArrayPath& ref, const DataArrayPath& array)
+{
+  if(ref.getDataContainerName() != array.getDataContainerName())
+  {
+    return false;
+  }
+  if(ref.getAttributeMatrixName().isEmpty())
+  {
+    return true;
+  }
+  if(ref.getAttributeMatrixName() != array.getAttributeMatrixName())
+  {
+    return false;
+  }
+  return ref.getDataArrayName().isEmpty() || ref.getDataArrayName() == array.getDataArrayName();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<PipelineDataFlow::FilterAccess> PipelineDataFlow::Analyze(FilterPipeline::Pointer pipeline)
+{
+  QVector<FilterAccess> result;
+  if(nullptr == pipeline.get())
+  {
+    return result;
+  }
+
+  for(AbstractFilter::Pointer filter : pipeline->getFilterContainer())
+  {
+    FilterAccess access;
+    access.enabled = filter->getEnabled();
+    bool inputFilter = (filter->getSubGroupName() == SIMPL::FilterSubGroups::InputFilters);
+    bool outputFilter = IsOutputFilter(filter);
+
+    for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+    {
+      QString propertyName = parameter->getPropertyName();
+      if(propertyName.isEmpty())
+      {
+        continue;
+      }
+
+      QVariant value = filter->property(propertyName.toLatin1().constData());
+      bool created = (parameter->getCategory() == FilterParameter::CreatedArray);
+
+      // A proxy selects from the whole structure: what a reader imports, or what anything else consumes
+      if(value.userType() == qMetaTypeId<DataContainerArrayProxy>())
+      {
+        access.readsEverything = access.readsEverything || !inputFilter;
+        continue;
+      }
+      if(value.type() == QVariant::String)
+      {
+        if(created)
+        {
+          access.createdNames << value.toString();
+        }
+        else if(parameter->getCategory() == FilterParameter::RequiredArray)
+        {
+          access.readNames << value.toString();
+        }
+        continue;
+      }
+
+      // Parameters outside the array categories can still name arrays, for example a mask that is switched on
+      QVector<DataArrayPath> paths = PathsOf(value);
+      (created ? access.creates : access.reads) << paths;
+    }
+
+    // A writer that does not say what it writes writes everything
+    if(outputFilter && access.reads.isEmpty())
+    {
+      access.readsEverything = true;
+    }
+    result.push_back(access);
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer PipelineDataFlow::PreflightedStructure(FilterPipeline::Pointer pipeline)
+{
+  if(nullptr == pipeline.get() || pipeline->getFilterContainer().isEmpty())
+  {
+    return DataContainerArray::NullPointer();
+  }
+  return pipeline->getFilterContainer().back()->getDataContainerArray();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineDataFlow::VisitAttributeMatrices(DataContainerArray::Pointer dca, const std::function<void(const DataArrayPath& path, AttributeMatrix::Pointer am)>& visitor)
+{
+  if(nullptr == dca.get())
+  {
+    return;
+  }
+
+  for(const QString& dcName : dca->getDataContainerNames())
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    if(nullptr == dc.get())
+    {
+      continue;
+    }
+    for(const QString& amName : dc->getAttributeMatrixNames())
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      if(nullptr != am.get())
+      {
+        visitor(DataArrayPath(dcName, amName, QString()), am);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineDataFlow::IsOutputFilter(AbstractFilter::Pointer filter)
+{
+  return filter->getGroupName() == SIMPL::FilterGroups::IOFilters && filter->getSubGroupName() == SIMPL::FilterSubGroups::OutputFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<DataArrayPath> PipelineDataFlow::ArrayPaths(FilterPipeline::Pointer pipeline)
+{
+  QVector<DataArrayPath> paths;
+  VisitAttributeMatrices(PreflightedStructure(pipeline), [&paths](const DataArrayPath& amPath, AttributeMatrix::Pointer am) {
+    for(const QString& arrayName : am->getAttributeArrayNames())
+    {
+      paths.push_back(DataArrayPath(amPath.getDataContainerName(), amPath.getAttributeMatrixName(), arrayName));
+    }
+  });
+  return paths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<PipelineDataFlow::ArrayLifetime> PipelineDataFlow::Lifetimes(FilterPipeline::Pointer pipeline, const QVector<FilterAccess>& access)
+{
+  QVector<ArrayLifetime> lifetimes;
+  QVector<DataArrayPath> paths = ArrayPaths(pipeline);
+  if(paths.isEmpty())
+  {
+    return lifetimes;
+  }
+  DataContainerArray::Pointer dca = PreflightedStructure(pipeline);
+
+  for(const DataArrayPath& path : paths)
+  {
+    ArrayLifetime lifetime;
+    lifetime.path = path;
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(path);
+    lifetime.bytes = PipelineMemoryGovernor::ArrayBytes((nullptr != am.get()) ? am->getAttributeArray(path.getDataArrayName()) : IDataArray::NullPointer());
+
+    // Arrays whose creator is not known are assumed to exist from the start, which never releases too early
+    QString arrayName = path.getDataArrayName();
+    bool creatorFound = false;
+    for(int i = 0; i < access.size(); i++)
+    {
+      const FilterAccess& filter = access[i];
+      if(!filter.enabled)
+      {
+        continue;
+      }
+
+      bool creates = std::any_of(filter.creates.begin(), filter.creates.end(), [&](const DataArrayPath& created) { return IsArrayPath(created) && Covers(created, path); });
+      if(!creatorFound && (creates || filter.createdNames.contains(arrayName)))
+      {
+        lifetime.created = i;
+        creatorFound = true;
+      }
+
+      bool reads = filter.readsEverything || filter.readNames.contains(arrayName) || std::any_of(filter.reads.begin(), filter.reads.end(), [&](const DataArrayPath& read) { return Covers(read, path); });
+      if(reads)
+      {
+        lifetime.lastRead = i;
+      }
+      if(reads || creates)
+      {
+        lifetime.lastUse = i;
+      }
+    }
+    lifetimes.push_back(lifetime);
+  }
+  return lifetimes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineDataFlow::ReleasePlan PipelineDataFlow::PlanReleases(FilterPipeline::Pointer pipeline)
+{
+  ReleasePlan plan;
+  QVector<FilterAccess> access = Analyze(pipeline);
+  plan.releaseAfter.resize(access.size());
+
+  int lastEnabled = -1;
+  for(int i = 0; i < access.size(); i++)
+  {
+    lastEnabled = access[i].enabled ? i : lastEnabled;
+  }
+
+  QVector<ArrayLifetime> lifetimes = Lifetimes(pipeline, access);
+  QVector<int> releasedAfter(lifetimes.size(), -1);
+  for(int a = 0; a < lifetimes.size(); a++)
+  {
+    const ArrayLifetime& lifetime = lifetimes[a];
+    if(lifetime.lastRead < 0 || lifetime.lastUse >= lastEnabled || lifetime.created > lifetime.lastUse)
+    {
+      continue;
+    }
+    plan.releaseAfter[lifetime.lastUse].push_back(lifetime.path);
+    releasedAfter[a] = lifetime.lastUse;
+    plan.arrayCount++;
+    plan.releasedBytes += lifetime.bytes;
+  }
+
+  // The memory in use while each filter runs, with and without the releases
+  for(int i = 0; i < access.size(); i++)
+  {
+    if(!access[i].enabled)
+    {
+      continue;
+    }
+    qint64 live = 0;
+    qint64 optimizedLive = 0;
+    for(int a = 0; a < lifetimes.size(); a++)
+    {
+      if(lifetimes[a].created > i)
+      {
+        continue;
+      }
+      live += lifetimes[a].bytes;
+      if(releasedAfter[a] < 0 || releasedAfter[a] >= i)
+      {
+        optimizedLive += lifetimes[a].bytes;
+      }
+    }
+    plan.peakBytes = std::max(plan.peakBytes, live);
+    plan.optimizedPeakBytes = std::max(plan.optimizedPeakBytes, optimizedLive);
+  }
+
+  return plan;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> PipelineDataFlow::Slice(FilterPipeline::Pointer pipeline, const DataArrayPath& target)
+{
+  QVector<int> slice;
+  QVector<FilterAccess> access = Analyze(pipeline);
+  if(access.isEmpty())
+  {
+    return slice;
+  }
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+
+  QVector<DataArrayPath> needed = {target};
+  QStringList neededNames = {target.getDataContainerName(), target.getAttributeMatrixName(), target.getDataArrayName()};
+  bool everything = false;
+
+  auto isNeededName = [&neededNames](const QString& name) { return !name.isEmpty() && neededNames.contains(name); };
+  auto touchesNeeded = [&needed](const DataArrayPath& path) {
+    return std::any_of(needed.begin(), needed.end(), [&path](const DataArrayPath& n) { return Covers(path, n) || Covers(n, path); });
+  };
+
+  for(int i = access.size() - 1; i >= 0; i--)
+  {
+    const FilterAccess& filter = access[i];
+    AbstractFilter::Pointer object = filters[i];
+    if(!filter.enabled || IsOutputFilter(object))
+    {
+      continue;
+    }
+
+    bool isNeeded = everything || object->getSubGroupName() == SIMPL::FilterSubGroups::InputFilters;
+    isNeeded = isNeeded || std::any_of(filter.creates.begin(), filter.creates.end(), touchesNeeded);
+    isNeeded = isNeeded || std::any_of(filter.createdNames.begin(), filter.createdNames.end(), isNeededName);
+
+    // Nothing created means the work happens in place, often on every array of the attribute matrix
+    if(!isNeeded && filter.creates.isEmpty() && filter.createdNames.isEmpty())
+    {
+      isNeeded = std::any_of(filter.reads.begin(), filter.reads.end(), [&touchesNeeded](const DataArrayPath& path) {
+        return touchesNeeded(DataArrayPath(path.getDataContainerName(), path.getAttributeMatrixName(), QString()));
+      });
+      isNeeded = isNeeded || std::any_of(filter.readNames.begin(), filter.readNames.end(), isNeededName);
+    }
+    if(!isNeeded)
+    {
+      continue;
+    }
+
+    slice.push_front(i);
+    everything = everything || filter.readsEverything;
+    for(const DataArrayPath& path : filter.reads)
+    {
+      needed.push_back(path);
+      neededNames << path.getDataArrayName();
+    }
+    neededNames << filter.readNames;
+  }
+
+  return slice;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> PipelineDataFlow::Dependents(FilterPipeline::Pointer pipeline, int index, bool withOutputFilters)
+{
+  QVector<int> dependents;
+  QVector<FilterAccess> access = Analyze(pipeline);
+  if(index < 0 || index >= access.size() || !access[index].enabled)
+  {
+    return dependents;
+  }
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+
+  QVector<DataArrayPath> written;
+  QVector<DataArrayPath> read;
+  QStringList writtenNames;
+  QStringList readNames;
+  bool readsEverything = false;
+
+  for(int i = index; i < access.size(); i++)
+  {
+    const FilterAccess& filter = access[i];
+    if(!filter.enabled || (!withOutputFilters && IsOutputFilter(filters[i])))
+    {
+      continue;
+    }
+
+    QVector<DataArrayPath> writes = WrittenPaths(filter);
+    QStringList writesNames = filter.createdNames + (filter.creates.isEmpty() && filter.createdNames.isEmpty() ? filter.readNames : QStringList());
+    bool readsDirty = filter.readsEverything || Overlap(filter.reads, written) || Overlap(filter.readNames, writtenNames);
+    bool writesInputs = (readsEverything && !writes.isEmpty()) || Overlap(writes, read) || Overlap(writesNames, readNames);
+    if(i != index && !readsDirty && !writesInputs)
+    {
+      continue;
+    }
+
+    dependents.push_back(i);
+    written << writes;
+    writtenNames << writesNames;
+    read << filter.reads;
+    readNames << filter.readNames;
+    readsEverything = readsEverything || filter.readsEverything;
+  }
+
+  return dependents;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineDataFlow::Describe(const ReleasePlan& plan)
+{
+  if(plan.isEmpty())
+  {
+    return QObject::tr("No intermediate arrays can be released early; the predicted peak stays at %1").arg(PipelineMemoryGovernor::FormatBytes(plan.peakBytes));
+  }
+  return QObject::tr("Releasing %1 intermediate arrays (%2) after their last use lowers the predicted peak from %3 to %4")
+      .arg(plan.arrayCount)
+      .arg(PipelineMemoryGovernor::FormatBytes(plan.releasedBytes))
+      .arg(PipelineMemoryGovernor::FormatBytes(plan.peakBytes))
+      .arg(PipelineMemoryGovernor::FormatBytes(plan.optimizedPeakBytes));
+}
@@ -0,0 +1,192 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The PipelineDataFlow class works out which arrays each filter of a preflighted pipeline reads and
+ * creates, from the DataArrayPath values of the filter parameters, and plans what can be released early.
+ *
+ * A path without an array name stands for every array of its attribute matrix, and a path with only a data
+ * container name for every array of the data container. Filters that take a DataContainerArrayProxy and
+ * output filters without array selections, such as the DREAM3D file writer, count as reading everything.
+ * The analysis is conservative: an array that is not provably dead stays alive.
+ */
+class PipelineDataFlow
+{
+public:
+  /**
+   * @brief The arrays one filter touches
+   */
+  struct FilterAccess
+  {
+    bool enabled = true;
+    bool readsEverything = false;
+    QVector<DataArrayPath> reads;
+    QVector<DataArrayPath> creates;
+    QStringList readNames;    // Required arrays that the filter only knows by name
+    QStringList createdNames; // Created arrays that the filter only knows by name
+  };
+
+  /**
+   * @brief One array of the preflighted data structure and when it is created and last used
+   */
+  struct ArrayLifetime
+  {
+    DataArrayPath path;
+    qint64 bytes = 0;
+    int created = 0;
+    int lastRead = -1;
+    int lastUse = -1;
+  };
+
+  /**
+   * @brief The arrays to remove after each filter and what that is predicted to save
+   */
+  struct ReleasePlan
+  {
+    QVector<QVector<DataArrayPath>> releaseAfter; // Indexed like the filters of the pipeline
+    int arrayCount = 0;
+    qint64 releasedBytes = 0;
+    qint64 peakBytes = 0;
+    qint64 optimizedPeakBytes = 0;
+
+    bool isEmpty() const
+    {
+      return arrayCount == 0;
+    }
+  };
+
+  /**
+   * @brief Returns true if ref names the array or an attribute matrix or data container that holds it
+   * @param ref
+   * @param array
+   * @return
+   */
+  static bool Covers(const DataArrayPath& ref, const DataArrayPath& array);
+
+  /**
+   * @brief Returns whether a filter writes files, as opposed to reading them or changing the data structure
+   * @param filter
+   * @return
+   */
+  static bool IsOutputFilter(AbstractFilter::Pointer filter);
+
+  /**
+   * @brief Returns what each filter of the pipeline reads and creates
+   * @param pipeline
+   * @return
+   */
+  static QVector<FilterAccess> Analyze(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Returns the data structure that the pipeline's last preflight produced. All the filters of a preflight
+   * share one data container array, so the last filter sees the final structure.
+   * @param pipeline
+   * @return The data container array, or a null pointer if the pipeline has no filters
+   */
+  static DataContainerArray::Pointer PreflightedStructure(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Calls visitor with the path and the attribute matrix of every attribute matrix of a data structure
+   * @param dca May be a null pointer
+   * @param visitor
+   */
+  static void VisitAttributeMatrices(DataContainerArray::Pointer dca, const std::function<void(const DataArrayPath& path, AttributeMatrix::Pointer am)>& visitor);
+
+  /**
+   * @brief Returns the path of every array in the data structure that the pipeline's last preflight produced
+   * @param pipeline
+   * @return
+   */
+  static QVector<DataArrayPath> ArrayPaths(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Returns every array of the preflighted data structure with its lifetime in the pipeline
+   * @param pipeline
+   * @param access From Analyze()
+   * @return
+   */
+  static QVector<ArrayLifetime> Lifetimes(FilterPipeline::Pointer pipeline, const QVector<FilterAccess>& access);
+
+  /**
+   * @brief Plans to release every array that some filter reads right after the last filter that uses it. Arrays
+   * that nothing reads are results and stay, as does everything the last enabled filter uses.
+   * @param pipeline
+   * @return
+   */
+  static ReleasePlan PlanReleases(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Slices the pipeline backwards from one array to the enabled filters that are needed to compute it.
+   * A filter is needed if it creates something that a needed filter reads, including the data container or
+   * attribute matrix around it. Filters that create nothing are taken to modify the attribute matrices they read
+   * from. Readers are always kept and output filters never are.
+   * @param pipeline A pipeline that has been preflighted
+   * @param target
+   * @return The indices of the needed filters in pipeline order
+   */
+  static QVector<int> Slice(FilterPipeline::Pointer pipeline, const DataArrayPath& target);
+
+  /**
+   * @brief Returns the filter at index and the enabled filters after it that have to run again when its
+   * parameters change: those that read what it or another dependent writes, and those that write what one of
+   * them reads. Every other filter can run before them without changing the outcome. Output filters are left out
+   * unless withOutputFilters is set.
+   * @param pipeline A pipeline that has been preflighted
+   * @param index
+   * @param withOutputFilters
+   * @return The indices in pipeline order, starting with index
+   */
+  static QVector<int> Dependents(FilterPipeline::Pointer pipeline, int index, bool withOutputFilters = false);
+
+  /**
+   * @brief Formats a plan as one line for the standard output widget
+   * @param plan
+   * @return
+   */
+  static QString Describe(const ReleasePlan& plan);
+};
@@ -0,0 +1,262 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineLoader.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/IFilterFactory.hpp"
+
+#include "SIMPLView/PipelineBinaryFormat.h"
+#include "SIMPLView/TraceRecorder.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineLoader::PipelineLoader(QObject* parent)
+: QObject(parent)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineLoader::~PipelineLoader()
+{
+  // Superseded loads still own a watcher until they finish; none of them may outlive the loader
+  for(QFutureWatcher<Result>* watcher : findChildren<QFutureWatcher<Result>*>())
+  {
+    watcher->waitForFinished();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineLoader::CanLoad(const QString& filePath)
+{
+  QFileInfo fi(filePath);
+  QString suffix = fi.suffix();
+  return suffix.compare("json", Qt::CaseInsensitive) == 0 || suffix.compare(PipelineBinaryFormat::FileExtension(), Qt::CaseInsensitive) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineLoader::load(const QString& filePath)
+{
+  // Every load gets a watcher of its own, so a new load never waits for the one before it
+  m_Watcher = new QFutureWatcher<Result>(this);
+  connect(m_Watcher, &QFutureWatcher<Result>::finished, this, &PipelineLoader::loadFinished);
+  m_Watcher->setFuture(QtConcurrent::run(&PipelineLoader::ReadPipeline, filePath));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineLoader::isLoading() const
+{
+  return nullptr != m_Watcher && m_Watcher->isRunning();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineLoader::loadFinished()
+{
+  QFutureWatcher<Result>* watcher = static_cast<QFutureWatcher<Result>*>(sender());
+  watcher->deleteLater();
+  if(watcher != m_Watcher)
+  {
+    // A later load superseded this one
+    return;
+  }
+
+  m_Watcher = nullptr;
+  Result result = watcher->result();
+  FinishPipeline(result);
+  emit pipelineLoaded(result);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineLoader::Result PipelineLoader::LoadPipeline(const QString& filePath)
+{
+  Result result = ReadPipeline(filePath);
+  FinishPipeline(result);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineLoader::FinishPipeline(Result& result)
+{
+  if(result.err >= 0)
+  {
+    QElapsedTimer timer;
+    timer.start();
+    InstantiatePipeline(result.document, result);
+    result.timings.instantiate = timer.elapsed();
+  }
+  result.document = QJsonObject();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineLoader::Result PipelineLoader::ReadPipeline(const QString& filePath)
+{
+  SV_TRACE_SCOPE_CATEGORY("Read Pipeline", "io");
+
+  Result result;
+  result.filePath = filePath;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    result.err = -1;
+    result.errorMessage = QObject::tr("Could not open pipeline file '%1': %2").arg(filePath).arg(file.errorString());
+    return result;
+  }
+  QByteArray contents = file.readAll();
+  file.close();
+  result.timings.read = timer.restart();
+
+  // Binary pipelines are recognized by their signature rather than the suffix
+  QJsonObject root;
+  if(PipelineBinaryFormat::IsBinaryPipeline(contents))
+  {
+    QString errorMessage;
+    if(!PipelineBinaryFormat::Decode(contents, root, &errorMessage))
+    {
+      result.err = -2;
+      result.errorMessage = QObject::tr("Could not decode pipeline file '%1': %2").arg(filePath).arg(errorMessage);
+      return result;
+    }
+  }
+  else
+  {
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(contents, &parseError);
+    if(parseError.error != QJsonParseError::NoError)
+    {
+      result.err = -2;
+      result.errorMessage = QObject::tr("Could not parse pipeline file '%1': %2").arg(filePath).arg(parseError.errorString());
+      return result;
+    }
+    root = doc.object();
+  }
+  result.timings.parse = timer.elapsed();
+  result.document = root;
+
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineLoader::InstantiatePipeline(const QJsonObject& root, Result& result)
+{
+  if(!root.contains(SIMPL::Settings::PipelineBuilderGroup))
+  {
+    // Older pipeline layouts are left to the JsonFilterParametersReader
+    result.err = -3;
+    result.errorMessage = QObject::tr("The pipeline file does not contain a '%1' section").arg(SIMPL::Settings::PipelineBuilderGroup);
+    return;
+  }
+
+  QJsonObject builderObj = root[SIMPL::Settings::PipelineBuilderGroup].toObject();
+  int filterCount = builderObj[SIMPL::Settings::NumFilters].toInt();
+  result.pipelineName = builderObj[SIMPL::Settings::PipelineName].toString();
+
+  FilterManager* filterManager = FilterManager::Instance();
+  FilterPipeline::Pointer pipeline = FilterPipeline::New();
+  pipeline->setName(result.pipelineName);
+  for(int i = 0; i < filterCount; i++)
+  {
+    QJsonObject filterObj = root[QString::number(i)].toObject();
+    QString className = filterObj[SIMPL::Settings::FilterName].toString();
+
+    IFilterFactory::Pointer factory = filterManager->getFactoryFromClassName(className);
+    if(nullptr == factory.get())
+    {
+      result.missingFilters.push_back(className);
+      continue;
+    }
+
+    AbstractFilter::Pointer filter = factory->create();
+    filter->readFilterParameters(filterObj);
+    filter->setEnabled(filterObj[SIMPL::Settings::FilterEnabled].toBool(true));
+    pipeline->pushBack(filter);
+  }
+
+  if(!result.missingFilters.isEmpty())
+  {
+    result.err = -4;
+    result.errorMessage = QObject::tr("The following filters are not available: %1").arg(result.missingFilters.join(", "));
+    return;
+  }
+
+  result.pipeline = pipeline;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineLoader::FormatTimings(const Result& result)
+{
+  int filterCount = (nullptr != result.pipeline.get()) ? result.pipeline->size() : 0;
+  qint64 total = result.timings.read + result.timings.parse + result.timings.instantiate + result.timings.insert;
+  return QObject::tr("Loaded %1 filters from '%2' in %3 ms (read %4 ms, parse %5 ms, instantiate %6 ms, insert %7 ms)")
+      .arg(filterCount)
+      .arg(QFileInfo(result.filePath).fileName())
+      .arg(total)
+      .arg(result.timings.read)
+      .arg(result.timings.parse)
+      .arg(result.timings.instantiate)
+      .arg(result.timings.insert);
+}
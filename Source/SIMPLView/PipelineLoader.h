@@ -0,0 +1,158 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The PipelineLoader class loads a pipeline file without blocking the GUI thread on the disk. The file is
+ * read and parsed on a worker thread. Creating filters and reading their parameters is not thread safe, so the
+ * filters are then instantiated on the thread that owns the loader. The finished pipeline is handed back in one
+ * piece so that the pipeline view can insert it with a single batch operation.
+ */
+class PipelineLoader : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineLoader(QObject* parent = nullptr);
+  ~PipelineLoader() override;
+
+  /**
+   * @brief Wall clock time in milliseconds spent in each stage of a load
+   */
+  struct Timings
+  {
+    qint64 read = 0;
+    qint64 parse = 0;
+    qint64 instantiate = 0;
+    qint64 insert = 0;
+  };
+
+  /**
+   * @brief The outcome of a single load. When err is negative the pipeline is null and
+   * errorMessage describes the problem.
+   */
+  struct Result
+  {
+    QString filePath;
+    QString pipelineName;
+    FilterPipeline::Pointer pipeline;
+    QStringList missingFilters;
+    int err = 0;
+    QString errorMessage;
+    Timings timings;
+    QJsonObject document; // The parsed file, until its filters are instantiated
+  };
+
+  /**
+   * @brief Returns true if the file is a pipeline format that this loader can read. Anything else
+   * should be opened through SVPipelineView::openPipeline
+   * @param filePath
+   * @return
+   */
+  static bool CanLoad(const QString& filePath);
+
+  /**
+   * @brief Loads the pipeline synchronously on the calling thread
+   * @param filePath
+   * @return
+   */
+  static Result LoadPipeline(const QString& filePath);
+
+  /**
+   * @brief Reads and parses a pipeline file into the document of the result without creating any filter,
+   * which makes it safe to call from any thread
+   * @param filePath
+   * @return
+   */
+  static Result ReadPipeline(const QString& filePath);
+
+  /**
+   * @brief Instantiates all the filters described by a pipeline Json object on the calling thread
+   * @param root The root object of the pipeline document
+   * @param result Receives the pipeline or the error
+   */
+  static void InstantiatePipeline(const QJsonObject& root, Result& result);
+
+  /**
+   * @brief Starts loading the file in the background. The pipelineLoaded signal is emitted
+   * on the thread that owns this object when the load completes. A load that is still running
+   * is not waited for; it is superseded and its result is dropped. The destructor waits for
+   * all of them.
+   * @param filePath
+   */
+  void load(const QString& filePath);
+
+  /**
+   * @brief isLoading
+   * @return
+   */
+  bool isLoading() const;
+
+  /**
+   * @brief Formats the timings of a result as a single line for the standard output widget
+   * @param result
+   * @return
+   */
+  static QString FormatTimings(const Result& result);
+
+signals:
+  void pipelineLoaded(const PipelineLoader::Result& result);
+
+protected slots:
+  void loadFinished();
+
+private:
+  QFutureWatcher<Result>* m_Watcher = nullptr; // The latest load; the results of all others are stale
+
+  /**
+   * @brief Instantiates the filters of a document that ReadPipeline() returned and drops the document
+   */
+  static void FinishPipeline(Result& result);
+
+public:
+  PipelineLoader(const PipelineLoader&) = delete;            // Copy Constructor Not Implemented
+  PipelineLoader(PipelineLoader&&) = delete;                 // Move Constructor Not Implemented
+  PipelineLoader& operator=(const PipelineLoader&) = delete; // Copy Assignment Not Implemented
+  PipelineLoader& operator=(PipelineLoader&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,469 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineMemoryGovernor.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsCache.h"
+
+namespace
+{
+const QString k_BudgetKey("Memory Budget");
+
+// Filters commonly hold temporary copies of an array while they work on it
+const double k_WorkingSetFactor = 1.25;
+
+// The default budget leaves some of the machine for the operating system and the GUI
+const double k_DefaultBudgetFraction = 0.8;
+
+/**
+ * @brief Returns the size of one element of the array type reported by IDataArray::getTypeAsString()
+ */
+qint64 ElementSize(const QString& type)
+{
+  static const QHash<QString, qint64> sizes = {{"bool", 1},    {"int8_t", 1},   {"uint8_t", 1},  {"int16_t", 2},  {"uint16_t", 2}, {"int32_t", 4},
+                                               {"uint32_t", 4}, {"int64_t", 8}, {"uint64_t", 8}, {"float", 4},    {"double", 8}};
+  return sizes.value(type, 8);
+}
+}
+
+PipelineMemoryGovernor* PipelineMemoryGovernor::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMemoryGovernor::PipelineMemoryGovernor(QObject* parent)
+: QObject(parent)
+{
+  SettingsCache* cache = SettingsCache::Instance();
+  qint64 defaultBudget = static_cast<qint64>(PhysicalMemory() * k_DefaultBudgetFraction);
+  m_Budget = cache->value(SIMPLView::ApplicationSettings::GroupName, k_BudgetKey, QVariant(defaultBudget)).toLongLong();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMemoryGovernor::~PipelineMemoryGovernor() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMemoryGovernor* PipelineMemoryGovernor::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new PipelineMemoryGovernor();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineMemoryGovernor::EstimatePeakMemory(FilterPipeline::Pointer pipeline)
+{
+  qint64 total = DataBytes(PipelineDataFlow::PreflightedStructure(pipeline));
+  return static_cast<qint64>(total * k_WorkingSetFactor);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineMemoryGovernor::DataBytes(DataContainerArray::Pointer dca)
+{
+  qint64 bytes = 0;
+  PipelineDataFlow::VisitAttributeMatrices(dca, [&bytes](const DataArrayPath&, AttributeMatrix::Pointer am) {
+    for(const QString& arrayName : am->getAttributeArrayNames())
+    {
+      bytes += ArrayBytes(am->getAttributeArray(arrayName));
+    }
+  });
+  return bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineMemoryGovernor::ArrayBytes(IDataArray::Pointer array)
+{
+  if(nullptr == array.get())
+  {
+    return 0;
+  }
+  qint64 elements = static_cast<qint64>(array->getNumberOfTuples()) * array->getNumberOfComponents();
+  return elements * ElementSize(array->getTypeAsString());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineMemoryGovernor::PhysicalMemory()
+{
+#if defined(Q_OS_WIN)
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if(GlobalMemoryStatusEx(&status) != 0)
+  {
+    return static_cast<qint64>(status.ullTotalPhys);
+  }
+  return 0;
+#elif defined(Q_OS_UNIX) && defined(_SC_PHYS_PAGES)
+  long pages = sysconf(_SC_PHYS_PAGES);
+  long pageSize = sysconf(_SC_PAGE_SIZE);
+  if(pages > 0 && pageSize > 0)
+  {
+    return static_cast<qint64>(pages) * pageSize;
+  }
+  return 0;
+#else
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineMemoryGovernor::FormatBytes(qint64 bytes)
+{
+  const double gb = 1024.0 * 1024.0 * 1024.0;
+  const double mb = 1024.0 * 1024.0;
+  if(bytes >= gb)
+  {
+    return QString("%1 GB").arg(bytes / gb, 0, 'f', 1);
+  }
+  return QString("%1 MB").arg(bytes / mb, 0, 'f', 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineMemoryGovernor::getBudget() const
+{
+  return m_Budget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMemoryGovernor::setBudget(qint64 bytes)
+{
+  m_Budget = qMax(static_cast<qint64>(0), bytes);
+  SettingsCache::Instance()->setValue(SIMPLView::ApplicationSettings::GroupName, k_BudgetKey, QVariant(m_Budget));
+
+  // A larger budget may let queued pipelines start
+  startQueued();
+  emit stateChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineMemoryGovernor::getCommittedMemory() const
+{
+  qint64 committed = 0;
+  for(const Entry& entry : m_Entries)
+  {
+    if(entry.running)
+    {
+      committed += entry.estimate;
+    }
+  }
+  return committed;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<QPair<QString, qint64>> PipelineMemoryGovernor::getRunningPipelines() const
+{
+  QList<QPair<QString, qint64>> running;
+  for(const Entry& entry : m_Entries)
+  {
+    if(entry.running)
+    {
+      running.push_back(qMakePair(entry.name, entry.estimate));
+    }
+  }
+  return running;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineMemoryGovernor::getQueueLength() const
+{
+  return m_Queue.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMemoryGovernor::fits(qint64 bytes) const
+{
+  if(m_Budget <= 0)
+  {
+    return true;
+  }
+
+  qint64 committed = getCommittedMemory();
+  // Nothing else running: even an oversized pipeline gets to run, otherwise it would wait forever
+  return committed == 0 || committed + bytes <= m_Budget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMemoryGovernor::setEstimate(QObject* owner, const QString& name, qint64 bytes)
+{
+  Entry& entry = m_Entries[owner];
+  entry.name = name;
+
+  // The prediction of a running pipeline stays what it was admitted with
+  if(!entry.running)
+  {
+    entry.estimate = bytes;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMemoryGovernor::requestExecution(QObject* owner, const std::function<void()>& start)
+{
+  Entry& entry = m_Entries[owner];
+  if(entry.running || entry.starting || m_Queue.contains(owner))
+  {
+    return false;
+  }
+
+  if(m_Queue.isEmpty() && fits(entry.estimate))
+  {
+    entry.starting = true;
+    start();
+    // start() may have reentered the governor, so the entry is looked up again
+    Entry& started = m_Entries[owner];
+    started.starting = false;
+    return started.running;
+  }
+
+  entry.start = start;
+  m_Queue.push_back(owner);
+  emit stateChanged();
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMemoryGovernor::admits(QObject* owner) const
+{
+  if(!m_Queue.isEmpty() && m_Queue.front() != owner)
+  {
+    return false;
+  }
+  return fits(m_Entries.value(owner).estimate);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMemoryGovernor::executionStarted(QObject* owner)
+{
+  Entry& entry = m_Entries[owner];
+  if(entry.running)
+  {
+    return;
+  }
+  entry.running = true;
+  m_Queue.removeAll(owner);
+  entry.start = std::function<void()>();
+  emit stateChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMemoryGovernor::executionFinished(QObject* owner)
+{
+  QMap<QObject*, Entry>::iterator iter = m_Entries.find(owner);
+  if(iter == m_Entries.end() || !iter.value().running)
+  {
+    return;
+  }
+  iter.value().running = false;
+
+  startQueued();
+  emit stateChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMemoryGovernor::cancelRequest(QObject* owner)
+{
+  if(m_Queue.removeAll(owner) == 0)
+  {
+    return;
+  }
+  m_Entries[owner].start = std::function<void()>();
+
+  // Whatever was queued behind this pipeline may fit now
+  startQueued();
+  emit stateChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMemoryGovernor::removeOwner(QObject* owner)
+{
+  if(m_Entries.remove(owner) == 0)
+  {
+    return;
+  }
+  m_Queue.removeAll(owner);
+
+  startQueued();
+  emit stateChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineMemoryGovernor::startQueued()
+{
+  // Strictly first come, first served so that a large pipeline is not starved by a stream of small ones
+  while(!m_Queue.isEmpty())
+  {
+    QObject* owner = m_Queue.front();
+    Entry& entry = m_Entries[owner];
+    if(!fits(entry.estimate))
+    {
+      break;
+    }
+
+    // The next one is only looked at once this one has either started or failed to
+    m_Queue.pop_front();
+    std::function<void()> start = entry.start;
+    entry.start = std::function<void()>();
+    if(start)
+    {
+      m_Entries[owner].starting = true;
+      start();
+      m_Entries[owner].starting = false;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMemoryGovernor::isWaiting(QObject* owner) const
+{
+  return m_Queue.contains(owner);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineMemoryGovernor::waitingReason(QObject* owner) const
+{
+  int position = m_Queue.indexOf(owner);
+  if(position < 0)
+  {
+    return QString();
+  }
+
+  qint64 estimate = m_Entries.value(owner).estimate;
+  QString reason = tr("Waiting for memory: this pipeline needs %1, %2 of the %3 budget are in use")
+                       .arg(FormatBytes(estimate))
+                       .arg(FormatBytes(getCommittedMemory()))
+                       .arg(FormatBytes(m_Budget));
+  if(position > 0)
+  {
+    reason.append(tr(" (%1 ahead in the queue)").arg(position));
+  }
+  return reason;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineMemoryGovernor::statusReport() const
+{
+  QStringList lines;
+  lines << tr("Budget: %1").arg(m_Budget > 0 ? FormatBytes(m_Budget) : tr("unlimited"));
+  lines << tr("In use by running pipelines: %1").arg(FormatBytes(getCommittedMemory()));
+
+  lines << QString() << tr("Running:");
+  int running = 0;
+  for(QMap<QObject*, Entry>::const_iterator iter = m_Entries.constBegin(); iter != m_Entries.constEnd(); ++iter)
+  {
+    if(iter.value().running)
+    {
+      lines << QString("    %1 (%2)").arg(iter.value().name).arg(FormatBytes(iter.value().estimate));
+      running++;
+    }
+  }
+  if(running == 0)
+  {
+    lines << tr("    None");
+  }
+
+  lines << QString() << tr("Waiting for memory:");
+  for(QObject* owner : m_Queue)
+  {
+    const Entry entry = m_Entries.value(owner);
+    lines << QString("    %1 (%2)").arg(entry.name).arg(FormatBytes(entry.estimate));
+  }
+  if(m_Queue.isEmpty())
+  {
+    lines << tr("    None");
+  }
+
+  return lines.join("\n");
+}
@@ -0,0 +1,243 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The PipelineMemoryGovernor class keeps the combined memory of all the pipelines that run in the
+ * application under a budget. Each window reports the peak memory its pipeline is predicted to need after
+ * every preflight and asks the governor for permission before it executes. A pipeline is admitted when
+ * its prediction fits into what is left of the budget; otherwise it waits in a first come, first served
+ * queue until enough running pipelines have finished. A pipeline that is larger than the whole budget is
+ * still admitted once nothing else is running.
+ *
+ * The governor is only used from the GUI thread.
+ */
+class PipelineMemoryGovernor : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~PipelineMemoryGovernor() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static PipelineMemoryGovernor* Instance();
+
+  /**
+   * @brief Predicts the peak memory of a pipeline from the data structure that its last preflight produced.
+   * Preflight creates every array with its final tuple and component counts without allocating it, so the
+   * sum of the array sizes is what the pipeline holds at the end of a run.
+   * @param pipeline A pipeline that has been preflighted
+   * @return The prediction in bytes
+   */
+  static qint64 EstimatePeakMemory(FilterPipeline::Pointer pipeline);
+
+  /**
+   * @brief Returns the bytes that an array holds once it is allocated
+   * @param array
+   * @return
+   */
+  static qint64 ArrayBytes(IDataArray::Pointer array);
+
+  /**
+   * @brief Returns the bytes that all the arrays of a data structure hold once they are allocated
+   * @param dca May be a null pointer
+   * @return
+   */
+  static qint64 DataBytes(DataContainerArray::Pointer dca);
+
+  /**
+   * @brief Returns the amount of physical memory in bytes, or 0 if it cannot be determined
+   * @return
+   */
+  static qint64 PhysicalMemory();
+
+  /**
+   * @brief Formats a byte count for display
+   * @param bytes
+   * @return
+   */
+  static QString FormatBytes(qint64 bytes);
+
+  /**
+   * @brief Returns the budget in bytes. Zero means that executions are never held back.
+   * @return
+   */
+  qint64 getBudget() const;
+
+  /**
+   * @brief Sets and stores the budget in bytes
+   * @param bytes
+   */
+  void setBudget(qint64 bytes);
+
+  /**
+   * @brief Returns the predicted memory of all running pipelines
+   * @return
+   */
+  qint64 getCommittedMemory() const;
+
+  /**
+   * @brief Returns the name and the predicted memory of every running pipeline
+   * @return
+   */
+  QList<QPair<QString, qint64>> getRunningPipelines() const;
+
+  /**
+   * @brief Returns the number of pipelines waiting for memory
+   * @return
+   */
+  int getQueueLength() const;
+
+  /**
+   * @brief Records the latest prediction for the pipeline that belongs to owner
+   * @param owner
+   * @param name A name for the pipeline that is shown to the user
+   * @param bytes
+   */
+  void setEstimate(QObject* owner, const QString& name, qint64 bytes);
+
+  /**
+   * @brief Runs start now if the pipeline fits into the budget, otherwise queues it until it does. Nothing is
+   * reserved until start reports the run through executionStarted(), so a start that fails, for example on a
+   * preflight error, leaves the budget and the queue as they were.
+   * @param owner
+   * @param start
+   * @return True if the pipeline was started immediately
+   */
+  bool requestExecution(QObject* owner, const std::function<void()>& start);
+
+  /**
+   * @brief Returns whether a run of owner that has started on its own may go on: nothing is waiting ahead of it
+   * and it fits into the budget
+   * @param owner
+   * @return
+   */
+  bool admits(QObject* owner) const;
+
+  /**
+   * @brief Records that the pipeline of owner is running so that its memory is counted, whether or not it was
+   * started through requestExecution()
+   * @param owner
+   */
+  void executionStarted(QObject* owner);
+
+  /**
+   * @brief Releases the memory of a finished pipeline and starts whatever now fits
+   * @param owner
+   */
+  void executionFinished(QObject* owner);
+
+  /**
+   * @brief Takes a queued execution of owner off the queue without running it
+   * @param owner
+   */
+  void cancelRequest(QObject* owner);
+
+  /**
+   * @brief Forgets everything about owner, including a queued execution
+   * @param owner
+   */
+  void removeOwner(QObject* owner);
+
+  /**
+   * @brief isWaiting
+   * @param owner
+   * @return
+   */
+  bool isWaiting(QObject* owner) const;
+
+  /**
+   * @brief Describes why owner is waiting, or returns an empty string if it is not
+   * @param owner
+   * @return
+   */
+  QString waitingReason(QObject* owner) const;
+
+  /**
+   * @brief Returns a multi line summary of the running and waiting pipelines
+   * @return
+   */
+  QString statusReport() const;
+
+signals:
+  /**
+   * @brief Emitted whenever a pipeline starts, finishes, or joins or leaves the queue
+   */
+  void stateChanged();
+
+protected:
+  PipelineMemoryGovernor(QObject* parent = nullptr);
+
+private:
+  static PipelineMemoryGovernor* self;
+
+  struct Entry
+  {
+    QString name;
+    qint64 estimate = 0;
+    bool running = false;
+    bool starting = false;
+    std::function<void()> start;
+  };
+
+  QMap<QObject*, Entry> m_Entries;
+  QList<QObject*> m_Queue;
+  qint64 m_Budget = 0;
+
+  bool fits(qint64 bytes) const;
+  void startQueued();
+
+public:
+  PipelineMemoryGovernor(const PipelineMemoryGovernor&) = delete;            // Copy Constructor Not Implemented
+  PipelineMemoryGovernor(PipelineMemoryGovernor&&) = delete;                 // Move Constructor Not Implemented
+  PipelineMemoryGovernor& operator=(const PipelineMemoryGovernor&) = delete; // Copy Assignment Not Implemented
+  PipelineMemoryGovernor& operator=(PipelineMemoryGovernor&&) = delete;      // Move Assignment Not Implemented
+};
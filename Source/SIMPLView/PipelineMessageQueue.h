@@ -0,0 +1,122 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+
+/**
+ * @brief The PipelineMessageQueue class collects the pipeline messages the pipeline view hands the window so
+ * that they can be shown in batches. It lives on the GUI thread and is not thread safe.
+ *
+ * A progress update replaces the one queued right before it when both come from the same filter, since only
+ * the latest value is ever shown. Every other message is kept, in order. Each message carries the time it was
+ * received, so that what is timed from the messages does not depend on when the batch is handled.
+ */
+class PipelineMessageQueue
+{
+public:
+  PipelineMessageQueue();
+  ~PipelineMessageQueue();
+
+  /**
+   * @brief A queued message and when it was received, in SVTrace::Now() nanoseconds
+   */
+  struct Entry
+  {
+    PipelineMessage message;
+    qint64 received = 0;
+  };
+
+  /**
+   * @brief The counters of a queue since the last resetStatistics()
+   */
+  struct Statistics
+  {
+    qint64 pushed = 0;
+    qint64 coalescedProgress = 0;
+    int highWaterMark = 0;
+  };
+
+  /**
+   * @brief Adds a message
+   * @param msg
+   * @param received
+   */
+  void push(const PipelineMessage& msg, qint64 received);
+
+  /**
+   * @brief Moves all queued messages into messages, oldest first
+   * @param messages
+   * @return The number of messages appended
+   */
+  int drain(QVector<Entry>& messages);
+
+  /**
+   * @brief isEmpty
+   * @return
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Returns a copy of the counters
+   * @return
+   */
+  Statistics statistics() const;
+
+  /**
+   * @brief Resets the counters, usually when a new execution starts
+   */
+  void resetStatistics();
+
+  /**
+   * @brief Returns true if the message only carries a progress value
+   * @param msg
+   * @return
+   */
+  static bool IsProgressOnly(const PipelineMessage& msg);
+
+private:
+  QVector<Entry> m_Messages;
+  Statistics m_Statistics;
+
+public:
+  PipelineMessageQueue(const PipelineMessageQueue&) = delete;            // Copy Constructor Not Implemented
+  PipelineMessageQueue(PipelineMessageQueue&&) = delete;                 // Move Constructor Not Implemented
+  PipelineMessageQueue& operator=(const PipelineMessageQueue&) = delete; // Copy Assignment Not Implemented
+  PipelineMessageQueue& operator=(PipelineMessageQueue&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,160 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelinePreview.h"
+
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelinePreview::Reduce(DataContainerArray::Pointer dca, const Settings& settings, QString* errorMessage)
+{
+  const size_t factor = static_cast<size_t>(qMax(1, settings.factor));
+  int reduced = 0;
+
+  for(const QString& dcName : dca->getDataContainerNames())
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    ImageGeom::Pointer geom = (nullptr != dc.get()) ? dc->getGeometryAs<ImageGeom>() : ImageGeom::NullPointer();
+    if(nullptr == geom.get())
+    {
+      continue;
+    }
+
+    size_t dims[3] = {0, 0, 0};
+    geom->getDimensions(dims[0], dims[1], dims[2]);
+    size_t voxels = dims[0] * dims[1] * dims[2];
+    if(voxels == 0)
+    {
+      continue;
+    }
+
+    // The voxels that are kept along each axis
+    QVector<size_t> kept[3];
+    for(int axis = 0; axis < 3; axis++)
+    {
+      size_t first = qMin(static_cast<size_t>(qMax(0, settings.minimum[axis])), dims[axis] - 1);
+      size_t last = (settings.maximum[axis] < 0) ? dims[axis] - 1 : qBound(first, static_cast<size_t>(settings.maximum[axis]), dims[axis] - 1);
+      for(size_t i = first; i <= last; i += factor)
+      {
+        kept[axis].push_back(i);
+      }
+    }
+    QVector<size_t> newDims = {static_cast<size_t>(kept[0].size()), static_cast<size_t>(kept[1].size()), static_cast<size_t>(kept[2].size())};
+    if(newDims[0] * newDims[1] * newDims[2] == voxels)
+    {
+      continue;
+    }
+
+    for(const QString& amName : dc->getAttributeMatrixNames())
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      if(nullptr == am.get() || am->getNumberOfTuples() != voxels)
+      {
+        continue;
+      }
+
+      // Kept voxels only ever move towards the front, so each array is compacted in place before it is shrunk
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        IDataArray::Pointer array = am->getAttributeArray(arrayName);
+        size_t next = 0;
+        for(size_t z : kept[2])
+        {
+          for(size_t y : kept[1])
+          {
+            for(size_t x : kept[0])
+            {
+              array->copyTuple((z * dims[1] + y) * dims[0] + x, next++);
+            }
+          }
+        }
+      }
+      am->resizeAttributeArrays(newDims);
+    }
+
+    float resolution[3] = {0.0f, 0.0f, 0.0f};
+    float origin[3] = {0.0f, 0.0f, 0.0f};
+    geom->getResolution(resolution[0], resolution[1], resolution[2]);
+    geom->getOrigin(origin[0], origin[1], origin[2]);
+    geom->setOrigin(origin[0] + kept[0][0] * resolution[0], origin[1] + kept[1][0] * resolution[1], origin[2] + kept[2][0] * resolution[2]);
+    // A flat axis keeps its single voxel and its spacing
+    float scale[3] = {0.0f, 0.0f, 0.0f};
+    for(int axis = 0; axis < 3; axis++)
+    {
+      scale[axis] = (dims[axis] > 1) ? static_cast<float>(factor) : 1.0f;
+    }
+    geom->setResolution(resolution[0] * scale[0], resolution[1] * scale[1], resolution[2] * scale[2]);
+    geom->setDimensions(newDims[0], newDims[1], newDims[2]);
+    reduced++;
+  }
+
+  if(reduced == 0 && nullptr != errorMessage)
+  {
+    *errorMessage = QObject::tr("The readers did not create an image geometry that the preview could reduce");
+  }
+  return reduced > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelinePreview::Describe(const Settings& settings)
+{
+  QStringList parts;
+  if(settings.factor > 1)
+  {
+    parts << QObject::tr("1/%1 resolution").arg(settings.factor);
+  }
+  if(settings.isCropped())
+  {
+    const char* axes[3] = {"x", "y", "z"};
+    QStringList ranges;
+    for(int axis = 0; axis < 3; axis++)
+    {
+      QString last = (settings.maximum[axis] < 0) ? QObject::tr("end") : QString::number(settings.maximum[axis]);
+      ranges << QString("%1 %2-%3").arg(axes[axis]).arg(settings.minimum[axis]).arg(last);
+    }
+    parts << ranges.join(", ");
+  }
+  return parts.isEmpty() ? QObject::tr("full resolution") : parts.join(QObject::tr(" of "));
+}
@@ -0,0 +1,87 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QString>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+/**
+ * @brief The PipelinePreview class shrinks the image geometries of a data structure so that the rest of a
+ * pipeline can run on a fraction of the data while parameters are tuned. Every image data container is cropped
+ * to a region of interest and then downsampled by keeping every n-th voxel along each axis. The cell attribute
+ * matrices, that is those with one tuple per voxel, are shrunk with it; everything else is left alone.
+ */
+class PipelinePreview
+{
+public:
+  /**
+   * @brief The region of interest in voxels and the downsampling factor. A negative maximum means the
+   * end of the axis.
+   */
+  struct Settings
+  {
+    int factor = 4;
+    int minimum[3] = {0, 0, 0};
+    int maximum[3] = {-1, -1, -1};
+
+    bool isCropped() const
+    {
+      return minimum[0] > 0 || minimum[1] > 0 || minimum[2] > 0 || maximum[0] >= 0 || maximum[1] >= 0 || maximum[2] >= 0;
+    }
+
+    bool isReduced() const
+    {
+      return factor > 1 || isCropped();
+    }
+  };
+
+  /**
+   * @brief Crops and downsamples every image geometry of dca in place
+   * @param dca
+   * @param settings
+   * @param errorMessage
+   * @return False if there was no image geometry to reduce
+   */
+  static bool Reduce(DataContainerArray::Pointer dca, const Settings& settings, QString* errorMessage = nullptr);
+
+  /**
+   * @brief Describes the settings in a few words, for example "1/4 resolution of x 0-511"
+   * @param settings
+   * @return
+   */
+  static QString Describe(const Settings& settings);
+};
@@ -0,0 +1,592 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineSliceRunner.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutexLocker>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/TraceRecorder.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSliceRunner::PipelineSliceRunner(QObject* parent)
+: QObject(parent)
+, m_Cancel(false)
+{
+  connect(&m_Watcher, &QFutureWatcher<Result>::finished, this, &PipelineSliceRunner::computeFinished);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSliceRunner::~PipelineSliceRunner()
+{
+  cancel();
+  m_Watcher.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineSliceRunner::Fingerprint(AbstractFilter::Pointer filter)
+{
+  QJsonObject parameters;
+  filter->writeFilterParameters(parameters);
+  return filter->getNameOfClass() + QJsonDocument(parameters).toJson(QJsonDocument::Compact);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSliceRunner::compute(FilterPipeline::Pointer pipeline, const DataArrayPath& target)
+{
+  if(isRunning() || nullptr == pipeline.get())
+  {
+    return false;
+  }
+
+  QVector<int> slice = PipelineDataFlow::Slice(pipeline, target);
+  if(slice.isEmpty())
+  {
+    return false;
+  }
+
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  QStringList fingerprints;
+  for(int index : slice)
+  {
+    fingerprints.push_back(Fingerprint(filters[index]));
+  }
+
+  Job job;
+  job.result.target = target;
+  job.result.filtersInPipeline = filters.size();
+  job.fingerprints = fingerprints;
+
+  // Reuse the kept data structure if it is where this slice would be after some of its filters
+  int reused = 0;
+  if(nullptr != m_CachedState.get() && fingerprints.mid(0, m_CachedFingerprints.size()) == m_CachedFingerprints)
+  {
+    reused = m_CachedFingerprints.size();
+  }
+  else if(nullptr != m_CachedState.get() && m_CachedFingerprints.mid(0, fingerprints.size()) == fingerprints)
+  {
+    reused = fingerprints.size();
+    job.fingerprints = m_CachedFingerprints;
+  }
+  job.dca = (reused > 0) ? m_CachedState : DataContainerArray::New();
+  job.result.filtersReused = reused;
+
+  // Copies, so that neither the pipeline view nor a preflight sees what the computation does
+  for(int i = reused; i < slice.size(); i++)
+  {
+    job.filters.push_back(filters[slice[i]]->newFilterInstance(true));
+  }
+
+  // The kept state is being changed from here on; it comes back if the computation succeeds
+  m_CachedState = DataContainerArray::NullPointer();
+  m_CachedFingerprints.clear();
+  m_RunningState = job.dca;
+  m_RunningFingerprints = job.fingerprints;
+
+  start(job);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSliceRunner::preview(FilterPipeline::Pointer pipeline, const PipelinePreview::Settings& settings)
+{
+  if(isRunning() || nullptr == pipeline.get())
+  {
+    return false;
+  }
+
+  Job job;
+  job.result.preview = true;
+  job.result.filtersInPipeline = pipeline->size();
+  job.dca = DataContainerArray::New();
+  job.reduction = settings;
+
+  // Writers are left out so that a preview never overwrites the results of a full run
+  for(AbstractFilter::Pointer filter : pipeline->getFilterContainer())
+  {
+    if(!filter->getEnabled() || PipelineDataFlow::IsOutputFilter(filter))
+    {
+      continue;
+    }
+    bool reader = (filter->getSubGroupName() == SIMPL::FilterSubGroups::InputFilters);
+    if(!reader && job.reduceBefore < 0)
+    {
+      job.reduceBefore = job.filters.size();
+    }
+    job.filters.push_back(filter->newFilterInstance(true));
+  }
+
+  if(job.filters.isEmpty() || job.reduceBefore == 0)
+  {
+    return false;
+  }
+  if(job.reduceBefore < 0)
+  {
+    job.reduceBefore = job.filters.size();
+  }
+  if(!settings.isReduced())
+  {
+    job.reduceBefore = -1;
+  }
+
+  start(job);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSliceRunner::scrub(FilterPipeline::Pointer pipeline, int index, const QString& propertyName, const QVariant& value, const PipelinePreview::Settings& settings)
+{
+  if(nullptr == pipeline.get())
+  {
+    return false;
+  }
+  if(isRunning())
+  {
+    // Only the latest value matters; anything that was waiting before it is dropped
+    cancel();
+    m_PendingScrub.pipeline = pipeline;
+    m_PendingScrub.index = index;
+    m_PendingScrub.propertyName = propertyName;
+    m_PendingScrub.value = value;
+    m_PendingScrub.settings = settings;
+    return true;
+  }
+
+  Job job;
+  job.result.scrub = true;
+  job.reduction = settings;
+  job.editedIndex = index;
+  job.propertyName = propertyName;
+  job.value = value;
+  return startIncremental(pipeline, PipelineDataFlow::Dependents(pipeline, index), job);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSliceRunner::rerun(FilterPipeline::Pointer pipeline, const QVector<int>& changed)
+{
+  if(nullptr == pipeline.get() || isRunning())
+  {
+    return false;
+  }
+
+  // The writers after a changed filter run too, so that its files are brought up to date
+  QVector<int> filters;
+  for(int index : changed)
+  {
+    for(int i : PipelineDataFlow::Dependents(pipeline, index, true))
+    {
+      if(!filters.contains(i))
+      {
+        filters.push_back(i);
+      }
+    }
+  }
+  std::sort(filters.begin(), filters.end());
+
+  Job job;
+  job.result.rerun = true;
+  job.reduction.factor = 1;
+  return startIncremental(pipeline, filters, job);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSliceRunner::startIncremental(FilterPipeline::Pointer pipeline, const QVector<int>& rerun, Job job)
+{
+  if(rerun.isEmpty())
+  {
+    return false;
+  }
+  job.incremental = true;
+  job.result.filtersInPipeline = pipeline->size();
+
+  // Everything else runs first, in pipeline order, and stays the same from one run to the next
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  QVector<PipelineDataFlow::FilterAccess> access = PipelineDataFlow::Analyze(pipeline);
+  QStringList upstreamFingerprints;
+  for(int i = 0; i < filters.size(); i++)
+  {
+    AbstractFilter::Pointer filter = filters[i];
+    if(rerun.contains(i))
+    {
+      job.touched.readsEverything = job.touched.readsEverything || access[i].readsEverything;
+      job.touched.reads += access[i].reads;
+      job.touched.readNames += access[i].readNames;
+      AbstractFilter::Pointer copy = filter->newFilterInstance(true);
+      if(i == job.editedIndex)
+      {
+        copy->setProperty(job.propertyName.toLatin1().constData(), job.value);
+      }
+      job.filters.push_back(copy);
+      continue;
+    }
+    if(!filter->getEnabled() || PipelineDataFlow::IsOutputFilter(filter))
+    {
+      continue;
+    }
+
+    if(filter->getSubGroupName() != SIMPL::FilterSubGroups::InputFilters && job.reduceBefore < 0)
+    {
+      job.reduceBefore = job.upstream.size();
+    }
+    job.upstream.push_back(filter->newFilterInstance(true));
+    upstreamFingerprints.push_back(Fingerprint(filter));
+  }
+  if(job.reduceBefore < 0)
+  {
+    job.reduceBefore = job.upstream.size();
+  }
+  if(!job.reduction.isReduced())
+  {
+    job.reduceBefore = -1;
+  }
+
+  QString key = upstreamFingerprints.join("\n") + PipelinePreview::Describe(job.reduction);
+  if(key == m_BaseKey && nullptr != m_Base.get())
+  {
+    job.dca = m_Base;
+    job.result.filtersReused = job.upstream.size();
+  }
+  else
+  {
+    m_Base = DataContainerArray::NullPointer();
+    m_BaseKey.clear();
+  }
+  m_RunningBaseKey = key;
+
+  start(job);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSliceRunner::start(const Job& job)
+{
+  m_Cancel = false;
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_LastError.clear();
+  }
+  m_Watcher.setFuture(QtConcurrent::run([this, job] { return run(job); }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSliceRunner::isRunning() const
+{
+  return m_Watcher.isRunning();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSliceRunner::cancel()
+{
+  m_PendingScrub = ScrubRequest();
+  m_Cancel = true;
+  QMutexLocker locker(&m_Mutex);
+  if(nullptr != m_CurrentFilter.get())
+  {
+    m_CurrentFilter->setCancel(true);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSliceRunner::clearCache()
+{
+  m_CachedState = DataContainerArray::NullPointer();
+  m_CachedFingerprints.clear();
+  m_Base = DataContainerArray::NullPointer();
+  m_BaseKey.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSliceRunner::Result PipelineSliceRunner::run(const Job& job)
+{
+  SV_TRACE_SCOPE_CATEGORY("Run Pipeline Slice", "execute");
+
+  Result result = job.result;
+  QElapsedTimer timer;
+  timer.start();
+
+  if(job.incremental)
+  {
+    // The filters that do not depend on the changed ones run once; every later run starts from their result
+    result.base = job.dca;
+    if(nullptr == result.base.get())
+    {
+      result.base = DataContainerArray::New();
+      if(!execute(job.upstream, result.base, job.reduceBefore, job.reduction, result))
+      {
+        result.base = DataContainerArray::NullPointer();
+        result.milliseconds = timer.elapsed();
+        return result;
+      }
+    }
+    result.dca = Snapshot(result.base, job.touched);
+    execute(job.filters, result.dca, -1, job.reduction, result);
+  }
+  else if(execute(job.filters, job.dca, job.reduceBefore, job.reduction, result))
+  {
+    if(result.preview)
+    {
+      result.dca = job.dca;
+    }
+    else
+    {
+      AttributeMatrix::Pointer am = job.dca->getAttributeMatrix(result.target);
+      result.array = (nullptr != am.get()) ? am->getAttributeArray(result.target.getDataArrayName()) : IDataArray::NullPointer();
+      if(nullptr == result.array.get())
+      {
+        result.err = -1;
+        result.errorMessage = tr("The filters ran but did not create %1").arg(result.target.serialize("/"));
+      }
+    }
+  }
+
+  result.milliseconds = timer.elapsed();
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSliceRunner::execute(const QVector<AbstractFilter::Pointer>& filters, DataContainerArray::Pointer dca, int reduceBefore, const PipelinePreview::Settings& reduction, Result& result)
+{
+  for(int i = 0; i <= filters.size(); i++)
+  {
+    if(m_Cancel)
+    {
+      result.canceled = true;
+      break;
+    }
+    if(i == reduceBefore && !PipelinePreview::Reduce(dca, reduction, &result.errorMessage))
+    {
+      result.err = -2;
+      break;
+    }
+    if(i == filters.size())
+    {
+      break;
+    }
+
+    AbstractFilter::Pointer filter = filters[i];
+    {
+      QMutexLocker locker(&m_Mutex);
+      m_CurrentFilter = filter;
+    }
+
+    emit progress(i, filters.size(), filter->getHumanLabel());
+    connect(filter.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(filterMessage(const PipelineMessage&)), Qt::DirectConnection);
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    result.filtersRun++;
+
+    if(filter->getCancel())
+    {
+      result.canceled = true;
+      break;
+    }
+    if(filter->getErrorCondition() < 0)
+    {
+      QMutexLocker locker(&m_Mutex);
+      result.err = filter->getErrorCondition();
+      result.errorMessage = tr("%1 failed with error %2").arg(filter->getHumanLabel()).arg(result.err);
+      if(!m_LastError.isEmpty())
+      {
+        result.errorMessage += ": " + m_LastError;
+      }
+      break;
+    }
+  }
+
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_CurrentFilter = AbstractFilter::NullPointer();
+  }
+  return result.err >= 0 && !result.canceled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer PipelineSliceRunner::CopyState(DataContainerArray::Pointer dca)
+{
+  DataContainerArray::Pointer copy = DataContainerArray::New();
+  for(const QString& dcName : dca->getDataContainerNames())
+  {
+    copy->addDataContainer(dca->getDataContainer(dcName)->deepCopy(false));
+  }
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer PipelineSliceRunner::Snapshot(DataContainerArray::Pointer dca, const PipelineDataFlow::FilterAccess& touched)
+{
+  if(touched.readsEverything)
+  {
+    return CopyState(dca);
+  }
+
+  // Filters add and remove arrays freely, which only changes the new containers, but they may also resize or write
+  // the arrays they read. Those are copied with the attribute matrix they live in, the rest is shared.
+  DataContainerArray::Pointer copy = DataContainerArray::New();
+  for(const QString& dcName : dca->getDataContainerNames())
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    bool wholeContainer = touched.readNames.contains(dcName);
+    for(const DataArrayPath& path : touched.reads)
+    {
+      wholeContainer = wholeContainer || (path.getDataContainerName() == dcName && path.getAttributeMatrixName().isEmpty());
+    }
+    if(wholeContainer)
+    {
+      copy->addDataContainer(dc->deepCopy(false));
+      continue;
+    }
+
+    DataContainer::Pointer dcCopy = DataContainer::New(dcName);
+    if(nullptr != dc->getGeometry().get())
+    {
+      dcCopy->setGeometry(dc->getGeometry()->deepCopy(false));
+    }
+    for(const QString& amName : dc->getAttributeMatrixNames())
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      QList<QString> arrayNames = am->getAttributeArrayNames();
+      bool read = touched.readNames.contains(amName);
+      for(const DataArrayPath& path : touched.reads)
+      {
+        read = read || (path.getDataContainerName() == dcName && path.getAttributeMatrixName() == amName);
+      }
+      for(const QString& arrayName : arrayNames)
+      {
+        read = read || touched.readNames.contains(arrayName);
+      }
+      if(read)
+      {
+        dcCopy->addAttributeMatrix(amName, am->deepCopy(false));
+        continue;
+      }
+
+      AttributeMatrix::Pointer amCopy = AttributeMatrix::New(am->getTupleDimensions(), amName, am->getType());
+      for(const QString& arrayName : arrayNames)
+      {
+        amCopy->addAttributeArray(arrayName, am->getAttributeArray(arrayName));
+      }
+      dcCopy->addAttributeMatrix(amName, amCopy);
+    }
+    copy->addDataContainer(dcCopy);
+  }
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSliceRunner::filterMessage(const PipelineMessage& msg)
+{
+  if(msg.getType() == PipelineMessage::MessageType::Error)
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_LastError = msg.getText();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSliceRunner::computeFinished()
+{
+  Result result = m_Watcher.result();
+
+  // A data structure that a failed or canceled computation left half done cannot be trusted
+  if(result.err >= 0 && !result.canceled && !result.preview && !result.scrub && !result.rerun)
+  {
+    m_CachedState = m_RunningState;
+    m_CachedFingerprints = m_RunningFingerprints;
+  }
+  m_RunningState = DataContainerArray::NullPointer();
+  m_RunningFingerprints.clear();
+
+  // The base of a scrub or rerun is only there if all the filters it consists of ran
+  if(nullptr != result.base.get())
+  {
+    m_Base = result.base;
+    m_BaseKey = m_RunningBaseKey;
+  }
+
+  emit finished(result);
+
+  if(nullptr != m_PendingScrub.pipeline.get())
+  {
+    ScrubRequest request = m_PendingScrub;
+    m_PendingScrub = ScrubRequest();
+    scrub(request.pipeline, request.index, request.propertyName, request.value, request.settings);
+  }
+}
@@ -0,0 +1,241 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/PipelineMessage.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/PipelinePreview.h"
+
+/**
+ * @brief The PipelineSliceRunner class computes a single array of a pipeline without running the rest of it.
+ * PipelineDataFlow::Slice() picks the filters the array depends on and copies of those filters execute on a
+ * worker thread against a data structure of their own, so the pipeline in the window is never touched.
+ *
+ * The data structure of the last successful computation is kept. When the filters it ran, with the same
+ * parameters, start the next slice, only the rest of that slice runs on top of it; when the next slice starts
+ * the filters it ran, nothing runs at all. Changes to input files are not noticed, see clearCache().
+ *
+ * The same machinery runs previews: every enabled filter except the writers, with the image geometries reduced
+ * by PipelinePreview right after the readers. Previews neither use nor fill the kept data structure.
+ *
+ * Scrubbing a parameter runs only the edited filter and its dependents, see PipelineDataFlow::Dependents(), on top
+ * of the data structure that all the other filters produce. That data structure is kept while the same filter is
+ * scrubbed, and a new value cancels the run for the previous one. Each run copies only the attribute matrices its
+ * filters read, since those may be changed in place; every other array is shared with the kept data structure.
+ * Rerunning after input files changed works the same way for the readers of those files, on the full data and
+ * with the writers after them.
+ */
+class PipelineSliceRunner : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineSliceRunner(QObject* parent = nullptr);
+  ~PipelineSliceRunner() override;
+
+  /**
+   * @brief The outcome of one computation. When err is negative the array is null and errorMessage
+   * describes the problem.
+   */
+  struct Result
+  {
+    DataArrayPath target;
+    IDataArray::Pointer array;
+    int filtersRun = 0;
+    int filtersReused = 0;
+    int filtersInPipeline = 0;
+    qint64 milliseconds = 0;
+    bool canceled = false;
+    int err = 0;
+    QString errorMessage;
+    bool preview = false;
+    bool scrub = false;
+    bool rerun = false;
+    DataContainerArray::Pointer dca;  // The whole data structure of a preview, scrub or rerun
+    DataContainerArray::Pointer base; // What a scrub or rerun started from
+  };
+
+  /**
+   * @brief Starts computing target in the background. The finished signal is emitted on the thread that owns
+   * this object when it is done.
+   * @param pipeline A pipeline that has been preflighted
+   * @param target
+   * @return False if a computation is already running or no filter creates target
+   */
+  bool compute(FilterPipeline::Pointer pipeline, const DataArrayPath& target);
+
+  /**
+   * @brief Starts a preview of the pipeline in the background
+   * @param pipeline
+   * @param settings How to reduce the image geometries after the readers
+   * @return False if a computation is already running or the pipeline does not start with a reader
+   */
+  bool preview(FilterPipeline::Pointer pipeline, const PipelinePreview::Settings& settings);
+
+  /**
+   * @brief Runs the filter at index with one parameter changed, and the filters that depend on it, on the
+   * reduced data. If a run is in flight it is canceled and this one starts when it has stopped.
+   * @param pipeline A pipeline that has been preflighted
+   * @param index
+   * @param propertyName
+   * @param value
+   * @param settings
+   * @return False if the filter is not enabled or the pipeline does not start with a reader
+   */
+  bool scrub(FilterPipeline::Pointer pipeline, int index, const QString& propertyName, const QVariant& value, const PipelinePreview::Settings& settings);
+
+  /**
+   * @brief Runs the filters at changed, usually readers whose files changed, and everything that depends on them
+   * including the writers, on the full data
+   * @param pipeline A pipeline that has been preflighted
+   * @param changed
+   * @return False if a computation is already running or none of the filters is enabled
+   */
+  bool rerun(FilterPipeline::Pointer pipeline, const QVector<int>& changed);
+
+  /**
+   * @brief isRunning
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief Asks the running computation to stop after the current filter and drops a waiting scrub
+   */
+  void cancel();
+
+  /**
+   * @brief Forgets the kept data structures
+   */
+  void clearCache();
+
+signals:
+  /**
+   * @brief Emitted from the worker thread before each filter runs
+   * @param done
+   * @param count
+   * @param humanLabel
+   */
+  void progress(int done, int count, const QString& humanLabel);
+
+  void finished(const PipelineSliceRunner::Result& result);
+
+protected slots:
+  void computeFinished();
+
+  /**
+   * @brief Runs on the worker thread and keeps the last error a filter reported
+   * @param msg
+   */
+  void filterMessage(const PipelineMessage& msg);
+
+private:
+  /**
+   * @brief What one computation runs and on which data structure
+   */
+  struct Job
+  {
+    Result result;
+    QVector<AbstractFilter::Pointer> filters;
+    QStringList fingerprints;
+    DataContainerArray::Pointer dca;
+    int reduceBefore = -1;
+    PipelinePreview::Settings reduction;
+    bool incremental = false;
+    QVector<AbstractFilter::Pointer> upstream; // What an incremental run runs first if it has no base
+    PipelineDataFlow::FilterAccess touched;    // What the filters of an incremental run read
+    int editedIndex = -1;
+    QString propertyName;
+    QVariant value;
+  };
+
+  /**
+   * @brief A scrub that waits for the canceled run before it
+   */
+  struct ScrubRequest
+  {
+    FilterPipeline::Pointer pipeline;
+    int index = -1;
+    QString propertyName;
+    QVariant value;
+    PipelinePreview::Settings settings;
+  };
+
+  QFutureWatcher<Result> m_Watcher;
+  std::atomic<bool> m_Cancel;
+  QMutex m_Mutex;
+  AbstractFilter::Pointer m_CurrentFilter;
+  QString m_LastError;
+
+  QStringList m_CachedFingerprints;
+  DataContainerArray::Pointer m_CachedState;
+  QStringList m_RunningFingerprints;
+  DataContainerArray::Pointer m_RunningState;
+
+  QString m_BaseKey;
+  QString m_RunningBaseKey;
+  DataContainerArray::Pointer m_Base;
+  ScrubRequest m_PendingScrub;
+
+  static QString Fingerprint(AbstractFilter::Pointer filter);
+  static DataContainerArray::Pointer CopyState(DataContainerArray::Pointer dca);
+  static DataContainerArray::Pointer Snapshot(DataContainerArray::Pointer dca, const PipelineDataFlow::FilterAccess& touched);
+  bool startIncremental(FilterPipeline::Pointer pipeline, const QVector<int>& rerun, Job job);
+  void start(const Job& job);
+  Result run(const Job& job);
+  bool execute(const QVector<AbstractFilter::Pointer>& filters, DataContainerArray::Pointer dca, int reduceBefore, const PipelinePreview::Settings& reduction, Result& result);
+
+public:
+  PipelineSliceRunner(const PipelineSliceRunner&) = delete;            // Copy Constructor Not Implemented
+  PipelineSliceRunner(PipelineSliceRunner&&) = delete;                 // Move Constructor Not Implemented
+  PipelineSliceRunner& operator=(const PipelineSliceRunner&) = delete; // Copy Assignment Not Implemented
+  PipelineSliceRunner& operator=(PipelineSliceRunner&&) = delete;      // Move Assignment Not Implemented
+};
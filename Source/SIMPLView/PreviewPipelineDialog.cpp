@@ -0,0 +1,106 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PreviewPipelineDialog.h"
+
+#include <limits>
+
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QGridLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QSpinBox>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PreviewPipelineDialog::PreviewPipelineDialog(const PipelinePreview::Settings& settings, QWidget* parent)
+: QDialog(parent)
+, m_Factor(new QSpinBox(this))
+{
+  setWindowTitle(tr("Preview Execution"));
+  QGridLayout* layout = new QGridLayout(this);
+  QLabel* description = new QLabel(tr("Runs the pipeline without its writers on a part of the data. The image geometries that the readers create are cropped to the region of interest, "
+                                      "given in voxels, and then downsampled by the factor. The pipeline is not changed."),
+                                   this);
+  description->setWordWrap(true);
+  layout->addWidget(description, 0, 0, 1, 4);
+
+  layout->addWidget(new QLabel(tr("Downsampling factor"), this), 1, 0);
+  m_Factor->setRange(1, 64);
+  m_Factor->setValue(settings.factor);
+  layout->addWidget(m_Factor, 1, 1);
+
+  const char* axes[3] = {"X", "Y", "Z"};
+  for(int axis = 0; axis < 3; axis++)
+  {
+    layout->addWidget(new QLabel(tr("%1 from").arg(axes[axis]), this), 2 + axis, 0);
+    m_Minimum[axis] = new QSpinBox(this);
+    m_Minimum[axis]->setRange(0, std::numeric_limits<int>::max());
+    m_Minimum[axis]->setValue(settings.minimum[axis]);
+    layout->addWidget(m_Minimum[axis], 2 + axis, 1);
+
+    layout->addWidget(new QLabel(tr("to"), this), 2 + axis, 2);
+    m_Maximum[axis] = new QSpinBox(this);
+    m_Maximum[axis]->setRange(-1, std::numeric_limits<int>::max());
+    m_Maximum[axis]->setSpecialValueText(tr("End"));
+    m_Maximum[axis]->setValue(settings.maximum[axis]);
+    layout->addWidget(m_Maximum[axis], 2 + axis, 3);
+  }
+
+  QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+  connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+  connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+  layout->addWidget(buttons, 5, 0, 1, 4);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PreviewPipelineDialog::~PreviewPipelineDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelinePreview::Settings PreviewPipelineDialog::getSettings() const
+{
+  PipelinePreview::Settings settings;
+  settings.factor = m_Factor->value();
+  for(int axis = 0; axis < 3; axis++)
+  {
+    settings.minimum[axis] = m_Minimum[axis]->value();
+    settings.maximum[axis] = m_Maximum[axis]->value();
+  }
+  return settings;
+}
@@ -0,0 +1,287 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ResourceMonitorWidget.h"
+
+#include <algorithm>
+
+#include <QtCore/QEvent>
+#include <QtCore/QStringList>
+#include <QtGui/QHelpEvent>
+#include <QtGui/QPainter>
+#include <QtGui/QPen>
+#include <QtGui/QPolygonF>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QToolTip>
+
+#include "SIMPLView/PipelineMemoryGovernor.h"
+
+/**
+ * @brief A small line chart of the most recent values of one resource
+ */
+class ResourceSparkline : public QWidget
+{
+public:
+  ResourceSparkline(double minimumScale, QWidget* parent = nullptr)
+  : QWidget(parent)
+  , m_MinimumScale(minimumScale)
+  {
+    setFixedSize(48, 14);
+    setAttribute(Qt::WA_OpaquePaintEvent, false);
+  }
+
+  void clear()
+  {
+    m_Values.clear();
+    update();
+  }
+
+  void append(double value)
+  {
+    if(m_Values.size() >= ResourceSampler::HistoryLength)
+    {
+      m_Values.pop_front();
+    }
+    m_Values.push_back(value);
+    update();
+  }
+
+protected:
+  void paintEvent(QPaintEvent* event) override
+  {
+    Q_UNUSED(event)
+    if(m_Values.size() < 2)
+    {
+      return;
+    }
+
+    double scale = std::max(m_MinimumScale, *std::max_element(m_Values.begin(), m_Values.end()));
+    QPolygonF line;
+    line.reserve(m_Values.size());
+    double step = static_cast<double>(width() - 1) / (ResourceSampler::HistoryLength - 1);
+    double x = (width() - 1) - step * (m_Values.size() - 1);
+    for(double value : m_Values)
+    {
+      line << QPointF(x, (height() - 1) * (1.0 - value / scale));
+      x += step;
+    }
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(palette().color(QPalette::Highlight), 1.0));
+    painter.drawPolyline(line);
+  }
+
+private:
+  double m_MinimumScale = 1.0;
+  QList<double> m_Values;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceMonitorWidget::ResourceMonitorWidget(QWidget* parent)
+: QWidget(parent)
+{
+  QHBoxLayout* layout = new QHBoxLayout(this);
+  layout->setContentsMargins(4, 0, 4, 0);
+  layout->setSpacing(4);
+
+  m_MemoryLabel = new QLabel(this);
+  m_MemorySparkline = new ResourceSparkline(1.0, this);
+  m_CpuLabel = new QLabel(this);
+  m_CpuSparkline = new ResourceSparkline(100.0, this);
+  m_ThreadLabel = new QLabel(this);
+  m_IoLabel = new QLabel(this);
+  m_IoSparkline = new ResourceSparkline(1024.0 * 1024.0, this);
+
+  layout->addWidget(m_MemoryLabel);
+  layout->addWidget(m_MemorySparkline);
+  layout->addSpacing(6);
+  layout->addWidget(m_CpuLabel);
+  layout->addWidget(m_CpuSparkline);
+  layout->addSpacing(6);
+  layout->addWidget(m_ThreadLabel);
+  layout->addSpacing(6);
+  layout->addWidget(m_IoLabel);
+  layout->addWidget(m_IoSparkline);
+
+  connect(ResourceSampler::Instance(), &ResourceSampler::sampleAdded, this, &ResourceMonitorWidget::sampleAdded);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceMonitorWidget::~ResourceMonitorWidget()
+{
+  stopSampling();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::showEvent(QShowEvent* event)
+{
+  QWidget::showEvent(event);
+  startSampling();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::hideEvent(QHideEvent* event)
+{
+  QWidget::hideEvent(event);
+  stopSampling();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::startSampling()
+{
+  if(m_Sampling)
+  {
+    return;
+  }
+  m_Sampling = true;
+
+  // Catch up with what the sampler recorded for the other windows
+  m_MemorySparkline->clear();
+  m_CpuSparkline->clear();
+  m_IoSparkline->clear();
+  QVector<ResourceSampler::Sample> history = ResourceSampler::Instance()->getHistory();
+  for(const ResourceSampler::Sample& sample : history)
+  {
+    showSample(sample);
+  }
+
+  ResourceSampler::Instance()->acquire();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::stopSampling()
+{
+  if(!m_Sampling)
+  {
+    return;
+  }
+  m_Sampling = false;
+  ResourceSampler::Instance()->release();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::sampleAdded(const ResourceSampler::Sample& sample)
+{
+  if(m_Sampling)
+  {
+    showSample(sample);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::showSample(const ResourceSampler::Sample& sample)
+{
+  double ioRate = sample.readBytesPerSecond + sample.writeBytesPerSecond;
+
+  m_MemoryLabel->setText(tr("RSS %1").arg(PipelineMemoryGovernor::FormatBytes(sample.residentBytes)));
+  m_CpuLabel->setText(tr("CPU %1%").arg(sample.cpuPercent, 0, 'f', 0));
+  m_ThreadLabel->setText(tr("Threads %1").arg(sample.threadCount));
+  m_IoLabel->setText(tr("I/O %1/s").arg(PipelineMemoryGovernor::FormatBytes(static_cast<qint64>(ioRate))));
+
+  m_MemorySparkline->append(static_cast<double>(sample.residentBytes));
+  m_CpuSparkline->append(sample.cpuPercent);
+  m_IoSparkline->append(ioRate);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ResourceMonitorWidget::breakdown() const
+{
+  ResourceSampler* sampler = ResourceSampler::Instance();
+  ResourceSampler::Sample sample = sampler->getLatest();
+
+  QStringList lines;
+  lines << tr("Resident memory: %1").arg(PipelineMemoryGovernor::FormatBytes(sample.residentBytes));
+
+  // The kernel does not know about pipelines; the split uses the prediction each pipeline was admitted with
+  qint64 attributed = 0;
+  QList<QPair<QString, qint64>> running = PipelineMemoryGovernor::Instance()->getRunningPipelines();
+  for(const QPair<QString, qint64>& pipeline : running)
+  {
+    lines << tr("  %1: %2 predicted").arg(pipeline.first).arg(PipelineMemoryGovernor::FormatBytes(pipeline.second));
+    attributed += pipeline.second;
+  }
+  if(running.isEmpty())
+  {
+    lines << tr("  No pipeline is running");
+  }
+  else
+  {
+    lines << tr("  Everything else: %1").arg(PipelineMemoryGovernor::FormatBytes(qMax(static_cast<qint64>(0), sample.residentBytes - attributed)));
+  }
+
+  lines << tr("CPU: %1% (100% is one core)").arg(sample.cpuPercent, 0, 'f', 1);
+  lines << tr("Threads: %1").arg(sample.threadCount);
+  lines << tr("Read: %1/s (%2 total)").arg(PipelineMemoryGovernor::FormatBytes(static_cast<qint64>(sample.readBytesPerSecond))).arg(PipelineMemoryGovernor::FormatBytes(sample.totalReadBytes));
+  lines << tr("Written: %1/s (%2 total)")
+               .arg(PipelineMemoryGovernor::FormatBytes(static_cast<qint64>(sample.writeBytesPerSecond)))
+               .arg(PipelineMemoryGovernor::FormatBytes(sample.totalWrittenBytes));
+  lines << tr("Sampling cost: %1% of one core").arg(sampler->getOverhead() * 100.0, 0, 'f', 3);
+  return lines.join("\n");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResourceMonitorWidget::event(QEvent* event)
+{
+  // The breakdown is only assembled when somebody hovers over the monitor
+  if(event->type() == QEvent::ToolTip)
+  {
+    QHelpEvent* helpEvent = static_cast<QHelpEvent*>(event);
+    QToolTip::showText(helpEvent->globalPos(), breakdown(), this);
+    return true;
+  }
+  return QWidget::event(event);
+}
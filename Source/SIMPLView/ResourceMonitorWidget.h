@@ -0,0 +1,92 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtWidgets/QWidget>
+
+#include "SIMPLView/ResourceSampler.h"
+
+class QLabel;
+class ResourceSparkline;
+
+/**
+ * @brief The ResourceMonitorWidget class shows the live resource usage of the process in the status bar:
+ * resident memory, CPU utilization, thread count and I/O throughput, each with a sparkline of the last
+ * half minute. The tool tip breaks the resident memory down by the pipelines that are currently running.
+ * The widget only asks the ResourceSampler for samples while it is visible.
+ */
+class ResourceMonitorWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  ResourceMonitorWidget(QWidget* parent = nullptr);
+  ~ResourceMonitorWidget() override;
+
+  /**
+   * @brief Returns the per pipeline breakdown of the latest sample that is shown in the tool tip
+   * @return
+   */
+  QString breakdown() const;
+
+protected:
+  void showEvent(QShowEvent* event) override;
+  void hideEvent(QHideEvent* event) override;
+  bool event(QEvent* event) override;
+
+protected slots:
+  void sampleAdded(const ResourceSampler::Sample& sample);
+
+private:
+  QLabel* m_MemoryLabel = nullptr;
+  QLabel* m_CpuLabel = nullptr;
+  QLabel* m_ThreadLabel = nullptr;
+  QLabel* m_IoLabel = nullptr;
+  ResourceSparkline* m_MemorySparkline = nullptr;
+  ResourceSparkline* m_CpuSparkline = nullptr;
+  ResourceSparkline* m_IoSparkline = nullptr;
+  bool m_Sampling = false;
+
+  void startSampling();
+  void stopSampling();
+  void showSample(const ResourceSampler::Sample& sample);
+
+public:
+  ResourceMonitorWidget(const ResourceMonitorWidget&) = delete;            // Copy Constructor Not Implemented
+  ResourceMonitorWidget(ResourceMonitorWidget&&) = delete;                 // Move Constructor Not Implemented
+  ResourceMonitorWidget& operator=(const ResourceMonitorWidget&) = delete; // Copy Assignment Not Implemented
+  ResourceMonitorWidget& operator=(ResourceMonitorWidget&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,378 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ResourceSampler.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <QtCore/QDateTime>
+
+#if defined(Q_OS_LINUX)
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+/**
+ * @brief Returns the CPU time consumed by the calling thread in nanoseconds
+ */
+qint64 ThreadCpuTime()
+{
+#if defined(Q_OS_LINUX)
+  struct timespec ts;
+  if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+  {
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+  }
+#endif
+  return 0;
+}
+
+/**
+ * @brief Reads a /proc file that was opened unbuffered from the start into buffer and terminates it
+ */
+bool ReadProcFile(QFile& file, char* buffer, qint64 size)
+{
+  if(!file.isOpen() || !file.seek(0))
+  {
+    return false;
+  }
+  qint64 count = file.read(buffer, size - 1);
+  if(count <= 0)
+  {
+    return false;
+  }
+  buffer[count] = '\0';
+  return true;
+}
+
+/**
+ * @brief Returns the value of a "name: value" line of /proc/self/io
+ */
+qint64 IoField(const char* buffer, const char* name)
+{
+  const char* field = std::strstr(buffer, name);
+  if(nullptr == field)
+  {
+    return 0;
+  }
+  return std::strtoll(field + std::strlen(name), nullptr, 10);
+}
+}
+
+ResourceSampler* ResourceSampler::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceSampler::ResourceSampler(QObject* parent)
+: QObject(parent)
+, m_StatFile("/proc/self/stat")
+, m_IoFile("/proc/self/io")
+{
+  qRegisterMetaType<ResourceSampler::Sample>();
+
+  m_History.resize(HistoryLength);
+  m_Timer.setInterval(Interval);
+  m_Timer.setTimerType(Qt::CoarseTimer);
+  connect(&m_Timer, &QTimer::timeout, this, &ResourceSampler::sample);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceSampler::~ResourceSampler() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceSampler* ResourceSampler::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new ResourceSampler();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResourceSampler::IsSupported()
+{
+#if defined(Q_OS_LINUX)
+  return QFile::exists("/proc/self/stat");
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ResourceSampler::CurrentResidentBytes()
+{
+#if defined(Q_OS_LINUX)
+  // statm holds the sizes in pages: total, resident, shared, ...
+  QFile file("/proc/self/statm");
+  if(!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+  {
+    return 0;
+  }
+  char buffer[256];
+  if(!ReadProcFile(file, buffer, sizeof(buffer)))
+  {
+    return 0;
+  }
+  const char* resident = std::strchr(buffer, ' ');
+  if(nullptr == resident)
+  {
+    return 0;
+  }
+  return std::strtoll(resident + 1, nullptr, 10) * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceSampler::acquire()
+{
+  if(!IsSupported())
+  {
+    return;
+  }
+
+  m_Consumers++;
+  if(m_Consumers > 1)
+  {
+    return;
+  }
+
+  // /proc files regenerate their contents on every read from the start, so they are kept open between samples
+  m_StatFile.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+  m_IoFile.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+  m_LastCpuTicks = -1;
+  m_Clock.start();
+  sample();
+  m_Timer.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceSampler::release()
+{
+  if(m_Consumers <= 0)
+  {
+    return;
+  }
+
+  m_Consumers--;
+  if(m_Consumers == 0)
+  {
+    m_Timer.stop();
+    m_StatFile.close();
+    m_IoFile.close();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResourceSampler::readStat(qint64& cpuTicks, qint64& residentBytes, int& threadCount)
+{
+#if defined(Q_OS_LINUX)
+  char buffer[1024];
+  if(!ReadProcFile(m_StatFile, buffer, sizeof(buffer)))
+  {
+    return false;
+  }
+
+  // The command name is in parentheses and may contain spaces; the numeric fields start after the last ')'
+  const char* pos = std::strrchr(buffer, ')');
+  if(nullptr == pos)
+  {
+    return false;
+  }
+  pos += 2;
+
+  // Fields are numbered from 1 as in proc(5); pos now points at field 3 (state)
+  qint64 utime = 0;
+  qint64 stime = 0;
+  qint64 rssPages = 0;
+  threadCount = 0;
+  for(int field = 3; field <= 24 && *pos != '\0'; field++)
+  {
+    qint64 value = (field == 3) ? 0 : std::strtoll(pos, nullptr, 10);
+    switch(field)
+    {
+    case 14:
+      utime = value;
+      break;
+    case 15:
+      stime = value;
+      break;
+    case 20:
+      threadCount = static_cast<int>(value);
+      break;
+    case 24:
+      rssPages = value;
+      break;
+    default:
+      break;
+    }
+
+    pos = std::strchr(pos, ' ');
+    if(nullptr == pos)
+    {
+      break;
+    }
+    pos++;
+  }
+
+  static const qint64 pageSize = sysconf(_SC_PAGESIZE);
+  cpuTicks = utime + stime;
+  residentBytes = rssPages * pageSize;
+  return true;
+#else
+  Q_UNUSED(cpuTicks)
+  Q_UNUSED(residentBytes)
+  Q_UNUSED(threadCount)
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResourceSampler::readIo(qint64& readBytes, qint64& writtenBytes)
+{
+  char buffer[512];
+  if(!ReadProcFile(m_IoFile, buffer, sizeof(buffer)))
+  {
+    return false;
+  }
+
+  // rchar/wchar count everything the process read and wrote, including what the page cache served
+  readBytes = IoField(buffer, "rchar:");
+  writtenBytes = IoField(buffer, "wchar:");
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceSampler::sample()
+{
+#if defined(Q_OS_LINUX)
+  qint64 cpuStart = ThreadCpuTime();
+
+  Sample current;
+  current.timestamp = QDateTime::currentMSecsSinceEpoch();
+
+  qint64 cpuTicks = 0;
+  if(!readStat(cpuTicks, current.residentBytes, current.threadCount))
+  {
+    return;
+  }
+  // /proc/self/io is not readable in some containers; the I/O columns then stay at zero
+  readIo(current.totalReadBytes, current.totalWrittenBytes);
+
+  qint64 elapsed = m_Clock.restart();
+  if(m_Count > 0 && m_LastCpuTicks >= 0 && elapsed > 0)
+  {
+    const Sample& previous = m_History[(m_Next + HistoryLength - 1) % HistoryLength];
+    static const double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+    double seconds = elapsed / 1000.0;
+    current.cpuPercent = 100.0 * (cpuTicks - m_LastCpuTicks) / ticksPerSecond / seconds;
+    current.readBytesPerSecond = (current.totalReadBytes - previous.totalReadBytes) / seconds;
+    current.writeBytesPerSecond = (current.totalWrittenBytes - previous.totalWrittenBytes) / seconds;
+    m_SampledNSecs += elapsed * 1000000LL;
+  }
+  m_LastCpuTicks = cpuTicks;
+
+  m_History[m_Next] = current;
+  m_Next = (m_Next + 1) % HistoryLength;
+  m_Count = qMin(m_Count + 1, static_cast<int>(HistoryLength));
+
+  m_SamplingNSecs += ThreadCpuTime() - cpuStart;
+
+  emit sampleAdded(current);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ResourceSampler::Sample> ResourceSampler::getHistory() const
+{
+  QVector<Sample> history;
+  history.reserve(m_Count);
+  int first = (m_Next + HistoryLength - m_Count) % HistoryLength;
+  for(int i = 0; i < m_Count; i++)
+  {
+    history.push_back(m_History[(first + i) % HistoryLength]);
+  }
+  return history;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceSampler::Sample ResourceSampler::getLatest() const
+{
+  if(m_Count == 0)
+  {
+    return Sample();
+  }
+  return m_History[(m_Next + HistoryLength - 1) % HistoryLength];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double ResourceSampler::getOverhead() const
+{
+  if(m_SampledNSecs <= 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(m_SamplingNSecs) / static_cast<double>(m_SampledNSecs);
+}
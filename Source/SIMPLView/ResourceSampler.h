@@ -0,0 +1,160 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+/**
+ * @brief The ResourceSampler class samples the resource usage of the SIMPLView process from /proc/self a few
+ * times per second and keeps a short history for the status bar monitors. One sampler is shared by every
+ * window and it only runs while at least one monitor is visible. The /proc files are opened once and re-read
+ * in place so that a sample costs two reads and no allocations beyond the history ring.
+ *
+ * Sampling is only implemented on Linux; IsSupported() returns false everywhere else.
+ */
+class ResourceSampler : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~ResourceSampler() override;
+
+  /**
+   * @brief One sample. Rates are averaged over the interval since the previous sample.
+   */
+  struct Sample
+  {
+    qint64 timestamp = 0;
+    qint64 residentBytes = 0;
+    double cpuPercent = 0.0;
+    int threadCount = 0;
+    double readBytesPerSecond = 0.0;
+    double writeBytesPerSecond = 0.0;
+    qint64 totalReadBytes = 0;
+    qint64 totalWrittenBytes = 0;
+  };
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static ResourceSampler* Instance();
+
+  /**
+   * @brief Returns true if resource sampling is available on this platform
+   * @return
+   */
+  static bool IsSupported();
+
+  /**
+   * @brief Reads the resident memory of the process right now, independent of the sampling. Returns 0 where
+   * resource sampling is not supported.
+   * @return
+   */
+  static qint64 CurrentResidentBytes();
+
+  /**
+   * @brief Registers a consumer of samples. Sampling starts with the first consumer.
+   */
+  void acquire();
+
+  /**
+   * @brief Unregisters a consumer. Sampling stops when the last consumer is gone.
+   */
+  void release();
+
+  /**
+   * @brief Returns the samples of the last HistoryLength intervals, oldest first
+   * @return
+   */
+  QVector<Sample> getHistory() const;
+
+  /**
+   * @brief Returns the most recent sample
+   * @return
+   */
+  Sample getLatest() const;
+
+  /**
+   * @brief Returns the CPU time spent sampling as a fraction of the wall clock time sampled so far
+   * @return
+   */
+  double getOverhead() const;
+
+  static const int Interval = 250;
+  static const int HistoryLength = 120;
+
+signals:
+  void sampleAdded(const ResourceSampler::Sample& sample);
+
+protected:
+  ResourceSampler(QObject* parent = nullptr);
+
+protected slots:
+  void sample();
+
+private:
+  static ResourceSampler* self;
+
+  QTimer m_Timer;
+  QFile m_StatFile;
+  QFile m_IoFile;
+  int m_Consumers = 0;
+
+  QVector<Sample> m_History;
+  int m_Next = 0;
+  int m_Count = 0;
+
+  qint64 m_LastCpuTicks = -1;
+  QElapsedTimer m_Clock;
+  qint64 m_SamplingNSecs = 0;
+  qint64 m_SampledNSecs = 0;
+
+  bool readStat(qint64& cpuTicks, qint64& residentBytes, int& threadCount);
+  bool readIo(qint64& readBytes, qint64& writtenBytes);
+
+public:
+  ResourceSampler(const ResourceSampler&) = delete;            // Copy Constructor Not Implemented
+  ResourceSampler(ResourceSampler&&) = delete;                 // Move Constructor Not Implemented
+  ResourceSampler& operator=(const ResourceSampler&) = delete; // Copy Assignment Not Implemented
+  ResourceSampler& operator=(ResourceSampler&&) = delete;      // Move Assignment Not Implemented
+};
+
+Q_DECLARE_METATYPE(ResourceSampler::Sample)
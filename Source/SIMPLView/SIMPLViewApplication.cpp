@@ -39,11 +39,14 @@
 #endif
 
 #include <ctime>
+#include <functional>
 #include <iostream>
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QPluginLoader>
 #include <QtCore/QProcess>
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include <QtGui/QBitmap>
 #include <QtGui/QBitmap>
@@ -62,6 +65,7 @@
 #include "SIMPLib/Utilities/SIMPLDataPathValidator.h"
 #include "SIMPLib/SIMPLibVersion.h"
 
+#include "SVWidgetsLib/Core/FilterWidgetManager.h"
 #include "SVWidgetsLib/QtSupport/QtSApplicationAboutBoxDialog.h"
 #include "SVWidgetsLib/QtSupport/QtSDocServer.h"
 #include "SVWidgetsLib/QtSupport/QtSRecentFileList.h"
@@ -75,14 +79,20 @@
 #include "SVWidgetsLib/Dialogs/UpdateCheck.h"
 #include "SVWidgetsLib/Dialogs/UpdateCheckData.h"
 #include "SVWidgetsLib/Dialogs/UpdateCheckDialog.h"
+#include "SVWidgetsLib/Widgets/BookmarksModel.h"
 #include "SVWidgetsLib/Widgets/BookmarksToolboxWidget.h"
 #include "SVWidgetsLib/Widgets/PipelineModel.h"
 #include "SVWidgetsLib/Widgets/SVStyle.h"
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/EventLoopWatchdog.h"
+#include "SIMPLView/FilterSearchIndex.h"
+#include "SIMPLView/HelpServer.h"
+#include "SIMPLView/MetricsServer.h"
 #include "SIMPLView/SIMPLView_UI.h"
 #include "SIMPLView/SIMPLViewVersion.h"
 #include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SettingsCache.h"
 
 #include "BrandedStrings.h"
 
@@ -104,6 +114,23 @@ void fillVersionData(UpdateCheck::SIMPLVersionData_t& data)
   data.buildDate = SIMPLView::Version::BuildDate();
   data.appName = BrandedStrings::ApplicationName;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void visitBookmarks(BookmarksModel* model, const QModelIndex& parent, const std::function<void(const QModelIndex&, const QString&)>& visit)
+{
+  for(int row = 0; row < model->rowCount(parent); row++)
+  {
+    QModelIndex index = model->index(row, 0, parent);
+    QString path = model->data(index, BookmarksModel::Roles::PathRole).toString();
+    if(!path.isEmpty())
+    {
+      visit(index, path);
+    }
+    visitBookmarks(model, index, visit);
+  }
+}
 }
 
 // -----------------------------------------------------------------------------
@@ -127,6 +154,12 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
 
   readSettings();
 
+  // The spare window is built a little while after a window has been handed out, once the new window has painted
+  m_SpareWindowTimer = new QTimer(this);
+  m_SpareWindowTimer->setSingleShot(true);
+  m_SpareWindowTimer->setInterval(1500);
+  connect(m_SpareWindowTimer, &QTimer::timeout, this, &SIMPLViewApplication::buildSpareWindow);
+
   // Create the default menu bar
   createDefaultMenuBar();
 
@@ -141,6 +174,14 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
 
   QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
   QtSRecentFileList::Instance()->readList(prefs.data());
+
+  // Whether recent files, bookmarks and the data folder exist is found out in the background
+  connect(FileStatusService::Instance(), &FileStatusService::infoChanged, this, &SIMPLViewApplication::fileStatusChanged);
+  connect(m_MenuRecentFiles, &QMenu::aboutToShow, this, &SIMPLViewApplication::refreshFileStatus);
+  BookmarksModel* bookmarks = BookmarksModel::Instance();
+  connect(bookmarks, &BookmarksModel::rowsInserted, this, &SIMPLViewApplication::checkBookmarks);
+  connect(bookmarks, &BookmarksModel::modelReset, this, &SIMPLViewApplication::checkBookmarks);
+  checkBookmarks();
 }
 
 // -----------------------------------------------------------------------------
@@ -151,11 +192,17 @@ SIMPLViewApplication::~SIMPLViewApplication()
   delete this->m_SplashScreen;
   this->m_SplashScreen = nullptr;
 
+  delete m_SpareWindow;
+  m_SpareWindow = nullptr;
+
   for(int i = 0; i < m_PluginLoaders.size(); i++)
   {
     delete m_PluginLoaders[i];
   }
 
+  // Finish any background write of the cached window settings before the preferences file is touched directly
+  SettingsCache::Instance()->flushNow();
+
   writeSettings();
 
   QtSSettings prefs;
@@ -229,7 +276,11 @@ bool SIMPLViewApplication::initialize(int argc, char* argv[])
   QMetaObjectUtilities::RegisterMetaTypes();
 
   // Load application plugins.
+  QElapsedTimer pluginTimer;
+  pluginTimer.start();
   QVector<ISIMPLibPlugin*> plugins = loadPlugins();
+  MetricsServer::Instance()->setPluginLoadTime(pluginTimer.elapsed() / 1000.0, plugins.size());
+  FilterSearchIndex::Instance()->build();
 
   // give GUI components time to update before the mainwindow is shown
   QApplication::instance()->processEvents();
@@ -379,6 +430,10 @@ QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
   FilterManager* filterManager = FilterManager::Instance();
   FilterWidgetManager* fwm = FilterWidgetManager::Instance();
 
+  // Register the filter widgets that SVWidgetsLib knows about. This is done once for the whole application
+  // and before the plugins so that a plugin can still replace any of them.
+  FilterWidgetManager::RegisterKnownFilterWidgets();
+
   // THIS IS A VERY IMPORTANT LINE: It will register all the known filters in the dream3d library. This
   // will NOT however get filters from plugins. We are going to have to figure out how to compile filters
   // into their own plugin and load the plugins from a command line.
@@ -465,6 +520,7 @@ void SIMPLViewApplication::updateRecentFileList(const QString& file)
   {
     QString filePath = filePaths[i];
     QAction* action = m_MenuRecentFiles->addAction(QtSRecentFileList::Instance()->parentAndFileName(filePath));
+    trackFileStatus(action, filePath);
 //    action->setVisible(true);
     connect(action, &QAction::triggered, [=] {
       dream3dApp->newInstanceFromFile(filePath);
@@ -538,6 +594,7 @@ void SIMPLViewApplication::listenClearSIMPLViewCacheTriggered()
 
   if(response == QMessageBox::Yes)
   {
+    SettingsCache::Instance()->flushNow();
     QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
 
     // Set a flag in the preferences file, so that we know that we are in "Reset Preferences" mode
@@ -566,6 +623,21 @@ void SIMPLViewApplication::listenClearSIMPLViewCacheTriggered()
 // -----------------------------------------------------------------------------
 void SIMPLViewApplication::listenShowSIMPLViewHelpTriggered()
 {
+  // The prebuilt help archive is served from memory; the documentation server is the fallback
+  QUrl archiveURL = HelpServer::Instance()->pageUrl("index.html");
+  if(archiveURL.isValid())
+  {
+#ifdef SIMPL_USE_QtWebEngine
+    SVUserManualDialog::LaunchHelpDialog(archiveURL);
+    return;
+#else
+    if(QDesktopServices::openUrl(archiveURL))
+    {
+      return;
+    }
+#endif
+  }
+
   QString appPath = QApplication::applicationDirPath();
 
   QDir helpDir = QDir(appPath);
@@ -679,9 +751,131 @@ void SIMPLViewApplication::listenShowDataFolderTriggered()
 {
   SIMPLDataPathValidator* validator = SIMPLDataPathValidator::Instance();
   QString dataDirectory = validator->getSIMPLDataDirectory();
+
+  // Showing a folder on a share that does not answer would hang the GUI; while the directory is being checked the
+  // request waits for the answer in fileStatusChanged()
+  FileStatusService::Status status = FileStatusService::Instance()->info(dataDirectory).status;
+  if(status == FileStatusService::Status::Checking)
+  {
+    m_PendingShowDataFolder = dataDirectory;
+    if(m_ActiveWindow != nullptr)
+    {
+      m_ActiveWindow->setStatusBarMessage(tr("Checking the data directory '%1'...").arg(dataDirectory));
+    }
+    return;
+  }
+  m_PendingShowDataFolder.clear();
+  showDataFolder(dataDirectory, status);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::showDataFolder(const QString& dataDirectory, FileStatusService::Status status)
+{
+  if(status != FileStatusService::Status::Exists)
+  {
+    if(m_ActiveWindow != nullptr)
+    {
+      m_ActiveWindow->setStatusBarMessage(tr("The data directory '%1' is %2.").arg(dataDirectory).arg(FileStatusService::Describe(status)));
+    }
+    return;
+  }
   QtSFileUtils::ShowPathInGui(nullptr, dataDirectory);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::trackFileStatus(QAction* action, const QString& path)
+{
+  if(!action->property("FileStatusText").isValid())
+  {
+    action->setProperty("FileStatusText", action->text());
+  }
+  action->setData(path);
+
+  m_FileStatusActions.removeAll(QPointer<QAction>());
+  if(!m_FileStatusActions.contains(action))
+  {
+    m_FileStatusActions.push_back(action);
+  }
+  applyFileStatus(action, FileStatusService::Instance()->info(path));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::applyFileStatus(QAction* action, const FileStatusService::Info& info)
+{
+  QString text = action->property("FileStatusText").toString();
+  QString status = FileStatusService::Describe(info.status);
+  action->setText(status.isEmpty() ? text : tr("%1 (%2)").arg(text).arg(status));
+  action->setEnabled(info.status == FileStatusService::Status::Exists || info.status == FileStatusService::Status::Checking);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::fileStatusChanged(const QString& path, const FileStatusService::Info& info)
+{
+  if(!m_PendingShowDataFolder.isEmpty() && path == m_PendingShowDataFolder && info.status != FileStatusService::Status::Checking)
+  {
+    m_PendingShowDataFolder.clear();
+    showDataFolder(path, info.status);
+  }
+
+  for(const QPointer<QAction>& action : m_FileStatusActions)
+  {
+    if(!action.isNull() && action->data().toString() == path)
+    {
+      applyFileStatus(action, info);
+    }
+  }
+
+  BookmarksModel* model = BookmarksModel::Instance();
+  bool unavailable = (info.status == FileStatusService::Status::Missing || info.status == FileStatusService::Status::Unreachable);
+  Detail::visitBookmarks(model, QModelIndex(), [=](const QModelIndex& index, const QString& bookmarkPath) {
+    if(bookmarkPath == path)
+    {
+      model->setData(index, unavailable, BookmarksModel::Roles::ErrorsRole);
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::refreshFileStatus()
+{
+  FileStatusService* service = FileStatusService::Instance();
+  for(const QPointer<QAction>& action : m_FileStatusActions)
+  {
+    if(!action.isNull())
+    {
+      applyFileStatus(action, service->info(action->data().toString()));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::checkBookmarks()
+{
+  // A bookmark keeps its state while it is checked; the answer arrives through fileStatusChanged()
+  FileStatusService* service = FileStatusService::Instance();
+  BookmarksModel* model = BookmarksModel::Instance();
+  Detail::visitBookmarks(model, QModelIndex(), [=](const QModelIndex& index, const QString& path) {
+    FileStatusService::Status status = service->info(path).status;
+    if(status != FileStatusService::Status::Checking)
+    {
+      bool unavailable = (status == FileStatusService::Status::Missing || status == FileStatusService::Status::Unreachable);
+      model->setData(index, unavailable, BookmarksModel::Roles::ErrorsRole);
+    }
+  });
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -802,13 +996,18 @@ SIMPLView_UI* SIMPLViewApplication::newInstanceFromFile(const QString& filePath)
 // -----------------------------------------------------------------------------
 SIMPLView_UI* SIMPLViewApplication::getNewSIMPLViewInstance()
 {
-  PluginManager* pluginManager = PluginManager::Instance();
-  QVector<ISIMPLibPlugin*> plugins = pluginManager->getPluginsVector();
+  SIMPLView_UI* newInstance = m_SpareWindow;
+  m_SpareWindow = nullptr;
+  if(newInstance == nullptr)
+  {
+    newInstance = createSIMPLViewWindow();
+  }
+  else
+  {
+    // The spare was built a while ago; pick up any layout changes the user has made since then
+    newInstance->readWindowSettings();
+  }
 
-  // Create new SIMPLView instance
-  SIMPLView_UI* newInstance = new SIMPLView_UI(nullptr);
-  newInstance->setLoadedPlugins(plugins);
-  newInstance->setAttribute(Qt::WA_DeleteOnClose);
   newInstance->setWindowTitle("[*]Untitled Pipeline - " + BrandedStrings::ApplicationName);
 
   if(m_ActiveWindow != nullptr)
@@ -817,12 +1016,54 @@ SIMPLView_UI* SIMPLViewApplication::getNewSIMPLViewInstance()
   }
 
   m_ActiveWindow = newInstance;
+  registerSIMPLViewWindow(newInstance);
+  newInstance->connectServices();
+
+  // Replace the spare that was just handed out
+  m_SpareWindowTimer->start();
+
+  return newInstance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SIMPLView_UI* SIMPLViewApplication::createSIMPLViewWindow()
+{
+  PluginManager* pluginManager = PluginManager::Instance();
+  QVector<ISIMPLibPlugin*> plugins = pluginManager->getPluginsVector();
+
+  // Create new SIMPLView instance
+  SIMPLView_UI* newInstance = new SIMPLView_UI(nullptr);
+  newInstance->setLoadedPlugins(plugins);
+  newInstance->setAttribute(Qt::WA_DeleteOnClose);
 
   connect(newInstance, SIGNAL(dream3dWindowChangedState(SIMPLView_UI*)), this, SLOT(dream3dWindowChanged(SIMPLView_UI*)));
 
   return newInstance;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::buildSpareWindow()
+{
+  if(m_SpareWindow != nullptr || m_SIMPLViewInstances.isEmpty())
+  {
+    return;
+  }
+
+  // Building a window blocks the event loop, so wait while the user is in the middle of something
+  if(QApplication::activeModalWidget() != nullptr || QApplication::activePopupWidget() != nullptr || QApplication::mouseButtons() != Qt::NoButton)
+  {
+    m_SpareWindowTimer->start();
+    return;
+  }
+
+  EventLoopWatchdog::ActionScope watchdogScope("buildSpareWindow");
+  m_SpareWindow = createSIMPLViewWindow();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -904,7 +1145,11 @@ void SIMPLViewApplication::registerSIMPLViewWindow(SIMPLView_UI* window)
 // -----------------------------------------------------------------------------
 void SIMPLViewApplication::unregisterSIMPLViewWindow(SIMPLView_UI* window)
 {
-  m_SIMPLViewInstances.removeAll(window);
+  // The spare window is never registered, and destroying it must not quit the application
+  if(m_SIMPLViewInstances.removeAll(window) == 0)
+  {
+    return;
+  }
 
   if (m_SIMPLViewInstances.isEmpty())
   {
@@ -958,7 +1203,7 @@ void SIMPLViewApplication::writeSettings()
 {
   QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
 
-  prefs->beginGroup("Application Settings");
+  prefs->beginGroup(SIMPLView::ApplicationSettings::GroupName);
 
   SVStyle* styles = SVStyle::Instance();
   QString themeFilePath = styles->getCurrentThemeFilePath();
@@ -985,7 +1230,7 @@ void SIMPLViewApplication::readSettings()
 {
   QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
 
-  prefs->beginGroup("Application Settings");
+  prefs->beginGroup(SIMPLView::ApplicationSettings::GroupName);
 
   SVStyle* styles = SVStyle::Instance();
   QString themeFilePath = prefs->value("Theme File Path", QString()).toString();
@@ -1205,6 +1450,7 @@ void SIMPLViewApplication::createDefaultMenuBar()
 
   connect(m_ActionSetDataFolder, &QAction::triggered, this, &SIMPLViewApplication::listenSetDataFolderTriggered);
   connect(m_ActionShowDataFolder, &QAction::triggered, this, &SIMPLViewApplication::listenShowDataFolderTriggered);
+  connect(m_MenuDataDirectory, &QMenu::aboutToShow, this, [this] { trackFileStatus(m_ActionShowDataFolder, SIMPLDataPathValidator::Instance()->getSIMPLDataDirectory()); });
 
   m_MenuHelp->addSeparator();
   m_MenuHelp->addMenu(m_MenuDataDirectory);
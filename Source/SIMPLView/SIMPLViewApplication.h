@@ -35,8 +35,10 @@
 
 #pragma once
 
+#include <QtCore/QPointer>
 #include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
 
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMenuBar>
@@ -44,9 +46,12 @@
 
 #include "SVWidgetsLib/Dialogs/UpdateCheck.h"
 
+#include "SIMPLView/FileStatusService.h"
+
 #define dream3dApp (static_cast<SIMPLViewApplication*>(qApp))
 
 class QSplashScreen;
+class QTimer;
 class SIMPLView_UI;
 class QPluginLoader;
 class ISIMPLibPlugin;
@@ -121,6 +126,14 @@ public:
    */
   QMenu* getRecentFilesMenu();
 
+  /**
+   * @brief Shows whether path exists in the text of an action, and disables the action if it does not. The action
+   * is updated whenever the FileStatusService learns more about the path.
+   * @param action
+   * @param path
+   */
+  void trackFileStatus(QAction* action, const QString& path);
+
 public slots:
   void listenNewInstanceTriggered();
   void listenOpenPipelineTriggered();
@@ -158,6 +171,16 @@ protected:
   QSplashScreen* m_SplashScreen;
   QVector<QPluginLoader*> m_PluginLoaders;
 
+  // A hidden, fully constructed window that is handed out by the next getNewSIMPLViewInstance() call
+  SIMPLView_UI* m_SpareWindow = nullptr;
+  QTimer* m_SpareWindowTimer = nullptr;
+
+  /**
+   * @brief Constructs a window that is not registered or shown yet
+   * @return
+   */
+  SIMPLView_UI* createSIMPLViewWindow();
+
   /**
    * @brief loadPlugins
    * @return
@@ -181,6 +204,28 @@ protected slots:
    */
   void dream3dWindowChanged(SIMPLView_UI* instance);
 
+  /**
+   * @brief Builds the spare window if there is none. Runs from a timer so that it happens while the application is idle.
+   */
+  void buildSpareWindow();
+
+  /**
+   * @brief Updates the actions and bookmarks that point at path
+   * @param path
+   * @param info
+   */
+  void fileStatusChanged(const QString& path, const FileStatusService::Info& info);
+
+  /**
+   * @brief Asks the FileStatusService about the tracked actions again; outdated answers are checked in the background
+   */
+  void refreshFileStatus();
+
+  /**
+   * @brief Asks the FileStatusService about every bookmark and marks the ones it knows are missing or unreachable
+   */
+  void checkBookmarks();
+
 private:
   QMenuBar* m_DefaultMenuBar = nullptr;
   QMenu* m_DockMenu = nullptr;
@@ -189,6 +234,20 @@ private:
 
   QString                                                           m_LastFilePathOpened;
 
+  QVector<QPointer<QAction>>                                        m_FileStatusActions;
+
+  // The data directory that Show Data Folder asked for while its status was still being checked
+  QString                                                           m_PendingShowDataFolder;
+
+  void applyFileStatus(QAction* action, const FileStatusService::Info& info);
+
+  /**
+   * @brief Shows the data directory in the file browser if it exists, otherwise tells the user what it is
+   * @param dataDirectory
+   * @param status
+   */
+  void showDataFolder(const QString& dataDirectory, FileStatusService::Status status);
+
   QMenu* m_MenuFile = nullptr;
   QMenu* m_MenuEdit = nullptr;
   QMenu* m_MenuView = nullptr;
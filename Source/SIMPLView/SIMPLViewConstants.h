@@ -49,5 +49,17 @@ namespace SIMPLView
     static const QString WhenToCheck("WhenToCheck");
     static const QString UpdateWebSite("http://dream3d.bluequartz.net/dream3d_version.json");
   }
+
+  namespace ApplicationSettings
+  {
+    static const QString GroupName("Application Settings");
+  }
+
+  namespace WindowSettings
+  {
+    static const QString GroupName("WindowSettings");
+    static const QString MainWindowGeometry("MainWindowGeometry");
+    static const QString MainWindowState("MainWindowState");
+  }
 }
 
@@ -36,26 +36,45 @@
 #include "SIMPLView_UI.h"
 
 //-- Qt Includes
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QFileInfoList>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QMimeData>
 #include <QtCore/QProcess>
+#include <QtCore/QSignalBlocker>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QString>
-#include <QtCore/QThread>
+#include <QtCore/QSysInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtGui/QClipboard>
 #include <QtGui/QCloseEvent>
 #include <QtGui/QDesktopServices>
 #include <QtWidgets/QCheckBox>
+#include <QtWidgets/QDialog>
 #include <QtWidgets/QFileDialog>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QInputDialog>
+#include <QtWidgets/QDialogButtonBox>
 #include <QtWidgets/QListWidget>
+#include <QtWidgets/QPlainTextEdit>
 #include <QtWidgets/QScrollBar>
 #include <QtWidgets/QShortcut>
+#include <QtWidgets/QTabWidget>
 #include <QtWidgets/QToolButton>
+#include <QtWidgets/QTreeView>
+#include <QtWidgets/QVBoxLayout>
+
+#include <QtSql/QSqlDatabase>
 
 //-- SIMPLView Includes
 #include "SIMPLib/Common/Constants.h"
@@ -100,13 +119,68 @@
 #endif
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/EventLoopWatchdog.h"
+#include "SIMPLView/FilterSearchDialog.h"
+#include "SIMPLView/ExecutionEventLog.h"
+#include "SIMPLView/ExecutionHistory.h"
+#include "SIMPLView/ExecutionHistoryDialog.h"
+#include "SIMPLView/FilterTimingHistory.h"
+#include "SIMPLView/HelpServer.h"
+#include "SIMPLView/MetricsServer.h"
+#include "SIMPLView/PipelineArrayReleaser.h"
+#include "SIMPLView/PipelineBinaryFormat.h"
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/PipelineMemoryGovernor.h"
+#include "SIMPLView/PreviewPipelineDialog.h"
+#include "SIMPLView/ResourceMonitorWidget.h"
+#include "SIMPLView/ResourceSampler.h"
 #include "SIMPLView/SIMPLView.h"
 #include "SIMPLView/SIMPLViewApplication.h"
 #include "SIMPLView/SIMPLViewConstants.h"
 #include "SIMPLView/SIMPLViewVersion.h"
+#include "SIMPLView/ScrubParameterDialog.h"
+#include "SIMPLView/SettingsCache.h"
+#include "SIMPLView/TraceRecorder.h"
 
 #include "BrandedStrings.h"
 
+namespace
+{
+/**
+ * @brief Returns a hash of the filter classes of a pipeline, so that the runs of one pipeline can be found in
+ * the execution history even if its parameters or its file change
+ */
+QString PipelineHash(FilterPipeline::Pointer pipeline)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  if(nullptr != pipeline.get())
+  {
+    for(AbstractFilter::Pointer filter : pipeline->getFilterContainer())
+    {
+      hash.addData(filter->getNameOfClass().toUtf8());
+      hash.addData("\n", 1);
+    }
+  }
+  return QString::fromLatin1(hash.result().toHex().left(16));
+}
+
+/**
+ * @brief Returns the versions of the loaded plugins as a Json object
+ */
+QString PluginVersions(const QVector<ISIMPLibPlugin*>& plugins)
+{
+  QJsonObject versions;
+  for(ISIMPLibPlugin* plugin : plugins)
+  {
+    if(nullptr != plugin)
+    {
+      versions[plugin->getPluginBaseName()] = plugin->getVersion();
+    }
+  }
+  return QString::fromUtf8(QJsonDocument(versions).toJson(QJsonDocument::Compact));
+}
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -114,21 +188,53 @@ SIMPLView_UI::SIMPLView_UI(QWidget* parent)
 : QMainWindow(parent)
 , m_Ui(new Ui::SIMPLView_UI)
 , m_LastOpenedFilePath(QDir::homePath())
+, m_ExecutionLogId(ExecutionEventLog::Instance()->newPipelineId())
+, m_ExecutionRun(1)
 {
   // Register all of the Filters we know about - the rest will be loaded through plugins
   //  which all should have been loaded by now.
   m_FilterManager = FilterManager::Instance();
   // m_FilterManager->RegisterKnownFilters(m_FilterManager);
 
-  // Register all the known filterWidgets
+  // The known filterWidgets were registered once by the application when the plugins were loaded
   m_FilterWidgetManager = FilterWidgetManager::Instance();
-  FilterWidgetManager::RegisterKnownFilterWidgets();
 
   // Calls the Parent Class to do all the Widget Initialization that were created
   // using the QDesigner program
   m_Ui->setupUi(this);
 
-  dream3dApp->registerSIMPLViewWindow(this);
+  m_PipelineLoader = new PipelineLoader(this);
+  m_ArrayReleaser = new PipelineArrayReleaser(this);
+  m_SliceRunner = new PipelineSliceRunner(this);
+  connect(m_SliceRunner, &PipelineSliceRunner::finished, this, &SIMPLView_UI::arrayComputed);
+  connect(m_SliceRunner, &PipelineSliceRunner::progress, this, [this](int done, int count, const QString& humanLabel) {
+    statusBar()->showMessage(tr("Running %1 (%2 of %3)").arg(humanLabel).arg(done + 1).arg(count));
+  });
+
+  // Input changes that arrive while something runs wait in the watcher; queued so that a waiting scrub goes first
+  m_InputWatcher = new InputFileWatcher(this);
+  connect(m_InputWatcher, &InputFileWatcher::changed, this, &SIMPLView_UI::startWatchRun);
+  connect(m_SliceRunner, &PipelineSliceRunner::finished, this, &SIMPLView_UI::startWatchRun, Qt::QueuedConnection);
+
+  m_BatchRunner = new BatchPipelineRunner(this);
+  connect(m_BatchRunner, &BatchPipelineRunner::datasetFinished, this, &SIMPLView_UI::batchDatasetFinished);
+  connect(m_BatchRunner, &BatchPipelineRunner::finished, this, &SIMPLView_UI::batchFinished);
+
+  m_Prefetcher = new InputPrefetcher(this);
+  connect(m_Prefetcher, &InputPrefetcher::progress, this, &SIMPLView_UI::prefetchProgress);
+  connect(m_Prefetcher, &InputPrefetcher::finished, this, &SIMPLView_UI::prefetchFinished);
+
+  // Pipeline messages are handled in batches; the timer sets the rate at which the GUI catches up
+  m_MessageDrainTimer = new QTimer(this);
+  m_MessageDrainTimer->setSingleShot(true);
+  m_MessageDrainTimer->setInterval(50);
+  connect(m_MessageDrainTimer, &QTimer::timeout, this, &SIMPLView_UI::drainPipelineMessages);
+
+  // Long filters send few messages, so the ETA is also refreshed on its own while a pipeline runs
+  m_EstimateTimer = new QTimer(this);
+  m_EstimateTimer->setInterval(1000);
+  connect(m_EstimateTimer, &QTimer::timeout, this, &SIMPLView_UI::updateRunEstimate);
+  connect(m_PipelineLoader, &PipelineLoader::pipelineLoaded, this, &SIMPLView_UI::pipelineLoaded);
 
   // Do our own widget initializations
   setupGui();
@@ -155,7 +261,13 @@ SIMPLView_UI::SIMPLView_UI(QWidget* parent)
 // -----------------------------------------------------------------------------
 SIMPLView_UI::~SIMPLView_UI()
 {
-  writeSettings();
+  // A spare window that was never shown has nothing worth saving
+  if(dream3dApp->getSIMPLViewInstances().contains(this))
+  {
+    writeSettings();
+  }
+
+  PipelineMemoryGovernor::Instance()->removeOwner(this);
 
   dream3dApp->unregisterSIMPLViewWindow(this);
 
@@ -204,8 +316,10 @@ bool SIMPLView_UI::savePipeline()
   filePath = QDir::toNativeSeparators(filePath);
 
   // Write the pipeline
-  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
-  viewWidget->writePipeline(filePath);
+  if(writePipelineFile(filePath) < 0)
+  {
+    return false;
+  }
 
   // Set window title and save flag
   QFileInfo prefFileInfo = QFileInfo(filePath);
@@ -219,6 +333,45 @@ bool SIMPLView_UI::savePipeline()
   return true;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SIMPLView_UI::writePipelineFile(const QString& filePath)
+{
+  EventLoopWatchdog::ActionScope watchdogScope("writePipelineFile");
+  SV_TRACE_SCOPE_CATEGORY("Write Pipeline File", "io");
+
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+
+  QFileInfo fi(filePath);
+  if(fi.suffix().compare(PipelineBinaryFormat::FileExtension(), Qt::CaseInsensitive) != 0)
+  {
+    return viewWidget->writePipeline(filePath);
+  }
+
+  QTemporaryDir tempDir;
+  if(!tempDir.isValid())
+  {
+    QMessageBox::critical(this, tr("Save Pipeline"), tr("Could not create a temporary folder to write the pipeline."), QMessageBox::Ok);
+    return -1;
+  }
+
+  QString jsonFilePath = tempDir.path() + QDir::separator() + fi.completeBaseName() + ".json";
+  int err = viewWidget->writePipeline(jsonFilePath);
+  if(err < 0)
+  {
+    return err;
+  }
+
+  QString errorMessage;
+  err = PipelineBinaryFormat::ConvertJsonToBinary(jsonFilePath, filePath, &errorMessage);
+  if(err < 0)
+  {
+    QMessageBox::critical(this, tr("Save Pipeline"), errorMessage, QMessageBox::Ok);
+  }
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -233,7 +386,7 @@ void SIMPLView_UI::listenSavePipelineAsTriggered()
 bool SIMPLView_UI::savePipelineAs()
 {
   QString proposedFile = m_LastOpenedFilePath + QDir::separator() + "Untitled.json";
-  QString filePath = QFileDialog::getSaveFileName(this, tr("Save Pipeline To File"), proposedFile, tr("Json File (*.json);;SIMPLView File (*.dream3d);;All Files (*.*)"));
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Save Pipeline To File"), proposedFile, tr("Json File (*.json);;Binary Pipeline File (*.%1);;SIMPLView File (*.dream3d);;All Files (*.*)").arg(PipelineBinaryFormat::FileExtension()));
   if(filePath.isEmpty())
   {
     return false;
@@ -250,8 +403,7 @@ bool SIMPLView_UI::savePipelineAs()
   }
 
   // Write the pipeline
-  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
-  int err = viewWidget->writePipeline(filePath);
+  int err = writePipelineFile(filePath);
 
   if(err >= 0)
   {
@@ -333,6 +485,36 @@ void SIMPLView_UI::closeEvent(QCloseEvent* event)
     return;
   }
 
+  if(m_BatchRunner->isRunning())
+  {
+    QMessageBox runningBatchBox;
+    runningBatchBox.setWindowTitle("Batch is Running");
+    runningBatchBox.setText("There is a batch currently running.\nPlease cancel the batch, wait until its last datasets are written and try again.");
+    runningBatchBox.setStandardButtons(QMessageBox::Ok);
+    runningBatchBox.setIcon(QMessageBox::Warning);
+    runningBatchBox.exec();
+    event->ignore();
+    return;
+  }
+
+  // Pending writes are finished before the application quits, which may take a while
+  qint64 pendingBytes = 0;
+  int pendingWrites = AsyncWriteService::Instance()->pendingWrites(&pendingBytes);
+  if(pendingWrites > 0)
+  {
+    QMessageBox::StandardButton answer = QMessageBox::question(this, "Writes are Pending",
+                                                               tr("%1 background writes (%2) have not finished yet. They are completed before %3 quits.\n"
+                                                                  "Do you want to close the window anyway?")
+                                                                   .arg(pendingWrites)
+                                                                   .arg(PipelineMemoryGovernor::FormatBytes(pendingBytes))
+                                                                   .arg(QApplication::applicationName()));
+    if(answer != QMessageBox::Yes)
+    {
+      event->ignore();
+      return;
+    }
+  }
+
   QMessageBox::StandardButton choice = checkDirtyDocument();
   if(choice == QMessageBox::Cancel)
   {
@@ -351,6 +533,8 @@ void SIMPLView_UI::closeEvent(QCloseEvent* event)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::readSettings()
 {
+  EventLoopWatchdog::ActionScope watchdogScope("readSettings");
+
   QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
 
   // Have the pipeline builder read its settings from the prefs file
@@ -393,13 +577,12 @@ void SIMPLView_UI::readSettings()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::readWindowSettings()
 {
-  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
+  SettingsCache* cache = SettingsCache::Instance();
 
   bool ok = false;
-  prefs->beginGroup("WindowSettings");
-  if(prefs->contains(QString("MainWindowGeometry")))
+  if(cache->contains(SIMPLView::WindowSettings::GroupName, SIMPLView::WindowSettings::MainWindowGeometry))
   {
-    QByteArray geo_data = prefs->value("MainWindowGeometry", QByteArray());
+    QByteArray geo_data = cache->value(SIMPLView::WindowSettings::GroupName, SIMPLView::WindowSettings::MainWindowGeometry, QByteArray()).toByteArray();
     ok = restoreGeometry(geo_data);
     if(!ok)
     {
@@ -408,13 +591,41 @@ void SIMPLView_UI::readWindowSettings()
     }
   }
 
-  if(prefs->contains(QString("MainWindowState")))
+  if(cache->contains(SIMPLView::WindowSettings::GroupName, SIMPLView::WindowSettings::MainWindowState))
   {
-    QByteArray layout_data = prefs->value("MainWindowState", QByteArray());
+    QByteArray layout_data = cache->value(SIMPLView::WindowSettings::GroupName, SIMPLView::WindowSettings::MainWindowState, QByteArray()).toByteArray();
     restoreState(layout_data);
   }
+}
 
-  prefs->endGroup();
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::connectServices()
+{
+  if(m_ServicesConnected)
+  {
+    return;
+  }
+  m_ServicesConnected = true;
+
+  /* Documentation Requester connections */
+  DocRequestManager* docRequester = DocRequestManager::Instance();
+  connect(docRequester, SIGNAL(showFilterDocs(const QString&)), this, SLOT(showFilterHelp(const QString&)));
+  connect(docRequester, SIGNAL(showFilterDocUrl(const QUrl&)), this, SLOT(showFilterHelpUrl(const QUrl&)));
+
+  traceRecordingChanged(TraceRecorder::Instance()->isRecording());
+  connect(TraceRecorder::Instance(), &TraceRecorder::recordingChanged, this, &SIMPLView_UI::traceRecordingChanged);
+  metricsServerChanged(MetricsServer::Instance()->isEnabled());
+  connect(MetricsServer::Instance(), &MetricsServer::enabledChanged, this, &SIMPLView_UI::metricsServerChanged);
+  connect(PipelineMemoryGovernor::Instance(), &PipelineMemoryGovernor::stateChanged, this, &SIMPLView_UI::memoryGovernorStateChanged);
+
+  AsyncWriteService* writer = AsyncWriteService::Instance();
+  qint64 pendingBytes = 0;
+  int pendingWrites = writer->pendingWrites(&pendingBytes);
+  pendingWritesChanged(pendingWrites, pendingBytes);
+  connect(writer, &AsyncWriteService::jobFinished, this, &SIMPLView_UI::backgroundWriteFinished);
+  connect(writer, &AsyncWriteService::pendingChanged, this, &SIMPLView_UI::pendingWritesChanged);
 }
 
 // -----------------------------------------------------------------------------
@@ -460,15 +671,18 @@ void SIMPLView_UI::writeVersionCheckSettings()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::writeWindowSettings()
 {
-  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
+  // The application's spare window is not registered until it is handed out and must not overwrite the visible windows' layout
+  if(!dream3dApp->getSIMPLViewInstances().contains(this))
+  {
+    return;
+  }
 
-  prefs->beginGroup("WindowSettings");
-  QByteArray geo_data = saveGeometry();
-  QByteArray layout_data = saveState();
-  prefs->setValue(QString("MainWindowGeometry"), geo_data);
-  prefs->setValue(QString("MainWindowState"), layout_data);
+  EventLoopWatchdog::ActionScope watchdogScope("writeWindowSettings");
 
-  prefs->endGroup();
+  // This runs on every dock resize, so it only updates the in-memory cache; the cache writes the file later
+  SettingsCache* cache = SettingsCache::Instance();
+  cache->setValue(SIMPLView::WindowSettings::GroupName, SIMPLView::WindowSettings::MainWindowGeometry, saveGeometry());
+  cache->setValue(SIMPLView::WindowSettings::GroupName, SIMPLView::WindowSettings::MainWindowState, saveState());
 }
 
 // -----------------------------------------------------------------------------
@@ -509,9 +723,14 @@ void SIMPLView_UI::setupGui()
   // or load an entire pipeline into the view
   connectSignalsSlots();
 
-  // This will set the initial list of filters in the FilterListToolboxWidget
-  // Tell the Filter Library that we have more Filters (potentially)
-  m_Ui->filterLibraryWidget->refreshFilterGroups();
+  // The Filter Library sits behind the Filter List tab, so its tree is only built the first time it is shown
+  connect(m_Ui->filterLibraryDockWidget, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+    if(visible && !m_FilterLibraryLoaded)
+    {
+      m_FilterLibraryLoaded = true;
+      m_Ui->filterLibraryWidget->refreshFilterGroups();
+    }
+  });
 
   // Read the toolbox settings and update the filter list
   m_Ui->filterListWidget->loadFilterList();
@@ -537,6 +756,25 @@ void SIMPLView_UI::setupGui()
 
   //  m_StatusBar->readSettings();
 
+  // Live resource usage of the process; the sampler only runs while a monitor is visible
+  if(ResourceSampler::IsSupported())
+  {
+    m_ResourceMonitor = new ResourceMonitorWidget(this);
+    statusBar()->addPermanentWidget(m_ResourceMonitor);
+  }
+
+  m_EstimateLabel = new QLabel(this);
+  m_EstimateLabel->setVisible(false);
+  statusBar()->addPermanentWidget(m_EstimateLabel);
+
+  m_PendingWritesLabel = new QLabel(this);
+  m_PendingWritesLabel->setVisible(false);
+  statusBar()->addPermanentWidget(m_PendingWritesLabel);
+
+  m_PrefetchLabel = new QLabel(this);
+  m_PrefetchLabel->setVisible(false);
+  statusBar()->addPermanentWidget(m_PrefetchLabel);
+
   //  connect(m_Ui->issuesWidget, SIGNAL(tableHasErrors(bool, int, int)), m_StatusBar, SLOT(issuesTableHasErrors(bool, int, int)));
   connect(m_Ui->issuesWidget, SIGNAL(tableHasErrors(bool, int, int)), this, SLOT(issuesTableHasErrors(bool, int, int)));
   connect(m_Ui->issuesWidget, SIGNAL(showTable(bool)), m_Ui->issuesDockWidget, SLOT(setVisible(bool)));
@@ -606,6 +844,17 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_ActionCheckForUpdates = new QAction("Check For Updates", this);
   m_ActionPluginInformation = new QAction("Plugin Information", this);
   m_ActionClearCache = new QAction("Reset Preferences", this);
+  m_ActionShowMemoryUsage = new QAction("Memory Usage...", this);
+  m_ActionSetMemoryBudget = new QAction("Set Memory Budget...", this);
+  m_ActionShowEventLoopStalls = new QAction("Show Event Loop Stalls...", this);
+  m_ActionShowExecutionHistory = new QAction("Execution History...", this);
+  m_ActionRecordTrace = new QAction("Record Trace", this);
+  m_ActionRecordTrace->setCheckable(true);
+  m_ActionServeMetrics = new QAction("Serve Metrics on localhost", this);
+  m_ActionServeMetrics->setCheckable(true);
+  m_ActionReleaseArrays = new QAction("Release Unused Arrays During Execution", this);
+  m_ActionReleaseArrays->setCheckable(true);
+  m_ActionReleaseArrays->setChecked(PipelineArrayReleaser::IsEnabled());
 
   // SIMPLView_UI Actions
   connect(m_ActionNew, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenNewInstanceTriggered);
@@ -619,6 +868,31 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   connect(m_ActionShowSIMPLViewHelp, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenShowSIMPLViewHelpTriggered);
   connect(m_ActionPluginInformation, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenDisplayPluginInfoDialogTriggered);
   connect(m_ActionClearCache, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenClearSIMPLViewCacheTriggered);
+  connect(m_ActionShowMemoryUsage, &QAction::triggered, this, &SIMPLView_UI::showPipelineMemoryUsage);
+  connect(m_ActionSetMemoryBudget, &QAction::triggered, this, &SIMPLView_UI::setPipelineMemoryBudget);
+  connect(m_ActionShowEventLoopStalls, &QAction::triggered, this, &SIMPLView_UI::showEventLoopStalls);
+  connect(m_ActionShowExecutionHistory, &QAction::triggered, this, &SIMPLView_UI::showExecutionHistory);
+  connect(m_ActionRecordTrace, &QAction::toggled, this, &SIMPLView_UI::toggleTraceRecording);
+  connect(m_ActionServeMetrics, &QAction::toggled, this, &SIMPLView_UI::toggleMetricsServer);
+  connect(m_ActionReleaseArrays, &QAction::toggled, this, &SIMPLView_UI::toggleArrayReleasing);
+  m_ActionWatchInputs = new QAction("Watch Input Files", this);
+  m_ActionWatchInputs->setCheckable(true);
+  connect(m_ActionWatchInputs, &QAction::toggled, this, &SIMPLView_UI::toggleInputWatch);
+  m_ActionRunBatch = new QAction("Run on Multiple Inputs...", this);
+  connect(m_ActionRunBatch, &QAction::triggered, this, &SIMPLView_UI::runBatch);
+  m_ActionFindFilter = new QAction("Find Filter...", this);
+  m_ActionFindFilter->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_K));
+  connect(m_ActionFindFilter, &QAction::triggered, this, &SIMPLView_UI::findFilter);
+
+  // The data browser has no menu of its own; its context menu computes the current array
+  m_ActionComputeArray = new QAction("Compute This Array", this);
+  connect(m_ActionComputeArray, &QAction::triggered, this, &SIMPLView_UI::computeArray);
+  m_Ui->dataBrowserWidget->addAction(m_ActionComputeArray);
+  m_Ui->dataBrowserWidget->setContextMenuPolicy(Qt::ActionsContextMenu);
+  m_ActionPreview = new QAction("Preview Execution...", this);
+  connect(m_ActionPreview, &QAction::triggered, this, &SIMPLView_UI::previewPipeline);
+  m_ActionScrubParameter = new QAction("Scrub Parameter...", this);
+  connect(m_ActionScrubParameter, &QAction::triggered, this, &SIMPLView_UI::scrubParameter);
 
   m_ActionNew->setShortcut(QKeySequence::New);
   m_ActionOpen->setShortcut(QKeySequence::Open);
@@ -696,6 +970,17 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   // Create Pipeline Menu
   m_SIMPLViewMenu->addMenu(m_MenuPipeline);
   m_MenuPipeline->addAction(actionClearPipeline);
+  m_MenuPipeline->addAction(m_ActionFindFilter);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionShowMemoryUsage);
+  m_MenuPipeline->addAction(m_ActionReleaseArrays);
+  m_MenuPipeline->addAction(m_ActionComputeArray);
+  m_MenuPipeline->addAction(m_ActionPreview);
+  m_MenuPipeline->addAction(m_ActionScrubParameter);
+  m_MenuPipeline->addAction(m_ActionWatchInputs);
+  m_MenuPipeline->addAction(m_ActionRunBatch);
+  m_MenuPipeline->addAction(m_ActionShowExecutionHistory);
+  m_MenuPipeline->addAction(m_ActionRecordTrace);
 
   // Create Help Menu
   m_SIMPLViewMenu->addMenu(m_MenuHelp);
@@ -707,6 +992,9 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
 
   m_MenuHelp->addMenu(m_MenuAdvanced);
   m_MenuAdvanced->addAction(m_ActionClearCache);
+  m_MenuAdvanced->addAction(m_ActionSetMemoryBudget);
+  m_MenuAdvanced->addAction(m_ActionShowEventLoopStalls);
+  m_MenuAdvanced->addAction(m_ActionServeMetrics);
   m_MenuAdvanced->addSeparator();
   m_MenuAdvanced->addAction(actionClearBookmarks);
 
@@ -718,6 +1006,7 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
 
   connect(m_ActionSetDataFolder, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenSetDataFolderTriggered);
   connect(m_ActionShowDataFolder, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenShowDataFolderTriggered);
+  connect(m_MenuDataDirectory, &QMenu::aboutToShow, this, [this] { dream3dApp->trackFileStatus(m_ActionShowDataFolder, SIMPLDataPathValidator::Instance()->getSIMPLDataDirectory()); });
 
   m_MenuHelp->addSeparator();
   m_MenuHelp->addMenu(m_MenuDataDirectory);
@@ -740,12 +1029,6 @@ void SIMPLView_UI::connectSignalsSlots()
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
   PipelineModel* pipelineModel = pipelineView->getPipelineModel();
 
-  /* Documentation Requester connections */
-  DocRequestManager* docRequester = DocRequestManager::Instance();
-
-  connect(docRequester, SIGNAL(showFilterDocs(const QString&)), this, SLOT(showFilterHelp(const QString&)));
-  connect(docRequester, SIGNAL(showFilterDocUrl(const QUrl&)), this, SLOT(showFilterHelpUrl(const QUrl&)));
-
   /* Filter Library Widget Connections */
   connect(m_Ui->filterLibraryWidget, &FilterLibraryToolboxWidget::filterItemDoubleClicked, pipelineView, &SVPipelineView::addFilterFromClassName);
 
@@ -760,6 +1043,11 @@ void SIMPLView_UI::connectSignalsSlots()
 
   /* Pipeline List Widget Connections */
   connect(m_Ui->pipelineListWidget, &PipelineListWidget::pipelineCanceled, pipelineView, &SVPipelineView::cancelPipeline);
+  connect(m_Ui->pipelineListWidget, &PipelineListWidget::pipelineCanceled, [=] {
+    ExecutionEventLog::Instance()->record("cancel", m_ExecutionLogId, m_ExecutionRun.load(), -1);
+    m_CancelRequested = true;
+    PipelineMemoryGovernor::Instance()->cancelRequest(this);
+  });
 
   /* Pipeline View Connections */
   connect(pipelineView->selectionModel(), &QItemSelectionModel::selectionChanged, this, &SIMPLView_UI::filterSelectionChanged);
@@ -771,16 +1059,79 @@ void SIMPLView_UI::connectSignalsSlots()
   connect(pipelineView, &SVPipelineView::filterInputWidgetNeedsCleared, this, &SIMPLView_UI::clearFilterInputWidget);
   connect(pipelineView, &SVPipelineView::displayIssuesTriggered, m_Ui->issuesWidget, &IssuesWidget::displayCachedMessages);
   connect(pipelineView, &SVPipelineView::clearIssuesTriggered, m_Ui->issuesWidget, &IssuesWidget::clearIssues);
+  // The pipeline view clears the issues as the first step of every preflight
+  connect(pipelineView, &SVPipelineView::clearIssuesTriggered, [=] { m_PreflightStart = SVTrace::Now(); });
   connect(pipelineView, &SVPipelineView::writeSIMPLViewSettingsTriggered, [=] { writeSettings(); });
 
   // Connection that displays issues in the Issue Table when the preflight is finished
   connect(pipelineView, &SVPipelineView::preflightFinished, [=](FilterPipeline::Pointer pipeline, int err) {
-    m_Ui->dataBrowserWidget->refreshData();
+    EventLoopWatchdog::ActionScope watchdogScope("preflightFinished");
+
+    // The window that the application builds ahead of time preflights its empty pipeline before anyone sees it;
+    // only the windows that were handed out are reported to the services
+    if(m_PreflightStart > 0 && m_ServicesConnected)
+    {
+      qint64 preflightDuration = SVTrace::Now() - m_PreflightStart;
+      TraceRecorder::Instance()->addSpan("Preflight", "preflight", m_PreflightStart, preflightDuration);
+      MetricsServer::Instance()->observePreflight(preflightDuration / 1.0e9);
+    }
+    m_PreflightStart = 0;
+    SV_TRACE_SCOPE_CATEGORY("Preflight Finished", "ui");
+
+    {
+      SV_TRACE_SCOPE_CATEGORY("Data Browser Refresh", "ui");
+      setDataBrowserPreview(QString());
+      m_Ui->dataBrowserWidget->refreshData();
+    }
     m_Ui->issuesWidget->displayCachedMessages();
     m_Ui->pipelineListWidget->preflightFinished(pipeline, err);
+
+    // Every preflight refines the prediction that the memory governor admits the next execution with
+    if(m_ServicesConnected)
+    {
+      QString name = windowFilePath().isEmpty() ? tr("Untitled Pipeline") : QFileInfo(windowFilePath()).completeBaseName();
+      qint64 estimate = PipelineMemoryGovernor::EstimatePeakMemory(pipeline);
+      PipelineMemoryGovernor::Instance()->setEstimate(this, name, estimate);
+
+      QJsonObject fields;
+      fields["error"] = err;
+      fields["filters"] = (nullptr != pipeline.get()) ? pipeline->size() : 0;
+      fields["predicted_bytes"] = estimate;
+      ExecutionEventLog::Instance()->record("preflight", m_ExecutionLogId, 0, -1, fields);
+    }
+
+    // A preflight while the pipeline runs must not change the prediction the run is measured against
+    if(m_RunStart == 0)
+    {
+      m_Prediction = FilterTimingHistory::Instance()->predict(pipeline);
+      m_PipelineHash = PipelineHash(pipeline);
+      showPredictedRuntime();
+
+      m_PreflightedPipeline = (err >= 0) ? pipeline : FilterPipeline::Pointer();
+      m_ReleasePlanSummary.clear();
+      if(PipelineArrayReleaser::IsEnabled() && nullptr != m_PreflightedPipeline.get())
+      {
+        m_ReleasePlanSummary = PipelineDataFlow::Describe(m_ArrayReleaser->plan(pipeline));
+      }
+      else
+      {
+        m_ArrayReleaser->clear();
+      }
+      if(m_InputWatcher->isWatching() && nullptr != m_PreflightedPipeline.get())
+      {
+        m_InputWatcher->watch(m_PreflightedPipeline);
+      }
+      // The readers' files are known from here on; files that are already in the cache are skipped
+      if(nullptr != m_PreflightedPipeline.get() && InputPrefetcher::Budget() > 0)
+      {
+        m_Prefetcher->prefetch(InputPrefetcher::Files(m_PreflightedPipeline));
+      }
+    }
   });
 
-  connect(pipelineView, &SVPipelineView::pipelineHasMessage, this, &SIMPLView_UI::processPipelineMessage);
+  // The view hands the messages over on the GUI thread one at a time; they are queued here and handled in batches
+  connect(pipelineView, &SVPipelineView::pipelineHasMessage, this, &SIMPLView_UI::enqueuePipelineMessage);
+  connect(pipelineView, &SVPipelineView::pipelineStarted, this, &SIMPLView_UI::pipelineDidStart);
   connect(pipelineView, &SVPipelineView::pipelineFinished, this, &SIMPLView_UI::pipelineDidFinish);
   connect(pipelineView, &SVPipelineView::pipelineFilePathUpdated, this, &SIMPLView_UI::setWindowFilePath);
 
@@ -826,6 +1177,32 @@ void SIMPLView_UI::showDockWidget(QDockWidget* dockWidget)
 // -----------------------------------------------------------------------------
 int SIMPLView_UI::openPipeline(const QString& filePath)
 {
+  EventLoopWatchdog::ActionScope watchdogScope("openPipeline");
+
+  if(!PipelineLoader::CanLoad(filePath))
+  {
+    return openPipelineInView(filePath);
+  }
+
+  // The pipeline is parsed and its filters created in the background; pipelineLoaded() finishes the job
+  m_PipelineLoader->load(filePath);
+
+  QFileInfo fi(filePath);
+  setWindowTitle(QString("[*]") + fi.baseName() + " - " + QApplication::applicationName());
+  setWindowFilePath(filePath);
+  setWindowModified(false);
+  statusBar()->showMessage(tr("Loading pipeline '%1'...").arg(fi.fileName()));
+
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SIMPLView_UI::openPipelineInView(const QString& filePath)
+{
+  EventLoopWatchdog::ActionScope watchdogScope("openPipelineInView");
+
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
   int err = pipelineView->openPipeline(filePath);
   if (err >= 0)
@@ -846,6 +1223,57 @@ int SIMPLView_UI::openPipeline(const QString& filePath)
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineLoaded(const PipelineLoader::Result& result)
+{
+  EventLoopWatchdog::ActionScope watchdogScope("pipelineLoaded");
+  SV_TRACE_SCOPE_CATEGORY("Insert Pipeline", "ui");
+
+  if(result.err < 0 && PipelineBinaryFormat::IsBinaryPipelineFile(result.filePath))
+  {
+    // Only the loader understands binary pipelines so there is nothing to fall back to
+    statusBar()->clearMessage();
+    QMessageBox::critical(this, tr("Open Pipeline"), result.errorMessage, QMessageBox::Ok);
+  }
+  else if(result.err < 0)
+  {
+    // Let the pipeline view deal with anything the fast path does not understand, including its error reporting
+    openPipelineInView(result.filePath);
+  }
+  else
+  {
+    SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+
+    QElapsedTimer timer;
+    timer.start();
+    pipelineView->addPipeline(result.pipeline);
+
+    PipelineModel* model = pipelineView->getPipelineModel();
+    if(model->rowCount() > 0)
+    {
+      QModelIndex index = model->index(0, PipelineItem::PipelineItemData::Contents);
+      pipelineView->selectionModel()->select(index, QItemSelectionModel::ClearAndSelect);
+    }
+
+    PipelineLoader::Result timedResult = result;
+    timedResult.timings.insert = timer.elapsed();
+    addStdOutputMessage(PipelineLoader::FormatTimings(timedResult));
+    statusBar()->clearMessage();
+
+    m_LastOpenedFilePath = result.filePath;
+    setWindowFilePath(result.filePath);
+    setWindowModified(false);
+  }
+
+  if(m_ExecuteAfterLoad)
+  {
+    m_ExecuteAfterLoad = false;
+    executePipeline();
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -876,7 +1304,57 @@ void SIMPLView_UI::handlePipelineChanges()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::executePipeline()
 {
-  m_Ui->pipelineListWidget->getPipelineView()->executePipeline();
+  EventLoopWatchdog::ActionScope watchdogScope("executePipeline");
+
+  if(m_PipelineLoader->isLoading())
+  {
+    m_ExecuteAfterLoad = true;
+    return;
+  }
+
+  // The pipeline only starts once it fits into the memory that the other windows' pipelines leave over
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+  QJsonObject fields;
+  fields["file"] = windowFilePath();
+  fields["filters"] = getPipelineModel()->rowCount();
+  ExecutionEventLog::Instance()->record("execution_requested", m_ExecutionLogId, m_ExecutionRun.load(), -1, fields);
+
+  auto start = [this] {
+    SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+    m_GovernedStart = true;
+    pipelineView->executePipeline();
+    m_GovernedStart = false;
+    // A preflight error or an empty pipeline returns without a run, and then nothing may stay reserved
+    if(pipelineView->isPipelineCurrentlyRunning())
+    {
+      PipelineMemoryGovernor::Instance()->executionStarted(this);
+    }
+  };
+  if(!governor->requestExecution(this, start) && governor->isWaiting(this))
+  {
+    QJsonObject queued;
+    queued["reason"] = governor->waitingReason(this);
+    ExecutionEventLog::Instance()->record("execution_queued", m_ExecutionLogId, m_ExecutionRun.load(), -1, queued);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineDidStart()
+{
+  // Runs that executePipeline() did not start, such as the Start button's, are admitted here
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+  if(m_GovernedStart || governor->admits(this))
+  {
+    governor->executionStarted(this);
+    return;
+  }
+
+  // It does not fit: stopped before its first filter, it is requested again once it has finished
+  m_StartDeferred = true;
+  ExecutionEventLog::Instance()->record("execution_deferred", m_ExecutionLogId, m_ExecutionRun.load(), -1);
+  m_Ui->pipelineListWidget->getPipelineView()->cancelPipeline();
 }
 
 // -----------------------------------------------------------------------------
@@ -931,15 +1409,32 @@ void SIMPLView_UI::populateMenus(QObject* plugin)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::processPipelineMessage(const PipelineMessage& msg)
 {
+  // The messages count filters; once there is a runtime prediction the progress is weighted by it instead
+  bool weightedProgress = (m_RunStart > 0 && m_Prediction.total() > 0.0);
+
   if(msg.getType() == PipelineMessage::MessageType::ProgressValue)
   {
-    float progValue = static_cast<float>(msg.getProgressValue()) / 100;
-    m_Ui->pipelineListWidget->setProgressValue(progValue);
+    if(weightedProgress)
+    {
+      updateRunEstimate();
+    }
+    else
+    {
+      float progValue = static_cast<float>(msg.getProgressValue()) / 100;
+      m_Ui->pipelineListWidget->setProgressValue(progValue);
+    }
   }
   else if(msg.getType() == PipelineMessage::MessageType::StatusMessageAndProgressValue)
   {
-    float progValue = static_cast<float>(msg.getProgressValue()) / 100;
-    m_Ui->pipelineListWidget->setProgressValue(progValue);
+    if(weightedProgress)
+    {
+      updateRunEstimate();
+    }
+    else
+    {
+      float progValue = static_cast<float>(msg.getProgressValue()) / 100;
+      m_Ui->pipelineListWidget->setProgressValue(progValue);
+    }
 
     if(nullptr != this->statusBar())
     {
@@ -981,6 +1476,76 @@ void SIMPLView_UI::processPipelineMessage(const PipelineMessage& msg)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::pipelineDidFinish()
 {
+  EventLoopWatchdog::ActionScope watchdogScope("pipelineDidFinish");
+  SV_TRACE_SCOPE_CATEGORY("Pipeline Finished", "ui");
+
+  if(m_StartDeferred)
+  {
+    // The run was stopped by pipelineDidStart() and none of its messages were taken
+    m_StartDeferred = false;
+    m_Ui->pipelineListWidget->pipelineFinished();
+    if(!PipelineMemoryGovernor::Instance()->isWaiting(this))
+    {
+      executePipeline();
+    }
+    return;
+  }
+
+  // Everything the pipeline said before it finished has to be shown before it is reported as finished
+  drainPipelineMessages();
+  closeTraceFilterSpan();
+  finishTimedFilter(!m_CancelRequested && !m_RunFailed, SVTrace::Now());
+  MetricsServer::Instance()->pipelineFinished(m_CancelRequested);
+  FilterTimingHistory::Instance()->save();
+  // The run may have rewritten files that the state kept for computing single arrays was read from
+  m_SliceRunner->clearCache();
+  if(m_RunStart > 0)
+  {
+    // Handed to the history's writer thread; nothing here waits for the database
+    ExecutionHistory::Run run;
+    run.started = m_RunStarted;
+    run.pipelineHash = m_PipelineHash;
+    run.pipelineName = windowFilePath().isEmpty() ? tr("Untitled Pipeline") : QFileInfo(windowFilePath()).completeBaseName();
+    run.host = QSysInfo::machineHostName();
+    run.version = SIMPLView::Version::Complete();
+    run.pluginVersions = PluginVersions(m_LoadedPlugins);
+    run.inputTuples = m_Prediction.tuples;
+    run.seconds = (SVTrace::Now() - m_RunStart) / 1.0e9;
+    run.peakMemory = qMax(m_RunPeakMemory, ResourceSampler::CurrentResidentBytes());
+    run.status = m_CancelRequested ? "canceled" : (m_RunFailed ? "failed" : "finished");
+    run.filters = m_RunFilters;
+    ExecutionHistory::Instance()->record(run);
+  }
+  if(m_RunStart > 0 && !m_CancelRequested && !m_RunFailed && m_Prediction.isValid())
+  {
+    addStdOutputMessage(tr("The pipeline took %1; %2 was predicted")
+                            .arg(FilterTimingHistory::FormatDuration((SVTrace::Now() - m_RunStart) / 1.0e9))
+                            .arg(FilterTimingHistory::FormatDuration(m_Prediction.total())));
+  }
+  qint64 releasedBytes = 0;
+  int releasedArrays = m_ArrayReleaser->takeReleased(&releasedBytes);
+  if(releasedArrays > 0)
+  {
+    addStdOutputMessage(tr("Released %1 intermediate arrays (%2) after their last use").arg(releasedArrays).arg(PipelineMemoryGovernor::FormatBytes(releasedBytes)));
+  }
+  m_EstimateTimer->stop();
+  m_RunStart = 0;
+  m_RunFilters.clear();
+  m_RunPeakMemory = 0;
+  m_CompletedPredicted = 0.0;
+  m_CompletedActual = 0.0;
+  m_CancelRequested = false;
+  m_RunFailed = false;
+  showPredictedRuntime();
+  startWatchRun();
+
+  PipelineMessageQueue::Statistics stats = m_MessageQueue.statistics();
+  m_MessageQueue.resetStatistics();
+
+  QJsonObject fields;
+  fields["messages"] = static_cast<qint64>(stats.pushed);
+  ExecutionEventLog::Instance()->record("execution_finished", m_ExecutionLogId, m_ExecutionRun.fetch_add(1), -1, fields);
+
   // Re-enable FilterListToolboxWidget signals - resume adding filters
   m_Ui->filterListWidget->blockSignals(false);
 
@@ -1004,13 +1569,931 @@ void SIMPLView_UI::pipelineDidFinish()
   }
 
   m_Ui->pipelineListWidget->pipelineFinished();
+
+  PipelineMemoryGovernor::Instance()->executionFinished(this);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLView_UI::showFilterHelp(const QString& className)
+void SIMPLView_UI::enqueuePipelineMessage(const PipelineMessage& msg)
+{
+  if(m_StartDeferred)
+  {
+    return;
+  }
+
+  ExecutionEventLog::Instance()->recordMessage(m_ExecutionLogId, m_ExecutionRun.load(), msg);
+  if(TraceRecorder::Instance()->isRecording())
+  {
+    traceFilterMessage(msg);
+  }
+
+  // A burst of messages costs one pass over the widgets, but errors and warnings are shown right away
+  m_MessageQueue.push(msg, SVTrace::Now());
+  if(msg.getType() == PipelineMessage::MessageType::Error || msg.getType() == PipelineMessage::MessageType::Warning)
+  {
+    m_MessageDrainTimer->stop();
+    drainPipelineMessages();
+  }
+  else if(!m_MessageDrainTimer->isActive())
+  {
+    m_MessageDrainTimer->start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::drainPipelineMessages()
+{
+  QVector<PipelineMessageQueue::Entry> messages;
+  if(m_MessageQueue.drain(messages) == 0)
+  {
+    return;
+  }
+  SV_TRACE_SCOPE_CATEGORY("Pipeline Message Batch", "ui");
+
+  int lastProgress = -1;
+  for(int i = 0; i < messages.size(); i++)
+  {
+    if(PipelineMessageQueue::IsProgressOnly(messages[i].message))
+    {
+      lastProgress = i;
+    }
+  }
+
+  for(int i = 0; i < messages.size(); i++)
+  {
+    // Every message counts for the filter durations, including the progress updates that are not shown
+    timeFilterMessage(messages[i].message, messages[i].received);
+    if(PipelineMessageQueue::IsProgressOnly(messages[i].message) && i != lastProgress)
+    {
+      continue;
+    }
+    processPipelineMessage(messages[i].message);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::traceFilterMessage(const PipelineMessage& msg)
+{
+  int index = msg.getPipelineIndex();
+  if(index < 0 || index == m_TraceFilterIndex)
+  {
+    return;
+  }
+
+  closeTraceFilterSpan();
+  m_TraceFilterIndex = index;
+  m_TraceFilterStart = SVTrace::Now();
+  m_TraceFilterLabel = msg.getFilterHumanLabel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::closeTraceFilterSpan()
 {
+  if(m_TraceFilterIndex < 0)
+  {
+    return;
+  }
+
+  TraceRecorder* recorder = TraceRecorder::Instance();
+  if(m_TraceFilterLane < 0)
+  {
+    m_TraceFilterLane = recorder->addLane(tr("Pipeline Filters"));
+  }
+  QString name = QString("[%1] %2").arg(m_TraceFilterIndex).arg(m_TraceFilterLabel);
+  recorder->addSpan(name, "filter", m_TraceFilterStart, SVTrace::Now() - m_TraceFilterStart, m_TraceFilterLane);
+  m_TraceFilterIndex = -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::timeFilterMessage(const PipelineMessage& msg, qint64 received)
+{
+  if(msg.getType() == PipelineMessage::MessageType::Error)
+  {
+    m_RunFailed = true;
+  }
+
+  int index = msg.getPipelineIndex();
+  if(index < 0 || index == m_TimedFilterIndex)
+  {
+    return;
+  }
+
+  finishTimedFilter(true, received);
+  m_TimedFilterIndex = index;
+  m_TimedFilterStart = received;
+  m_TimedFilterClass = msg.getFilterClassName();
+
+  if(m_RunStart == 0)
+  {
+    m_RunStart = m_TimedFilterStart;
+    m_RunStarted = QDateTime::currentDateTime();
+    m_EstimateTimer->start();
+    if(!m_ReleasePlanSummary.isEmpty())
+    {
+      addStdOutputMessage(m_ReleasePlanSummary);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::finishTimedFilter(bool completed, qint64 finished)
+{
+  if(m_TimedFilterIndex < 0)
+  {
+    return;
+  }
+
+  double seconds = (finished - m_TimedFilterStart) / 1.0e9;
+  MetricsServer::Instance()->observeFilter(m_TimedFilterClass, seconds);
+
+  // A canceled or failed filter did not do all of its work, so it would teach the history a wrong runtime
+  if(completed)
+  {
+    FilterTimingHistory::Instance()->record(m_TimedFilterClass, seconds, m_Prediction.tuples);
+  }
+  m_CompletedPredicted += m_Prediction.filterSeconds.value(m_TimedFilterIndex);
+  m_CompletedActual += seconds;
+
+  ExecutionHistory::FilterTiming timing;
+  timing.index = m_TimedFilterIndex;
+  timing.className = m_TimedFilterClass;
+  timing.seconds = seconds;
+  m_RunFilters.push_back(timing);
+  m_RunPeakMemory = qMax(m_RunPeakMemory, ResourceSampler::CurrentResidentBytes());
+  m_TimedFilterIndex = -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updateRunEstimate()
+{
+  // The resident memory is sampled on the same beat for the peak that the execution history records
+  if(m_RunStart > 0)
+  {
+    m_RunPeakMemory = qMax(m_RunPeakMemory, ResourceSampler::CurrentResidentBytes());
+  }
+
+  double total = m_Prediction.total();
+  if(m_RunStart == 0 || m_TimedFilterIndex < 0 || total <= 0.0)
+  {
+    return;
+  }
+
+  // How much faster or slower than predicted this run is so far; it scales what remains
+  double speed = 1.0;
+  if(m_CompletedPredicted > 0.0)
+  {
+    speed = qBound(0.25, m_CompletedActual / m_CompletedPredicted, 4.0);
+  }
+
+  double current = m_Prediction.filterSeconds.value(m_TimedFilterIndex);
+  double elapsed = (SVTrace::Now() - m_TimedFilterStart) / 1.0e9;
+  double done = m_CompletedPredicted + qMin(elapsed / speed, current);
+  double remaining = qMax(current * speed - elapsed, 0.0) + qMax(total - m_CompletedPredicted - current, 0.0) * speed;
+
+  m_Ui->pipelineListWidget->setProgressValue(static_cast<float>(qBound(0.0, done / total, 1.0)));
+  m_EstimateLabel->setText(tr("ETA %1").arg(FilterTimingHistory::FormatDuration(remaining)));
+  m_EstimateLabel->setToolTip(tr("Running for %1, about %2 left").arg(FilterTimingHistory::FormatDuration((SVTrace::Now() - m_RunStart) / 1.0e9)).arg(FilterTimingHistory::FormatDuration(remaining)));
+  m_EstimateLabel->setVisible(true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showPredictedRuntime()
+{
+  if(!m_Prediction.isValid())
+  {
+    m_EstimateLabel->setVisible(false);
+    return;
+  }
+
+  QString tip = tr("Predicted from earlier runs, scaled to %1 tuples").arg(m_Prediction.tuples);
+  if(m_Prediction.unknownFilters > 0)
+  {
+    tip += tr("\n%1 filters have not run before; they count as typical filters of this pipeline").arg(m_Prediction.unknownFilters);
+  }
+  m_EstimateLabel->setText(tr("Predicted runtime %1").arg(FilterTimingHistory::FormatDuration(m_Prediction.total())));
+  m_EstimateLabel->setToolTip(tip);
+  m_EstimateLabel->setVisible(true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::toggleTraceRecording(bool record)
+{
+  TraceRecorder* recorder = TraceRecorder::Instance();
+  if(record)
+  {
+    recorder->start();
+    addStdOutputMessage(tr("Recording a trace. Uncheck Pipeline > Record Trace to save it."));
+    return;
+  }
+
+  if(!recorder->isRecording())
+  {
+    return;
+  }
+  recorder->stop();
+
+  QString fileName = QString("%1-Trace-%2.json").arg(QApplication::applicationName()).arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+  QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/" + fileName;
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Save Trace"), defaultPath, tr("Trace Event File (*.json)"));
+  if(filePath.isEmpty())
+  {
+    addStdOutputMessage(tr("The trace was discarded"));
+    return;
+  }
+
+  QString errorMessage;
+  if(!recorder->write(filePath, &errorMessage))
+  {
+    QMessageBox::critical(this, tr("Save Trace"), tr("The trace could not be written to '%1': %2").arg(filePath).arg(errorMessage));
+    return;
+  }
+
+  QString message = tr("Saved %1 spans to '%2'. Open the file in Perfetto (ui.perfetto.dev) or chrome://tracing.").arg(recorder->getSpanCount()).arg(filePath);
+  if(recorder->getDroppedCount() > 0)
+  {
+    message += tr(" %1 spans were dropped because the trace was full.").arg(recorder->getDroppedCount());
+  }
+  addStdOutputMessage(message);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::traceRecordingChanged(bool recording)
+{
+  QSignalBlocker blocker(m_ActionRecordTrace);
+  m_ActionRecordTrace->setChecked(recording);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::toggleMetricsServer(bool serve)
+{
+  MetricsServer* server = MetricsServer::Instance();
+  QString errorMessage;
+  if(!server->setEnabled(serve, &errorMessage))
+  {
+    QMessageBox::critical(this, tr("Serve Metrics"), tr("The metrics server could not start.\n\n%1").arg(errorMessage));
+    QSignalBlocker blocker(m_ActionServeMetrics);
+    m_ActionServeMetrics->setChecked(false);
+    return;
+  }
+
+  if(serve)
+  {
+    addStdOutputMessage(tr("Serving metrics at http://127.0.0.1:%1/metrics").arg(server->getPort()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::metricsServerChanged(bool enabled)
+{
+  QSignalBlocker blocker(m_ActionServeMetrics);
+  m_ActionServeMetrics->setChecked(enabled);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataArrayPath SIMPLView_UI::selectedDataBrowserArray() const
+{
+  QTreeView* treeView = m_Ui->dataBrowserWidget->findChild<QTreeView*>();
+  if(nullptr == treeView)
+  {
+    return DataArrayPath();
+  }
+
+  // Data containers, attribute matrices and arrays are the three levels of the data browser's tree
+  QStringList names;
+  for(QModelIndex index = treeView->currentIndex(); index.isValid(); index = index.parent())
+  {
+    names.push_front(index.data(Qt::DisplayRole).toString());
+  }
+  return (names.size() == 3) ? DataArrayPath(names[0], names[1], names[2]) : DataArrayPath();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::computeArray()
+{
+  if(m_SliceRunner->isRunning())
+  {
+    if(QMessageBox::question(this, tr("Compute Array"), tr("An array is being computed. Do you want to cancel it?")) == QMessageBox::Yes)
+    {
+      m_SliceRunner->cancel();
+    }
+    return;
+  }
+
+  if(nullptr == m_PreflightedPipeline.get())
+  {
+    QMessageBox::information(this, tr("Compute Array"), tr("The pipeline has to preflight without errors before an array can be computed."));
+    return;
+  }
+
+  QVector<DataArrayPath> paths = PipelineDataFlow::ArrayPaths(m_PreflightedPipeline);
+  DataArrayPath target = selectedDataBrowserArray();
+  if(!paths.contains(target))
+  {
+    QStringList items;
+    for(const DataArrayPath& path : paths)
+    {
+      items.push_back(path.serialize("/"));
+    }
+    bool ok = false;
+    QString item = QInputDialog::getItem(this, tr("Compute Array"), tr("Array:"), items, 0, false, &ok);
+    if(!ok || items.indexOf(item) < 0)
+    {
+      return;
+    }
+    target = paths[items.indexOf(item)];
+  }
+
+  if(!m_SliceRunner->compute(m_PreflightedPipeline, target))
+  {
+    addStdOutputMessage(tr("No enabled filter creates %1").arg(target.serialize("/")));
+    return;
+  }
+  addStdOutputMessage(tr("Computing %1 without the filters it does not depend on").arg(target.serialize("/")));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::arrayComputed(const PipelineSliceRunner::Result& result)
+{
+  statusBar()->clearMessage();
+  if(result.scrub)
+  {
+    // The scrub dialog reports its own runs
+    return;
+  }
+  if(result.rerun)
+  {
+    QString status = result.canceled ? "canceled" : (result.err < 0 ? "failed" : "finished");
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QJsonObject fields;
+    fields["trigger"] = QJsonArray::fromStringList(m_WatchChanges.paths);
+    fields["status"] = status;
+    fields["filters_run"] = result.filtersRun;
+    fields["filters_reused"] = result.filtersReused;
+    fields["waited_ms"] = m_WatchRunStarted - m_WatchChanges.lastChange;
+    fields["run_ms"] = result.milliseconds;
+    fields["latency_ms"] = now - m_WatchChanges.firstChange;
+    ExecutionEventLog::Instance()->record("watch_rerun", m_ExecutionLogId, m_ExecutionRun.load(), -1, fields);
+
+    QString trigger = m_WatchChanges.paths.join(", ");
+    if(result.err < 0 || result.canceled)
+    {
+      addStdOutputMessage(tr("The rerun after %1 changed was %2. %3").arg(trigger).arg(status).arg(result.errorMessage));
+      return;
+    }
+    addStdOutputMessage(tr("Reran after %1 changed: %2 of %3 filters ran in %4 ms, %5 were reused; waited %6 ms, %7 ms after the first change")
+                            .arg(trigger)
+                            .arg(result.filtersRun)
+                            .arg(result.filtersInPipeline)
+                            .arg(result.milliseconds)
+                            .arg(result.filtersReused)
+                            .arg(m_WatchRunStarted - m_WatchChanges.lastChange)
+                            .arg(now - m_WatchChanges.firstChange));
+    return;
+  }
+  if(result.preview)
+  {
+    if(result.canceled || result.err < 0)
+    {
+      addStdOutputMessage(result.canceled ? tr("The preview was canceled") : tr("The preview failed. %1").arg(result.errorMessage));
+      return;
+    }
+
+    // The data browser shows the data structure of a filter, so a stand-in filter carries the preview's
+    if(nullptr != m_PreflightedPipeline.get() && !m_PreflightedPipeline->getFilterContainer().isEmpty())
+    {
+      m_PreviewHolder = m_PreflightedPipeline->getFilterContainer().back()->newFilterInstance(false);
+      m_PreviewHolder->setDataContainerArray(result.dca);
+      m_Ui->dataBrowserWidget->filterActivated(m_PreviewHolder);
+      setDataBrowserPreview(PipelinePreview::Describe(m_PreviewSettings));
+    }
+    addStdOutputMessage(tr("Preview at %1 finished in %2 ms: %3 of %4 filters ran; writers were skipped")
+                            .arg(PipelinePreview::Describe(m_PreviewSettings))
+                            .arg(result.milliseconds)
+                            .arg(result.filtersRun)
+                            .arg(result.filtersInPipeline));
+    return;
+  }
+
+  QString path = result.target.serialize("/");
+  if(result.canceled)
+  {
+    addStdOutputMessage(tr("Computing %1 was canceled").arg(path));
+    return;
+  }
+  if(result.err < 0)
+  {
+    addStdOutputMessage(tr("Computing %1 failed. %2").arg(path).arg(result.errorMessage));
+    return;
+  }
+
+  addStdOutputMessage(tr("Computed %1 (%2 tuples, %3 components, %4) in %5 ms: %6 of %7 filters ran, %8 were reused from the previous computation")
+                          .arg(path)
+                          .arg(result.array->getNumberOfTuples())
+                          .arg(result.array->getNumberOfComponents())
+                          .arg(PipelineMemoryGovernor::FormatBytes(PipelineMemoryGovernor::ArrayBytes(result.array)))
+                          .arg(result.milliseconds)
+                          .arg(result.filtersRun)
+                          .arg(result.filtersInPipeline)
+                          .arg(result.filtersReused));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::previewPipeline()
+{
+  if(m_SliceRunner->isRunning())
+  {
+    if(QMessageBox::question(this, tr("Preview Execution"), tr("A preview or array computation is running. Do you want to cancel it?")) == QMessageBox::Yes)
+    {
+      m_SliceRunner->cancel();
+    }
+    return;
+  }
+
+  if(nullptr == m_PreflightedPipeline.get())
+  {
+    QMessageBox::information(this, tr("Preview Execution"), tr("The pipeline has to preflight without errors before it can be previewed."));
+    return;
+  }
+
+  PreviewPipelineDialog dialog(m_PreviewSettings, this);
+  if(dialog.exec() != QDialog::Accepted)
+  {
+    return;
+  }
+  m_PreviewSettings = dialog.getSettings();
+
+  if(!m_SliceRunner->preview(m_PreflightedPipeline, m_PreviewSettings))
+  {
+    QMessageBox::information(this, tr("Preview Execution"), tr("A preview needs a pipeline that starts with a reader filter."));
+    return;
+  }
+  addStdOutputMessage(tr("Previewing the pipeline at %1").arg(PipelinePreview::Describe(m_PreviewSettings)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::scrubParameter()
+{
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
+  if(nullptr == m_PreflightedPipeline.get() || selectedIndexes.size() != 1)
+  {
+    QMessageBox::information(this, tr("Scrub Parameter"), tr("Select one filter of a pipeline that preflights without errors to scrub its parameters."));
+    return;
+  }
+  if(pipelineView->isPipelineCurrentlyRunning())
+  {
+    return;
+  }
+
+  AbstractFilter::Pointer filter = getPipelineModel()->filter(selectedIndexes[0]);
+  int index = m_PreflightedPipeline->getFilterContainer().indexOf(filter);
+  if(index < 0)
+  {
+    return;
+  }
+  if(ScrubParameterDialog::NumericProperties(filter).isEmpty())
+  {
+    QMessageBox::information(this, tr("Scrub Parameter"), tr("%1 has no numeric parameters.").arg(filter->getHumanLabel()));
+    return;
+  }
+
+  ScrubParameterDialog dialog(m_PreflightedPipeline, index, m_SliceRunner, m_PreviewSettings, this);
+  connect(&dialog, &ScrubParameterDialog::previewAvailable, this, [=](DataContainerArray::Pointer dca, const QString& description) {
+    m_PreviewHolder = filter->newFilterInstance(false);
+    m_PreviewHolder->setDataContainerArray(dca);
+    m_Ui->dataBrowserWidget->filterActivated(m_PreviewHolder);
+    setDataBrowserPreview(description);
+  });
+
+  bool apply = (dialog.exec() == QDialog::Accepted);
+  if(m_SliceRunner->isRunning())
+  {
+    m_SliceRunner->cancel();
+  }
+  setDataBrowserPreview(QString());
+  m_Ui->dataBrowserWidget->filterActivated(filter);
+  if(!apply)
+  {
+    return;
+  }
+
+  QVariant scrubbed = dialog.getValue();
+  filter->setProperty(dialog.getPropertyName().toLatin1().constData(), scrubbed);
+  markDocumentAsDirty();
+  QMetaObject::invokeMethod(pipelineView, "preflightPipeline");
+  addStdOutputMessage(tr("Set %1 of %2 to %3").arg(dialog.getParameterLabel()).arg(filter->getHumanLabel()).arg(scrubbed.toString()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::toggleInputWatch(bool watch)
+{
+  if(!watch)
+  {
+    m_InputWatcher->stop();
+    return;
+  }
+
+  int count = (nullptr != m_PreflightedPipeline.get()) ? m_InputWatcher->watch(m_PreflightedPipeline) : 0;
+  if(count == 0)
+  {
+    m_InputWatcher->stop();
+    QSignalBlocker blocker(m_ActionWatchInputs);
+    m_ActionWatchInputs->setChecked(false);
+    QMessageBox::information(this, tr("Watch Input Files"), tr("None of the reader filters of the pipeline reads an existing file or directory, or the pipeline does not preflight."));
+    return;
+  }
+  addStdOutputMessage(tr("Watching %1 input files and directories; when they change, the filters that depend on them run again").arg(count));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::startWatchRun()
+{
+  if(!m_InputWatcher->hasChanges() || m_SliceRunner->isRunning() || nullptr == m_PreflightedPipeline.get())
+  {
+    return;
+  }
+  if(m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning())
+  {
+    return;
+  }
+
+  m_WatchChanges = m_InputWatcher->takeChanges();
+  m_WatchRunStarted = QDateTime::currentMSecsSinceEpoch();
+  if(!m_SliceRunner->rerun(m_PreflightedPipeline, m_WatchChanges.filterIndices))
+  {
+    addStdOutputMessage(tr("%1 changed, but none of the filters that read it is enabled").arg(m_WatchChanges.paths.join(", ")));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::runBatch()
+{
+  if(m_BatchRunner->isRunning())
+  {
+    if(QMessageBox::question(this, tr("Run on Multiple Inputs"), tr("A batch is running. Do you want to cancel it?")) == QMessageBox::Yes)
+    {
+      m_BatchRunner->cancel();
+    }
+    return;
+  }
+
+  // Only a reader parameter that names a single file can be pointed at each input in turn
+  QVector<InputFileWatcher::Input> inputs;
+  for(const InputFileWatcher::Input& input : InputFileWatcher::Inputs(m_PreflightedPipeline))
+  {
+    if(!input.directory)
+    {
+      inputs.push_back(input);
+    }
+  }
+  if(inputs.isEmpty())
+  {
+    QMessageBox::information(this, tr("Run on Multiple Inputs"), tr("The pipeline has to preflight without errors and start with a reader that reads an existing file."));
+    return;
+  }
+
+  InputFileWatcher::Input input = inputs[0];
+  if(inputs.size() > 1)
+  {
+    QStringList items;
+    for(const InputFileWatcher::Input& candidate : inputs)
+    {
+      AbstractFilter::Pointer filter = m_PreflightedPipeline->getFilterContainer()[candidate.filterIndex];
+      items.push_back(QString("%1: %2 (%3)").arg(filter->getHumanLabel()).arg(candidate.propertyName).arg(QFileInfo(candidate.path).fileName()));
+    }
+    bool ok = false;
+    QString item = QInputDialog::getItem(this, tr("Run on Multiple Inputs"), tr("Input to replace:"), items, 0, false, &ok);
+    if(!ok || items.indexOf(item) < 0)
+    {
+      return;
+    }
+    input = inputs[items.indexOf(item)];
+  }
+
+  QFileInfo current(input.path);
+  QString filter = current.suffix().isEmpty() ? tr("All Files (*.*)") : tr("%1 Files (*.%1);;All Files (*.*)").arg(current.suffix());
+  QStringList files = QFileDialog::getOpenFileNames(this, tr("Select the Inputs"), current.absolutePath(), filter);
+  if(files.isEmpty())
+  {
+    return;
+  }
+
+  if(!m_BatchRunner->start(m_PreflightedPipeline, input.filterIndex, input.propertyName, files))
+  {
+    return;
+  }
+  if(InputPrefetcher::Budget() > 0)
+  {
+    m_Prefetcher->prefetch(files);
+  }
+  addStdOutputMessage(tr("Running the pipeline on %1 inputs; each writer's files get the input's name appended, for example %2")
+                          .arg(files.size())
+                          .arg(QFileInfo(BatchPipelineRunner::OutputPath("Output.dream3d", files[0])).fileName()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::batchDatasetFinished(const BatchPipelineRunner::Dataset& dataset, int done, int count)
+{
+  QString name = QFileInfo(dataset.input).fileName();
+  if(dataset.err < 0)
+  {
+    addStdOutputMessage(tr("Batch %1 of %2: %3 failed. %4").arg(done).arg(count).arg(name).arg(dataset.errorMessage));
+  }
+  else
+  {
+    addStdOutputMessage(tr("Batch %1 of %2: %3 read in %4 ms, computed in %5 ms, written in %6 ms")
+                            .arg(done)
+                            .arg(count)
+                            .arg(name)
+                            .arg(dataset.readMilliseconds)
+                            .arg(dataset.computeMilliseconds)
+                            .arg(dataset.writeMilliseconds));
+  }
+  statusBar()->showMessage(tr("Batch: %1 of %2 datasets done").arg(done).arg(count));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::batchFinished(const BatchPipelineRunner::Summary& summary)
+{
+  statusBar()->clearMessage();
+  qint64 stages = summary.readMilliseconds + summary.computeMilliseconds + summary.writeMilliseconds;
+  addStdOutputMessage(tr("The batch %1 after %2: %3 of %4 datasets succeeded, %5 failed. The stages took %6 together, %7 of which overlapped.")
+                          .arg(summary.canceled ? tr("was canceled") : tr("finished"))
+                          .arg(FilterTimingHistory::FormatDuration(summary.milliseconds / 1000.0))
+                          .arg(summary.succeeded)
+                          .arg(summary.datasets)
+                          .arg(summary.failed)
+                          .arg(FilterTimingHistory::FormatDuration(stages / 1000.0))
+                          .arg(FilterTimingHistory::FormatDuration(qMax(qint64(0), stages - summary.milliseconds) / 1000.0)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::backgroundWriteFinished(const AsyncWriteService::Result& result)
+{
+  if(result.owner != m_BatchRunner || !result.write || result.canceled)
+  {
+    return;
+  }
+
+  if(result.err < 0)
+  {
+    addStdOutputMessage(tr("Writing %1 in the background failed. %2").arg(result.label).arg(result.errorMessage));
+    return;
+  }
+  addStdOutputMessage(tr("Wrote %1 (%2) in the background in %3 ms, %4/s")
+                          .arg(result.label)
+                          .arg(PipelineMemoryGovernor::FormatBytes(result.bytes))
+                          .arg(result.milliseconds)
+                          .arg(PipelineMemoryGovernor::FormatBytes(static_cast<qint64>(result.bytesPerSecond()))));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pendingWritesChanged(int writes, qint64 bytes)
+{
+  m_PendingWritesLabel->setVisible(writes > 0);
+  m_PendingWritesLabel->setText(tr("Writing: %1 pending (%2)").arg(writes).arg(PipelineMemoryGovernor::FormatBytes(bytes)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::prefetchProgress(qint64 done, qint64 total)
+{
+  m_PrefetchLabel->setVisible(true);
+  m_PrefetchLabel->setText(tr("Prefetching inputs: %1% of %2").arg(total > 0 ? done * 100 / total : 100).arg(PipelineMemoryGovernor::FormatBytes(total)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::prefetchFinished(qint64 bytes, qint64 milliseconds, bool canceled)
+{
+  m_PrefetchLabel->setVisible(false);
+  if(canceled || bytes == 0)
+  {
+    return;
+  }
+  qint64 bytesPerSecond = (milliseconds > 0) ? bytes * 1000 / milliseconds : 0;
+  addStdOutputMessage(tr("Prefetched %1 of input files in %2 ms, %3/s")
+                          .arg(PipelineMemoryGovernor::FormatBytes(bytes))
+                          .arg(milliseconds)
+                          .arg(PipelineMemoryGovernor::FormatBytes(bytesPerSecond)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::findFilter()
+{
+  if(nullptr == m_FilterSearchDialog)
+  {
+    m_FilterSearchDialog = new FilterSearchDialog(this);
+    connect(m_FilterSearchDialog, &FilterSearchDialog::filterChosen, this, [this](const QString& className) {
+      m_Ui->pipelineListWidget->getPipelineView()->addFilterFromClassName(className);
+    });
+  }
+  m_FilterSearchDialog->show();
+  m_FilterSearchDialog->raise();
+  m_FilterSearchDialog->activateWindow();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::setDataBrowserPreview(const QString& description)
+{
+  if(m_DataBrowserTitle.isEmpty())
+  {
+    m_DataBrowserTitle = m_Ui->dataBrowserDockWidget->windowTitle();
+  }
+
+  if(description.isEmpty())
+  {
+    m_PreviewHolder = AbstractFilter::NullPointer();
+    m_Ui->dataBrowserDockWidget->setWindowTitle(m_DataBrowserTitle);
+    return;
+  }
+  m_Ui->dataBrowserDockWidget->setWindowTitle(tr("%1 (Preview, %2)").arg(m_DataBrowserTitle).arg(description));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::toggleArrayReleasing(bool release)
+{
+  PipelineArrayReleaser::SetEnabled(release);
+  m_ArrayReleaser->clear();
+  m_ReleasePlanSummary.clear();
+
+  // Released arrays are gone from the data structure when the run ends, so the option stays off by default
+  if(release && nullptr != m_PreflightedPipeline.get() && m_RunStart == 0)
+  {
+    m_ReleasePlanSummary = PipelineDataFlow::Describe(m_ArrayReleaser->plan(m_PreflightedPipeline));
+    addStdOutputMessage(m_ReleasePlanSummary);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::memoryGovernorStateChanged()
+{
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+  if(governor->isWaiting(this))
+  {
+    statusBar()->showMessage(governor->waitingReason(this));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showPipelineMemoryUsage()
+{
+  QMessageBox::information(this, tr("Pipeline Memory Usage"), PipelineMemoryGovernor::Instance()->statusReport(), QMessageBox::Ok);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showEventLoopStalls()
+{
+  QString reports = EventLoopWatchdog::ReadReports();
+
+  QDialog dialog(this);
+  dialog.setWindowTitle(tr("Event Loop Stalls"));
+  dialog.resize(900, 600);
+
+  QVBoxLayout* layout = new QVBoxLayout(&dialog);
+  QLabel* summaryLabel = new QLabel(EventLoopWatchdog::Summarize(reports), &dialog);
+  summaryLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  layout->addWidget(summaryLabel);
+
+  QPlainTextEdit* reportsEdit = new QPlainTextEdit(&dialog);
+  reportsEdit->setReadOnly(true);
+  reportsEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+  reportsEdit->setPlainText(reports);
+  layout->addWidget(reportsEdit);
+
+  QLabel* pathLabel = new QLabel(tr("Reports are written to %1").arg(QDir::toNativeSeparators(EventLoopWatchdog::ReportFilePath())), &dialog);
+  pathLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  layout->addWidget(pathLabel);
+
+  QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Close, &dialog);
+  connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+  layout->addWidget(buttons);
+
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showExecutionHistory()
+{
+  const QString connectionName("ExecutionHistoryView");
+  QString filePath = ExecutionHistory::DatabasePath();
+  QString errorMessage;
+  if(!QFileInfo(filePath).isFile() || !ExecutionHistory::OpenReadOnly(connectionName, filePath, &errorMessage))
+  {
+    ExecutionHistory::Close(connectionName);
+    QString reason = errorMessage.isEmpty() ? tr("No pipeline has been executed yet.") : errorMessage;
+    QMessageBox::information(this, tr("Execution History"), tr("The execution history could not be read.\n\n%1").arg(reason));
+    return;
+  }
+
+  QVector<ExecutionHistory::Run> runs;
+  QVector<ExecutionHistory::Trend> trends;
+  {
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    runs = ExecutionHistory::RecentRuns(db, 500);
+    trends = ExecutionHistory::FilterTrends(db, 7, 30);
+  }
+  ExecutionHistory::Close(connectionName);
+
+  ExecutionHistoryDialog dialog(filePath, runs, trends, this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::setPipelineMemoryBudget()
+{
+  PipelineMemoryGovernor* governor = PipelineMemoryGovernor::Instance();
+  const double gb = 1024.0 * 1024.0 * 1024.0;
+  double physical = PipelineMemoryGovernor::PhysicalMemory() / gb;
+
+  bool ok = false;
+  QString label = tr("Memory that all running pipelines may use together, in GB.\nThis machine has %1 GB. Enter 0 for no limit.").arg(physical, 0, 'f', 1);
+  double budget = QInputDialog::getDouble(this, tr("Set Memory Budget"), label, governor->getBudget() / gb, 0.0, 1024.0 * 1024.0, 1, &ok);
+  if(ok)
+  {
+    governor->setBudget(static_cast<qint64>(budget * gb));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showFilterHelp(const QString& className)
+{
+  // The prebuilt help archive is served from memory; the documentation server is the fallback
+  QUrl archiveURL = HelpServer::Instance()->url(className);
+  if(archiveURL.isValid())
+  {
+    showFilterHelpUrl(archiveURL);
+    return;
+  }
+
 // Launch the dialog
 #ifdef SIMPL_USE_QtWebEngine
   SVUserManualDialog::LaunchHelpDialog(className);
@@ -1083,6 +2566,7 @@ void SIMPLView_UI::filterSelectionChanged(const QItemSelection& selected, const
     pipelineModel->setData(index, -1, PipelineModel::Roles::BorderSizeRole);
   }
 
+  setDataBrowserPreview(QString());
   if(selectedIndexes.size() == 1)
   {
     QModelIndex selectedIndex = selectedIndexes[0];
@@ -39,6 +39,8 @@
 
 
 //-- Qt Includes
+#include <atomic>
+
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QList>
@@ -57,6 +59,16 @@
 #include "SVWidgetsLib/Widgets/FilterInputWidget.h"
 #include "SVWidgetsLib/QtSupport/QtSSettings.h"
 
+#include "SIMPLView/AsyncWriteService.h"
+#include "SIMPLView/BatchPipelineRunner.h"
+#include "SIMPLView/ExecutionHistory.h"
+#include "SIMPLView/FilterTimingHistory.h"
+#include "SIMPLView/InputFileWatcher.h"
+#include "SIMPLView/InputPrefetcher.h"
+#include "SIMPLView/PipelineLoader.h"
+#include "SIMPLView/PipelineMessageQueue.h"
+#include "SIMPLView/PipelineSliceRunner.h"
+
 //-- UIC generated Header
 #include "ui_SIMPLView_UI.h"
 
@@ -68,12 +80,17 @@ class FilterListWidget;
 class UpdateCheckDialog;
 class UpdateCheckData;
 class UpdateCheck;
+class QTimer;
+class QLabel;
+class ResourceMonitorWidget;
+class FilterSearchDialog;
 class QToolButton;
 class AboutSIMPLView;
 class StatusBarWidget;
 class PipelineTreeView;
 class PipelineModel;
 class PipelineListWidget;
+class PipelineArrayReleaser;
 class SVPipelineViewWidget;
 class SIMPLViewMenuItems;
 
@@ -125,6 +142,20 @@ class SIMPLView_UI : public QMainWindow
      */
     void writeSettings();
 
+    /**
+     * @brief Reads the window settings for the SIMPLView_UI instance.  This includes the window position and size,
+     * dock widget locations, tab orders, splitter position, etc.
+     */
+    void readWindowSettings();
+
+    /**
+     * @brief Connects the window to the application wide services: the memory governor, the metrics server, the
+     * trace recorder, the event log, the background writer and the documentation requests. The application builds a
+     * window ahead of time and only calls this when it hands the window out, so a hidden window never shows up in
+     * their reports and never opens the help of a filter.
+     */
+    void connectServices();
+
     /**
      * @brief openPipeline
      * @param filePath
@@ -263,15 +294,15 @@ class SIMPLView_UI : public QMainWindow
     void writeVersionCheckSettings();
 
     /**
-     * @brief Reads the window settings for the SIMPLView_UI instance.  This includes the window position and size,
-     * dock widget locations, tab orders, splitter position, etc.
+     * @brief Reads the version check settings for the SIMPLView_UI instance.
      */
-    void readWindowSettings();
+    void readVersionCheckSettings();
 
     /**
-     * @brief Reads the version check settings for the SIMPLView_UI instance.
+     * @brief Counts a run that has started with the memory governor. A run that did not come through
+     * executePipeline() and does not fit into the budget is canceled before its first filter and queued instead.
      */
-    void readVersionCheckSettings();
+    void pipelineDidStart();
 
     /**
      * @brief pipelineDidFinish
@@ -284,6 +315,168 @@ class SIMPLView_UI : public QMainWindow
      */
     void processPipelineMessage(const PipelineMessage& msg);
 
+    /**
+     * @brief Puts a pipeline message on the message queue and starts the drain timer if it is not running. Errors
+     * and warnings drain the queue right away.
+     * @param msg
+     */
+    void enqueuePipelineMessage(const PipelineMessage& msg);
+
+    /**
+     * @brief Handles all queued pipeline messages as one batch. Only the newest progress value of a batch is shown.
+     */
+    void drainPipelineMessages();
+
+    /**
+     * @brief Shows in the status bar why this window's pipeline is waiting for memory
+     */
+    void memoryGovernorStateChanged();
+
+    /**
+     * @brief Shows the running and waiting pipelines of all windows
+     */
+    void showPipelineMemoryUsage();
+
+    /**
+     * @brief Asks the user for the memory budget shared by all pipelines
+     */
+    void setPipelineMemoryBudget();
+
+    /**
+     * @brief Shows the event loop stalls that the watchdog recorded
+     */
+    void showEventLoopStalls();
+
+    /**
+     * @brief Shows the recent runs and the per filter time trends from the execution history
+     */
+    void showExecutionHistory();
+
+    /**
+     * @brief Starts recording a trace, or stops recording and asks where to save it
+     * @param record
+     */
+    void toggleTraceRecording(bool record);
+
+    /**
+     * @brief Keeps the Record Trace action in step with the recorder, which all windows share
+     * @param recording
+     */
+    void traceRecordingChanged(bool recording);
+
+    /**
+     * @brief Starts or stops serving the metrics on localhost
+     * @param serve
+     */
+    void toggleMetricsServer(bool serve);
+
+    /**
+     * @brief Keeps the Serve Metrics action in step with the metrics server, which all windows share
+     * @param enabled
+     */
+    void metricsServerChanged(bool enabled);
+
+    /**
+     * @brief Switches releasing intermediate arrays after their last use on or off
+     * @param release
+     */
+    void toggleArrayReleasing(bool release);
+
+    /**
+     * @brief Switches watching the input files of the reader filters on or off
+     * @param watch
+     */
+    void toggleInputWatch(bool watch);
+
+    /**
+     * @brief Reruns the filters that depend on the changed input files, unless a run is already going on; then the
+     * changes wait and are taken when it has finished
+     */
+    void startWatchRun();
+
+    /**
+     * @brief Asks for input files and runs the pipeline once for each of them, with the reading and writing of
+     * one dataset overlapping the computing of another. Cancels the batch if one is running.
+     */
+    void runBatch();
+
+    /**
+     * @brief Shows the quick search over all filters; the chosen filter is added to the pipeline
+     */
+    void findFilter();
+
+    /**
+     * @brief Reports one dataset of a batch
+     * @param dataset
+     * @param done
+     * @param count
+     */
+    void batchDatasetFinished(const BatchPipelineRunner::Dataset& dataset, int done, int count);
+
+    /**
+     * @brief Reports a finished batch
+     * @param summary
+     */
+    void batchFinished(const BatchPipelineRunner::Summary& summary);
+
+    /**
+     * @brief Reports a write that finished on the I/O thread with its throughput
+     * @param result
+     */
+    void backgroundWriteFinished(const AsyncWriteService::Result& result);
+
+    /**
+     * @brief Shows how much is waiting to be written in the status bar
+     * @param writes
+     * @param bytes
+     */
+    void pendingWritesChanged(int writes, qint64 bytes);
+
+    /**
+     * @brief Shows how far prefetching the input files has come in the status bar
+     * @param done
+     * @param total
+     */
+    void prefetchProgress(qint64 done, qint64 total);
+
+    /**
+     * @brief Hides the prefetch progress and reports the throughput
+     * @param bytes
+     * @param milliseconds
+     * @param canceled
+     */
+    void prefetchFinished(qint64 bytes, qint64 milliseconds, bool canceled);
+
+    /**
+     * @brief Inserts a pipeline that was loaded in the background into the pipeline view
+     * @param result
+     */
+    void pipelineLoaded(const PipelineLoader::Result& result);
+
+    /**
+     * @brief Computes the array that is selected in the data browser, or one that the user picks, by running only
+     * the filters it depends on. Cancels the computation if one is running.
+     */
+    void computeArray();
+
+    /**
+     * @brief Reports a computed array
+     * @param result
+     */
+    void arrayComputed(const PipelineSliceRunner::Result& result);
+
+    /**
+     * @brief Asks for a region of interest and a downsampling factor and runs the pipeline on the reduced data
+     * without its writers. The pipeline itself is not changed.
+     */
+    void previewPipeline();
+
+    /**
+     * @brief Lets the user drag a numeric parameter of the selected filter and reruns that filter and the filters
+     * that depend on it on the preview data after every change
+     */
+    void scrubParameter();
+
     /**
     * @brief setFilterInputWidget
     * @param widget
@@ -330,7 +523,62 @@ class SIMPLView_UI : public QMainWindow
 
     QString                                 m_LastOpenedFilePath;
 
+    PipelineLoader*                         m_PipelineLoader = nullptr;
+    PipelineArrayReleaser*                  m_ArrayReleaser = nullptr;
+    PipelineSliceRunner*                    m_SliceRunner = nullptr;
+    InputFileWatcher*                       m_InputWatcher = nullptr;
+    BatchPipelineRunner*                    m_BatchRunner = nullptr;
+    InputPrefetcher*                        m_Prefetcher = nullptr;
+    FilterSearchDialog*                     m_FilterSearchDialog = nullptr;
+    InputFileWatcher::Changes               m_WatchChanges;
+    qint64                                  m_WatchRunStarted = 0;
+    PipelinePreview::Settings               m_PreviewSettings;
+    AbstractFilter::Pointer                 m_PreviewHolder;
+    QString                                 m_DataBrowserTitle;
+    FilterPipeline::Pointer                 m_PreflightedPipeline;
+    QString                                 m_ReleasePlanSummary;
+    bool                                    m_ExecuteAfterLoad = false;
+    bool                                    m_FilterLibraryLoaded = false;
+
+    PipelineMessageQueue                    m_MessageQueue;
+    QTimer*                                 m_MessageDrainTimer = nullptr;
+
+    QString                                 m_ExecutionLogId;
+    std::atomic<int>                        m_ExecutionRun;
+
+    // Trace span of the filter that is executing; only touched by the thread that emits the pipeline messages.
+    // The filters run on a thread of the pipeline view, so their spans go to a lane of this window's own.
+    int                                     m_TraceFilterIndex = -1;
+    int                                     m_TraceFilterLane = -1;
+    qint64                                  m_TraceFilterStart = 0;
+    QString                                 m_TraceFilterLabel;
+    qint64                                  m_PreflightStart = 0;
+
+    // Filter that is executing as seen by the GUI thread, for the filter timing history and the metrics
+    int                                     m_TimedFilterIndex = -1;
+    qint64                                  m_TimedFilterStart = 0;
+    QString                                 m_TimedFilterClass;
+    bool                                    m_CancelRequested = false;
+    bool                                    m_RunFailed = false;
+
+    // Runtime prediction of the last preflight and how the current run compares to it
+    FilterTimingHistory::Prediction         m_Prediction;
+    qint64                                  m_RunStart = 0;
+    double                                  m_CompletedPredicted = 0.0;
+    double                                  m_CompletedActual = 0.0;
+    QTimer*                                 m_EstimateTimer = nullptr;
+    QLabel*                                 m_EstimateLabel = nullptr;
+    QLabel*                                 m_PendingWritesLabel = nullptr;
+    QLabel*                                 m_PrefetchLabel = nullptr;
+
+    // What the execution history records about the current run
+    QString                                 m_PipelineHash;
+    QDateTime                               m_RunStarted;
+    QVector<ExecutionHistory::FilterTiming> m_RunFilters;
+    qint64                                  m_RunPeakMemory = 0;
+
     FilterInputWidget*                      m_FilterInputWidget = nullptr;
+    ResourceMonitorWidget*                  m_ResourceMonitor = nullptr;
 
     QMenu*                                  m_MenuFile = nullptr;
     QMenu*                                  m_MenuEdit = nullptr;
@@ -355,22 +603,106 @@ class SIMPLView_UI : public QMainWindow
     QAction*                                m_ActionCheckForUpdates = nullptr;
     QAction*                                m_ActionPluginInformation = nullptr;
     QAction*                                m_ActionClearCache = nullptr;
+    QAction*                                m_ActionShowMemoryUsage = nullptr;
+    QAction*                                m_ActionSetMemoryBudget = nullptr;
+    QAction*                                m_ActionShowEventLoopStalls = nullptr;
+    QAction*                                m_ActionShowExecutionHistory = nullptr;
+    QAction*                                m_ActionRecordTrace = nullptr;
+    QAction*                                m_ActionServeMetrics = nullptr;
+    QAction*                                m_ActionReleaseArrays = nullptr;
+    QAction*                                m_ActionComputeArray = nullptr;
+    QAction*                                m_ActionPreview = nullptr;
+    QAction*                                m_ActionScrubParameter = nullptr;
+    QAction*                                m_ActionWatchInputs = nullptr;
+    QAction*                                m_ActionRunBatch = nullptr;
+    QAction*                                m_ActionFindFilter = nullptr;
     QAction*                                m_ActionSetDataFolder = nullptr;
     QAction*                                m_ActionShowDataFolder = nullptr;
 
     QActionGroup*                           m_ThemeActionGroup = nullptr;
 
+    bool                                    m_ServicesConnected = false;
+
+    // Whether the running start came through executePipeline(), and whether a run that did not is being stopped
+    bool                                    m_GovernedStart = false;
+    bool                                    m_StartDeferred = false;
+
     /**
      * @brief createSIMPLViewMenu
      */
     void createSIMPLViewMenuSystem();
 
+    /**
+     * @brief Starts a new filter span when the messages of the executing pipeline move on to the next filter
+     * @param msg
+     */
+    void traceFilterMessage(const PipelineMessage& msg);
+
+    /**
+     * @brief Ends the span of the filter that is executing
+     */
+    void closeTraceFilterSpan();
+
+    /**
+     * @brief Starts timing the next filter when the pipeline messages move on to it
+     * @param msg
+     * @param received When the window received the message
+     */
+    void timeFilterMessage(const PipelineMessage& msg, qint64 received);
+
+    /**
+     * @brief Reports the duration of the filter that is executing to the metrics server and, if it completed,
+     * to the filter timing history
+     * @param completed
+     * @param finished When the filter stopped, in SVTrace::Now() nanoseconds
+     */
+    void finishTimedFilter(bool completed, qint64 finished);
+
+    /**
+     * @brief Shows the progress of the running pipeline weighted by the predicted filter runtimes and its ETA
+     */
+    void updateRunEstimate();
+
+    /**
+     * @brief Shows the predicted runtime of the pipeline while it is not running
+     */
+    void showPredictedRuntime();
+
+    /**
+     * @brief Returns the path of the array that is current in the data browser, or an empty path if the current
+     * item is not an array
+     * @return
+     */
+    DataArrayPath selectedDataBrowserArray() const;
+
+    /**
+     * @brief Marks the data browser as showing a preview, or removes the mark if description is empty
+     * @param description
+     */
+    void setDataBrowserPreview(const QString& description);
+
     /**
      * @brief Connects all the dock widget specific signals and slots
      * @param dockWidget
      */
     void connectDockWidgetSignalsSlots(QDockWidget* dockWidget);
 
+    /**
+     * @brief Opens the pipeline synchronously through the pipeline view. This handles every file type
+     * that SIMPL can read and is used whenever the background loader cannot handle the file.
+     * @param filePath
+     * @return
+     */
+    int openPipelineInView(const QString& filePath);
+
+    /**
+     * @brief Writes the current pipeline to a file. Binary pipeline files are written as Json by the
+     * pipeline view and then converted.
+     * @param filePath
+     * @return
+     */
+    int writePipelineFile(const QString& filePath);
+
     /**
      * @brief savePipeline
      * @return
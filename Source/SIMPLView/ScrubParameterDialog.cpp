@@ -0,0 +1,285 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ScrubParameterDialog.h"
+
+#include <QtCore/QSignalBlocker>
+#include <QtCore/QTimer>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QDoubleSpinBox>
+#include <QtWidgets/QGridLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QSlider>
+
+#include "SIMPLib/FilterParameters/FilterParameter.h"
+
+#include "SIMPLView/ArrayStatistics.h"
+#include "SIMPLView/PipelineDataFlow.h"
+
+namespace
+{
+const int k_SliderSteps = 1000;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ScrubParameterDialog::ScrubParameterDialog(FilterPipeline::Pointer pipeline, int index, PipelineSliceRunner* runner, const PipelinePreview::Settings& settings, QWidget* parent)
+: QDialog(parent)
+, m_Pipeline(pipeline)
+, m_Index(index)
+, m_Filter(pipeline->getFilterContainer()[index])
+, m_Runner(runner)
+, m_Settings(settings)
+, m_PropertyNames(NumericProperties(m_Filter))
+{
+  QStringList labels;
+  for(FilterParameter::Pointer parameter : m_Filter->getFilterParameters())
+  {
+    if(m_PropertyNames.contains(parameter->getPropertyName()))
+    {
+      labels.push_back(parameter->getHumanLabel());
+    }
+  }
+
+  // The statistics cover the arrays that the rerun filters create
+  QVector<PipelineDataFlow::FilterAccess> access = PipelineDataFlow::Analyze(m_Pipeline);
+  for(int i : PipelineDataFlow::Dependents(m_Pipeline, m_Index))
+  {
+    m_Reported += access[i].creates;
+  }
+
+  setWindowTitle(tr("Scrub Parameter of %1").arg(m_Filter->getHumanLabel()));
+  QGridLayout* layout = new QGridLayout(this);
+  QLabel* description = new QLabel(tr("Reruns %1 and the filters that depend on it at %2 whenever the value changes. The other filters run once. "
+                                      "Use Preview Execution to change the region of interest or the downsampling factor.")
+                                       .arg(m_Filter->getHumanLabel())
+                                       .arg(PipelinePreview::Describe(m_Settings)),
+                                   this);
+  description->setWordWrap(true);
+  layout->addWidget(description, 0, 0, 1, 4);
+
+  layout->addWidget(new QLabel(tr("Parameter"), this), 1, 0);
+  m_Parameters = new QComboBox(this);
+  m_Parameters->addItems(labels);
+  layout->addWidget(m_Parameters, 1, 1, 1, 3);
+
+  layout->addWidget(new QLabel(tr("From"), this), 2, 0);
+  m_Minimum = new QDoubleSpinBox(this);
+  layout->addWidget(m_Minimum, 2, 1);
+  layout->addWidget(new QLabel(tr("to"), this), 2, 2);
+  m_Maximum = new QDoubleSpinBox(this);
+  layout->addWidget(m_Maximum, 2, 3);
+
+  m_Slider = new QSlider(Qt::Horizontal, this);
+  m_Slider->setRange(0, k_SliderSteps);
+  layout->addWidget(m_Slider, 3, 0, 1, 3);
+  m_Value = new QDoubleSpinBox(this);
+  layout->addWidget(m_Value, 3, 3);
+
+  m_Statistics = new QLabel(this);
+  m_Statistics->setWordWrap(true);
+  m_Statistics->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  layout->addWidget(m_Statistics, 4, 0, 1, 4);
+
+  QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Apply | QDialogButtonBox::Close, this);
+  connect(buttons->button(QDialogButtonBox::Apply), &QPushButton::clicked, this, &QDialog::accept);
+  connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+  layout->addWidget(buttons, 5, 0, 1, 4);
+
+  // Dragging produces far more values than can run, so only the one the slider rests on is sent
+  m_Debounce = new QTimer(this);
+  m_Debounce->setSingleShot(true);
+  m_Debounce->setInterval(50);
+  connect(m_Debounce, &QTimer::timeout, this, &ScrubParameterDialog::scrub);
+
+  connect(m_Slider, &QSlider::valueChanged, this, &ScrubParameterDialog::sliderChanged);
+  connect(m_Value, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), this, &ScrubParameterDialog::valueChanged);
+  connect(m_Minimum, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), this, &ScrubParameterDialog::rangeChanged);
+  connect(m_Maximum, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), this, &ScrubParameterDialog::rangeChanged);
+  connect(m_Parameters, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ScrubParameterDialog::parameterChanged);
+  connect(m_Runner, &PipelineSliceRunner::finished, this, &ScrubParameterDialog::sliceFinished);
+  parameterChanged(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ScrubParameterDialog::~ScrubParameterDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList ScrubParameterDialog::NumericProperties(AbstractFilter::Pointer filter)
+{
+  const QVector<int> numericTypes = {QMetaType::Int, QMetaType::UInt, QMetaType::LongLong, QMetaType::ULongLong, QMetaType::Float, QMetaType::Double};
+  QStringList propertyNames;
+  for(FilterParameter::Pointer parameter : filter->getFilterParameters())
+  {
+    QVariant value = filter->property(parameter->getPropertyName().toLatin1().constData());
+    if(numericTypes.contains(value.userType()))
+    {
+      propertyNames.push_back(parameter->getPropertyName());
+    }
+  }
+  return propertyNames;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ScrubParameterDialog::getPropertyName() const
+{
+  return m_PropertyNames[m_Parameters->currentIndex()];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ScrubParameterDialog::getParameterLabel() const
+{
+  return m_Parameters->currentText();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVariant ScrubParameterDialog::getValue() const
+{
+  QVariant original = m_Filter->property(getPropertyName().toLatin1().constData());
+  QVariant scrubbed = (m_Value->decimals() == 0) ? QVariant(qRound64(m_Value->value())) : QVariant(m_Value->value());
+  scrubbed.convert(original.userType());
+  return scrubbed;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScrubParameterDialog::parameterChanged(int current)
+{
+  QVariant original = m_Filter->property(m_PropertyNames[current].toLatin1().constData());
+  bool integral = original.userType() != QMetaType::Float && original.userType() != QMetaType::Double;
+  double number = original.toDouble();
+  double span = qMax(qAbs(number), 1.0);
+  for(QDoubleSpinBox* spinBox : {m_Minimum, m_Maximum, m_Value})
+  {
+    QSignalBlocker blocker(spinBox);
+    spinBox->setDecimals(integral ? 0 : 4);
+    spinBox->setRange(-1.0e9, 1.0e9);
+  }
+  {
+    QSignalBlocker minimumBlocker(m_Minimum);
+    QSignalBlocker maximumBlocker(m_Maximum);
+    m_Minimum->setValue((integral && number >= 0.0) ? 0.0 : number - span);
+    m_Maximum->setValue(number + span);
+    QSignalBlocker valueBlocker(m_Value);
+    m_Value->setValue(number);
+  }
+  rangeChanged();
+  m_Statistics->setText(tr("Move the slider to run."));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScrubParameterDialog::rangeChanged()
+{
+  m_Value->setRange(m_Minimum->value(), m_Maximum->value());
+  double span = m_Maximum->value() - m_Minimum->value();
+  QSignalBlocker blocker(m_Slider);
+  m_Slider->setValue((span > 0.0) ? qRound((m_Value->value() - m_Minimum->value()) / span * k_SliderSteps) : 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScrubParameterDialog::sliderChanged(int position)
+{
+  QSignalBlocker blocker(m_Value);
+  m_Value->setValue(m_Minimum->value() + (m_Maximum->value() - m_Minimum->value()) * position / k_SliderSteps);
+  m_Debounce->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScrubParameterDialog::valueChanged(double current)
+{
+  double span = m_Maximum->value() - m_Minimum->value();
+  QSignalBlocker blocker(m_Slider);
+  m_Slider->setValue((span > 0.0) ? qRound((current - m_Minimum->value()) / span * k_SliderSteps) : 0);
+  m_Debounce->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScrubParameterDialog::scrub()
+{
+  m_Runner->scrub(m_Pipeline, m_Index, getPropertyName(), getValue(), m_Settings);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScrubParameterDialog::sliceFinished(const PipelineSliceRunner::Result& result)
+{
+  if(!result.scrub || result.canceled)
+  {
+    return;
+  }
+  if(result.err < 0)
+  {
+    m_Statistics->setText(result.errorMessage);
+    return;
+  }
+
+  QStringList lines;
+  lines << tr("%1 ms: %2 filters ran, %3 were reused").arg(result.milliseconds).arg(result.filtersRun).arg(result.filtersReused);
+  for(const DataArrayPath& path : m_Reported)
+  {
+    AttributeMatrix::Pointer am = result.dca->getAttributeMatrix(path);
+    IDataArray::Pointer array = (nullptr != am.get()) ? am->getAttributeArray(path.getDataArrayName()) : IDataArray::NullPointer();
+    if(nullptr != array.get())
+    {
+      lines << QString("%1: %2").arg(path.serialize("/")).arg(ArrayStatistics::Summarize(array));
+    }
+  }
+  m_Statistics->setText(lines.join("\n"));
+
+  emit previewAvailable(result.dca, tr("%1 = %2 at %3").arg(getParameterLabel()).arg(m_Value->value()).arg(PipelinePreview::Describe(m_Settings)));
+}
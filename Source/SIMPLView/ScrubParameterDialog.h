@@ -0,0 +1,137 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtWidgets/QDialog>
+
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "SIMPLView/PipelinePreview.h"
+#include "SIMPLView/PipelineSliceRunner.h"
+
+class QComboBox;
+class QDoubleSpinBox;
+class QLabel;
+class QSlider;
+class QTimer;
+
+/**
+ * @brief The ScrubParameterDialog class drags one numeric parameter of a filter through a range of values. Every
+ * value the slider rests on reruns the filter and the filters that depend on it on the reduced data of the preview
+ * settings and shows the statistics of the arrays they create. Apply keeps the current value.
+ */
+class ScrubParameterDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief ScrubParameterDialog
+   * @param pipeline A pipeline that preflighted without errors
+   * @param index The index of the scrubbed filter in the pipeline
+   * @param runner Runs the slices of the pipeline
+   * @param settings The preview settings the slices run at
+   * @param parent
+   */
+  ScrubParameterDialog(FilterPipeline::Pointer pipeline, int index, PipelineSliceRunner* runner, const PipelinePreview::Settings& settings, QWidget* parent = nullptr);
+  ~ScrubParameterDialog() override;
+
+  /**
+   * @brief Returns the property names of the parameters of a filter that a number can be dragged through
+   * @param filter
+   * @return
+   */
+  static QStringList NumericProperties(AbstractFilter::Pointer filter);
+
+  /**
+   * @brief Returns the property name of the chosen parameter
+   */
+  QString getPropertyName() const;
+
+  /**
+   * @brief Returns the label of the chosen parameter
+   */
+  QString getParameterLabel() const;
+
+  /**
+   * @brief Returns the current value, converted to the type of the parameter
+   */
+  QVariant getValue() const;
+
+signals:
+  /**
+   * @brief Emitted when a rerun finished and its data can be shown in the data browser
+   * @param dca
+   * @param description
+   */
+  void previewAvailable(DataContainerArray::Pointer dca, const QString& description);
+
+protected slots:
+  void parameterChanged(int current);
+  void rangeChanged();
+  void sliderChanged(int position);
+  void valueChanged(double current);
+  void scrub();
+  void sliceFinished(const PipelineSliceRunner::Result& result);
+
+private:
+  FilterPipeline::Pointer m_Pipeline;
+  int m_Index = -1;
+  AbstractFilter::Pointer m_Filter;
+  PipelineSliceRunner* m_Runner = nullptr;
+  PipelinePreview::Settings m_Settings;
+  QStringList m_PropertyNames;
+  QVector<DataArrayPath> m_Reported;
+
+  QComboBox* m_Parameters = nullptr;
+  QDoubleSpinBox* m_Minimum = nullptr;
+  QDoubleSpinBox* m_Maximum = nullptr;
+  QSlider* m_Slider = nullptr;
+  QDoubleSpinBox* m_Value = nullptr;
+  QLabel* m_Statistics = nullptr;
+  QTimer* m_Debounce = nullptr;
+
+public:
+  ScrubParameterDialog(const ScrubParameterDialog&) = delete;            // Copy Constructor Not Implemented
+  ScrubParameterDialog(ScrubParameterDialog&&) = delete;                 // Move Constructor Not Implemented
+  ScrubParameterDialog& operator=(const ScrubParameterDialog&) = delete; // Copy Assignment Not Implemented
+  ScrubParameterDialog& operator=(ScrubParameterDialog&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,347 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SettingsCache.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/TraceRecorder.h"
+
+namespace
+{
+const int k_DefaultFlushDelay = 750;
+}
+
+SettingsCache* SettingsCache::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsCache::SettingsCache(QObject* parent)
+: QObject(parent)
+{
+  m_FlushTimer.setSingleShot(true);
+  m_FlushTimer.setInterval(k_DefaultFlushDelay);
+  connect(&m_FlushTimer, &QTimer::timeout, this, &SettingsCache::flush);
+
+  if(nullptr != QCoreApplication::instance())
+  {
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &SettingsCache::flushNow);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsCache::~SettingsCache()
+{
+  flushNow();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsCache* SettingsCache::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new SettingsCache();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString SettingsCache::MakeKey(const QString& group, const QString& key)
+{
+  return group + "/" + key;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SettingsCache::contains(const QString& group, const QString& key)
+{
+  QString cacheKey = MakeKey(group, key);
+  {
+    QMutexLocker locker(&m_Mutex);
+    if(m_Values.contains(cacheKey))
+    {
+      return true;
+    }
+    if(m_Missing.contains(cacheKey))
+    {
+      return false;
+    }
+  }
+
+  load(group, key, QVariant());
+
+  QMutexLocker locker(&m_Mutex);
+  return m_Values.contains(cacheKey);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVariant SettingsCache::value(const QString& group, const QString& key, const QVariant& defaultValue)
+{
+  QString cacheKey = MakeKey(group, key);
+  {
+    QMutexLocker locker(&m_Mutex);
+    Entries::const_iterator iter = m_Values.constFind(cacheKey);
+    if(iter != m_Values.constEnd() && (!defaultValue.isValid() || iter.value().type() == defaultValue.type()))
+    {
+      return iter.value();
+    }
+    if(m_Missing.contains(cacheKey))
+    {
+      return defaultValue;
+    }
+  }
+
+  // Either the key has not been read yet or it was read without knowing its type
+  load(group, key, defaultValue);
+
+  QMutexLocker locker(&m_Mutex);
+  return m_Values.value(cacheKey, defaultValue);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsCache::setValue(const QString& group, const QString& key, const QVariant& value)
+{
+  QString cacheKey = MakeKey(group, key);
+  {
+    QMutexLocker locker(&m_Mutex);
+    Entries::const_iterator iter = m_Values.constFind(cacheKey);
+    if(iter != m_Values.constEnd() && iter.value() == value)
+    {
+      return;
+    }
+    m_Values.insert(cacheKey, value);
+    m_Missing.remove(cacheKey);
+    m_Dirty.insert(cacheKey);
+  }
+
+  // Every change restarts the timer so that a burst of changes results in a single write
+  if(QThread::currentThread() == thread())
+  {
+    m_FlushTimer.start();
+  }
+  else
+  {
+    QMetaObject::invokeMethod(&m_FlushTimer, "start", Qt::QueuedConnection);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SettingsCache::isDirty() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return !m_Dirty.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsCache::setFlushDelay(int msecs)
+{
+  m_FlushTimer.setInterval(msecs);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsCache::load(const QString& group, const QString& key, const QVariant& defaultValue)
+{
+  QString cacheKey = MakeKey(group, key);
+  QStringList groups = group.split('/', QString::SkipEmptyParts);
+
+  bool exists = false;
+  QVariant value;
+  {
+    QMutexLocker fileLocker(&m_FileMutex);
+    QtSSettings prefs;
+    for(const QString& name : groups)
+    {
+      prefs.beginGroup(name);
+    }
+    exists = prefs.contains(key);
+    if(exists)
+    {
+      // QtSSettings encodes byte arrays, so they have to be read back through the matching overload
+      if(defaultValue.type() == QVariant::ByteArray)
+      {
+        value = prefs.value(key, QByteArray());
+      }
+      else
+      {
+        value = prefs.value(key, defaultValue);
+      }
+    }
+    for(int i = 0; i < groups.size(); i++)
+    {
+      prefs.endGroup();
+    }
+  }
+
+  QMutexLocker locker(&m_Mutex);
+  if(m_Dirty.contains(cacheKey))
+  {
+    // A newer value was set while the file was being read
+    return;
+  }
+  if(exists)
+  {
+    m_Values.insert(cacheKey, value);
+  }
+  else
+  {
+    m_Missing.insert(cacheKey);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SettingsCache::Entries SettingsCache::takeDirty()
+{
+  QMutexLocker locker(&m_Mutex);
+  Entries entries;
+  for(const QString& cacheKey : m_Dirty)
+  {
+    entries.insert(cacheKey, m_Values.value(cacheKey));
+  }
+  m_Dirty.clear();
+  return entries;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SettingsCache::writeEntries(const Entries& entries)
+{
+  SV_TRACE_SCOPE_CATEGORY("Write Settings", "io");
+  QMutexLocker fileLocker(&m_FileMutex);
+
+  QString filePath = QtSSettings().fileName();
+  QString scratchPath = filePath + ".flush";
+  QFile::remove(scratchPath);
+  if(QFile::exists(filePath) && !QFile::copy(filePath, scratchPath))
+  {
+    qWarning("The preferences could not be copied to %s", qPrintable(scratchPath));
+    return false;
+  }
+
+  {
+    // One session for the whole batch, on the copy
+    QtSSettings prefs(scratchPath);
+    for(Entries::const_iterator iter = entries.constBegin(); iter != entries.constEnd(); ++iter)
+    {
+      int split = iter.key().lastIndexOf('/');
+      QStringList groups = iter.key().left(split).split('/', QString::SkipEmptyParts);
+      QString key = iter.key().mid(split + 1);
+
+      for(const QString& name : groups)
+      {
+        prefs.beginGroup(name);
+      }
+      if(iter.value().type() == QVariant::ByteArray)
+      {
+        prefs.setValue(key, iter.value().toByteArray());
+      }
+      else
+      {
+        prefs.setValue(key, iter.value());
+      }
+      for(int i = 0; i < groups.size(); i++)
+      {
+        prefs.endGroup();
+      }
+    }
+  }
+
+  // The copy replaces the file in one step, so a crash never leaves half of it behind
+  QFile scratch(scratchPath);
+  QSaveFile file(filePath);
+  bool written = scratch.open(QIODevice::ReadOnly) && file.open(QIODevice::WriteOnly) && file.write(scratch.readAll()) >= 0 && file.commit();
+  if(!written)
+  {
+    qWarning("The preferences could not be written to %s: %s", qPrintable(filePath), qPrintable(file.errorString()));
+  }
+  scratch.close();
+  QFile::remove(scratchPath);
+  return written;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsCache::flush()
+{
+  Entries entries = takeDirty();
+  if(entries.isEmpty() || writeEntries(entries))
+  {
+    return;
+  }
+
+  // Whatever was not written stays dirty; the cache still holds the newest value of every key
+  QMutexLocker locker(&m_Mutex);
+  for(Entries::const_iterator iter = entries.constBegin(); iter != entries.constEnd(); ++iter)
+  {
+    m_Dirty.insert(iter.key());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SettingsCache::flushNow()
+{
+  m_FlushTimer.stop();
+  flush();
+}
@@ -0,0 +1,162 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtCore/QVariant>
+
+/**
+ * @brief The SettingsCache class is a process wide, in memory copy of the preferences that change
+ * often, such as window geometry and dock layout. Writes only update memory and mark the entry dirty;
+ * the dirty entries are written to the preferences file in one go once the writes have settled for a
+ * short while. All windows share the same cache so that they see each other's values without going to disk.
+ *
+ * The toolbox widgets, the recent files list and the application write the same file directly on the GUI
+ * thread, so the cache writes it on the GUI thread too and never in the middle of one of their sessions.
+ * A flush applies the entries to a scratch copy of the file and swaps it in with QSaveFile, so a crash
+ * leaves either the old or the new preferences behind.
+ *
+ * Values are read from disk once, the first time a key is asked for. flushNow() must be called
+ * before anything else reads or clears the preferences file directly.
+ */
+class SettingsCache : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~SettingsCache() override;
+
+  /**
+   * @brief Returns the singleton instance
+   * @return
+   */
+  static SettingsCache* Instance();
+
+  /**
+   * @brief Returns true if the key exists in the cache or in the preferences file
+   * @param group
+   * @param key
+   * @return
+   */
+  bool contains(const QString& group, const QString& key);
+
+  /**
+   * @brief Returns the value of the key. The type of the default value selects how the value is read
+   * from the preferences file the first time.
+   * @param group
+   * @param key
+   * @param defaultValue
+   * @return
+   */
+  QVariant value(const QString& group, const QString& key, const QVariant& defaultValue = QVariant());
+
+  /**
+   * @brief Stores the value in memory and schedules a background flush if the value changed
+   * @param group
+   * @param key
+   * @param value
+   */
+  void setValue(const QString& group, const QString& key, const QVariant& value);
+
+  /**
+   * @brief Returns true if there are values that have not been written to disk yet
+   * @return
+   */
+  bool isDirty() const;
+
+  /**
+   * @brief Sets how long the cache waits after the last change before it flushes
+   * @param msecs
+   */
+  void setFlushDelay(int msecs);
+
+public slots:
+  /**
+   * @brief Writes all dirty values to disk right away. Used when the application exits.
+   */
+  void flushNow();
+
+protected:
+  SettingsCache(QObject* parent = nullptr);
+
+protected slots:
+  /**
+   * @brief Writes the dirty values once they have settled
+   */
+  void flush();
+
+private:
+  static SettingsCache* self;
+
+  using Entries = QHash<QString, QVariant>;
+
+  mutable QMutex m_Mutex;
+  QMutex m_FileMutex;
+  Entries m_Values;
+  QSet<QString> m_Missing;
+  QSet<QString> m_Dirty;
+  QTimer m_FlushTimer;
+
+  static QString MakeKey(const QString& group, const QString& key);
+
+  /**
+   * @brief Loads a single value from the preferences file into the cache
+   */
+  void load(const QString& group, const QString& key, const QVariant& defaultValue);
+
+  /**
+   * @brief Removes the dirty values from the cache's dirty set and returns them
+   */
+  Entries takeDirty();
+
+  /**
+   * @brief Writes the entries through a single QtSSettings session on a scratch copy of the preferences
+   * file and swaps the copy in
+   * @return False if the file could not be written
+   */
+  bool writeEntries(const Entries& entries);
+
+public:
+  SettingsCache(const SettingsCache&) = delete;            // Copy Constructor Not Implemented
+  SettingsCache(SettingsCache&&) = delete;                 // Move Constructor Not Implemented
+  SettingsCache& operator=(const SettingsCache&) = delete; // Copy Assignment Not Implemented
+  SettingsCache& operator=(SettingsCache&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,418 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TraceRecorder.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+namespace
+{
+/**
+ * @brief Holds the calling thread's TraceRecorder::ThreadBuffer, so that recording a span never takes the
+ * recorder's lock, and marks the buffer as finished when the thread exits so that start() can free it
+ */
+struct ThreadBufferOwner
+{
+  void* buffer = nullptr;
+  std::atomic<bool>* finished = nullptr;
+
+  ~ThreadBufferOwner()
+  {
+    if(nullptr != finished)
+    {
+      finished->store(true);
+    }
+  }
+};
+
+thread_local ThreadBufferOwner s_ThreadBuffer;
+
+/**
+ * @brief Appends text to out as the contents of a Json string
+ */
+void AppendEscaped(QByteArray& out, const char* text)
+{
+  for(const char* c = text; *c != '\0'; c++)
+  {
+    switch(*c)
+    {
+    case '"':
+      out.append("\\\"");
+      break;
+    case '\\':
+      out.append("\\\\");
+      break;
+    case '\n':
+      out.append("\\n");
+      break;
+    case '\t':
+      out.append("\\t");
+      break;
+    default:
+      if(static_cast<unsigned char>(*c) < 0x20)
+      {
+        out.append(' ');
+      }
+      else
+      {
+        out.append(*c);
+      }
+      break;
+    }
+  }
+}
+}
+
+TraceRecorder* TraceRecorder::self = nullptr;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TraceRecorder::TraceRecorder(QObject* parent)
+: QObject(parent)
+, m_SpanCount(0)
+, m_Dropped(0)
+{
+  m_Hook.recording.store(false);
+  m_Hook.addSpan = &TraceRecorder::AddHookSpan;
+
+  QCoreApplication* app = QCoreApplication::instance();
+  if(nullptr != app)
+  {
+    app->setProperty("SIMPLViewTraceHook", QVariant(static_cast<qulonglong>(reinterpret_cast<quintptr>(&m_Hook))));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TraceRecorder::~TraceRecorder()
+{
+  m_Hook.recording.store(false);
+  qDeleteAll(m_Buffers);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TraceRecorder* TraceRecorder::Instance()
+{
+  if(self == nullptr)
+  {
+    self = new TraceRecorder();
+  }
+  return self;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TraceRecorder::isRecording() const
+{
+  return m_Hook.recording.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TraceRecorder::start()
+{
+  if(isRecording())
+  {
+    return;
+  }
+
+  {
+    // The buffers of threads that have finished are freed and their ids are given to new threads
+    QMutexLocker locker(&m_Mutex);
+    for(int i = 0; i < m_Buffers.size(); i++)
+    {
+      ThreadBuffer* buffer = m_Buffers[i];
+      if(nullptr == buffer)
+      {
+        continue;
+      }
+      if(buffer->finished.load())
+      {
+        delete buffer;
+        m_Buffers[i] = nullptr;
+        continue;
+      }
+      QMutexLocker bufferLocker(&buffer->mutex);
+      buffer->spans.clear();
+    }
+  }
+  m_SpanCount.store(0);
+  m_Dropped.store(0);
+  m_Started = SVTrace::Now();
+
+  m_Hook.recording.store(true);
+  emit recordingChanged(true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TraceRecorder::stop()
+{
+  if(!isRecording())
+  {
+    return;
+  }
+
+  m_Hook.recording.store(false);
+  emit recordingChanged(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TraceRecorder::getSpanCount() const
+{
+  return m_SpanCount.load();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TraceRecorder::getDroppedCount() const
+{
+  return m_Dropped.load();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TraceRecorder::CurrentThreadId()
+{
+  return Instance()->currentBuffer()->id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TraceRecorder::ThreadBuffer* TraceRecorder::currentBuffer()
+{
+  if(nullptr != s_ThreadBuffer.buffer)
+  {
+    return static_cast<ThreadBuffer*>(s_ThreadBuffer.buffer);
+  }
+
+  QMutexLocker locker(&m_Mutex);
+  ThreadBuffer* threadBuffer = new ThreadBuffer;
+  threadBuffer->id = m_Buffers.indexOf(nullptr);
+  if(threadBuffer->id < 0)
+  {
+    threadBuffer->id = m_Buffers.size();
+    m_Buffers.push_back(nullptr);
+  }
+
+  QThread* thread = QThread::currentThread();
+  if(nullptr != QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+  {
+    threadBuffer->name = "GUI";
+  }
+  else if(nullptr != thread && !thread->objectName().isEmpty())
+  {
+    threadBuffer->name = thread->objectName();
+  }
+  else
+  {
+    threadBuffer->name = QString("Worker %1").arg(threadBuffer->id);
+  }
+
+  m_Buffers[threadBuffer->id] = threadBuffer;
+  s_ThreadBuffer.buffer = threadBuffer;
+  s_ThreadBuffer.finished = &threadBuffer->finished;
+  return threadBuffer;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TraceRecorder::addLane(const QString& name)
+{
+  QMutexLocker locker(&m_Mutex);
+  ThreadBuffer* lane = new ThreadBuffer;
+  lane->id = m_Buffers.size();
+  lane->name = name;
+  m_Buffers.push_back(lane);
+  return lane->id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TraceRecorder::ThreadBuffer* TraceRecorder::buffer(int threadId)
+{
+  // Only start() frees buffers, and only those of threads that have finished
+  QMutexLocker locker(&m_Mutex);
+  return m_Buffers.value(threadId, nullptr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TraceRecorder::append(ThreadBuffer* threadBuffer, Span& span)
+{
+  if(nullptr == threadBuffer)
+  {
+    return;
+  }
+  if(m_SpanCount.fetch_add(1) >= MaxSpans)
+  {
+    m_SpanCount.fetch_sub(1);
+    m_Dropped.fetch_add(1);
+    return;
+  }
+
+  span.threadId = threadBuffer->id;
+  QMutexLocker locker(&threadBuffer->mutex);
+  threadBuffer->spans.push_back(span);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TraceRecorder::AddHookSpan(const char* name, const char* category, qint64 start, qint64 duration)
+{
+  TraceRecorder* recorder = Instance();
+  Span span;
+  span.name = name;
+  span.category = category;
+  span.start = start;
+  span.duration = duration;
+  recorder->append(recorder->currentBuffer(), span);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TraceRecorder::addSpan(const QString& name, const char* category, qint64 start, qint64 duration, int threadId)
+{
+  if(!isRecording())
+  {
+    return;
+  }
+
+  Span span;
+  span.dynamicName = name.toUtf8();
+  span.category = category;
+  span.start = start;
+  span.duration = duration;
+  append((threadId < 0) ? currentBuffer() : buffer(threadId), span);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TraceRecorder::write(const QString& filePath, QString* errorMessage)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = file.errorString();
+    }
+    return false;
+  }
+
+  QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+  QByteArray out;
+  out.reserve(1024 * 1024);
+  out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  out.append("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":0,\"args\":{\"name\":\"");
+  AppendEscaped(out, QCoreApplication::applicationName().toUtf8().constData());
+  out.append("\"}}");
+
+  QList<ThreadBuffer*> buffers;
+  {
+    QMutexLocker locker(&m_Mutex);
+    buffers = m_Buffers;
+  }
+
+  for(ThreadBuffer* threadBuffer : buffers)
+  {
+    if(nullptr == threadBuffer)
+    {
+      continue;
+    }
+    QMutexLocker locker(&threadBuffer->mutex);
+    if(threadBuffer->spans.isEmpty())
+    {
+      continue;
+    }
+
+    QByteArray tid = QByteArray::number(threadBuffer->id);
+    out.append(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"name\":\"");
+    AppendEscaped(out, threadBuffer->name.toUtf8().constData());
+    out.append("\"}}");
+
+    for(const Span& span : threadBuffer->spans)
+    {
+      // Trace event timestamps are microseconds from the start of the recording
+      out.append(",\n{\"name\":\"");
+      AppendEscaped(out, (nullptr != span.name) ? span.name : span.dynamicName.constData());
+      out.append("\",\"cat\":\"");
+      AppendEscaped(out, span.category);
+      out.append("\",\"ph\":\"X\",\"ts\":");
+      out.append(QByteArray::number((span.start - m_Started) / 1000.0, 'f', 3));
+      out.append(",\"dur\":");
+      out.append(QByteArray::number(span.duration / 1000.0, 'f', 3));
+      out.append(",\"pid\":" + pid + ",\"tid\":" + tid + "}");
+
+      if(out.size() > 8 * 1024 * 1024)
+      {
+        file.write(out);
+        out.clear();
+      }
+    }
+  }
+  out.append("\n]}\n");
+  file.write(out);
+
+  if(file.error() != QFileDevice::NoError)
+  {
+    if(nullptr != errorMessage)
+    {
+      *errorMessage = file.errorString();
+    }
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,275 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+/**
+ * @brief The connection between SV_TRACE_SCOPE and the trace recorder of the application. The recorder
+ * publishes the address of its hook as the "SIMPLViewTraceHook" property of the application object, so a
+ * plugin only needs this header and does not have to link against SIMPLView.
+ */
+struct SVTraceHook
+{
+  std::atomic<bool> recording;
+  void (*addSpan)(const char* name, const char* category, qint64 start, qint64 duration);
+};
+
+namespace SVTrace
+{
+/**
+ * @brief Returns the time in nanoseconds on the clock that all spans are measured with
+ */
+inline qint64 Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Returns the hook of the application's recorder, or nullptr if the application does not record traces.
+ * The application publishes the hook right after it is constructed, before any plugin is loaded, so the first
+ * lookup of a module that finds an application object is final, whether a hook was found or not.
+ */
+inline SVTraceHook* Hook()
+{
+  static std::atomic<SVTraceHook*> hook(nullptr);
+  static std::atomic<bool> resolved(false);
+  if(resolved.load(std::memory_order_acquire))
+  {
+    return hook.load(std::memory_order_relaxed);
+  }
+
+  QCoreApplication* app = QCoreApplication::instance();
+  if(nullptr == app)
+  {
+    return nullptr;
+  }
+  SVTraceHook* current = reinterpret_cast<SVTraceHook*>(app->property("SIMPLViewTraceHook").toULongLong());
+  hook.store(current, std::memory_order_relaxed);
+  resolved.store(true, std::memory_order_release);
+  return current;
+}
+
+/**
+ * @brief Records the lifetime of the scope as a span while a trace is being recorded. When no trace is being
+ * recorded the cost is a single relaxed atomic load. The name and category must be string literals.
+ */
+class Scope
+{
+public:
+  Scope(const char* name, const char* category)
+  : m_Name(name)
+  , m_Category(category)
+  {
+    SVTraceHook* hook = Hook();
+    if(nullptr != hook && hook->recording.load(std::memory_order_relaxed))
+    {
+      m_Hook = hook;
+      m_Start = Now();
+    }
+  }
+
+  ~Scope()
+  {
+    if(nullptr != m_Hook)
+    {
+      m_Hook->addSpan(m_Name, m_Category, m_Start, Now() - m_Start);
+    }
+  }
+
+private:
+  const char* m_Name = nullptr;
+  const char* m_Category = nullptr;
+  SVTraceHook* m_Hook = nullptr;
+  qint64 m_Start = 0;
+
+public:
+  Scope(const Scope&) = delete;            // Copy Constructor Not Implemented
+  Scope(Scope&&) = delete;                 // Move Constructor Not Implemented
+  Scope& operator=(const Scope&) = delete; // Copy Assignment Not Implemented
+  Scope& operator=(Scope&&) = delete;      // Move Assignment Not Implemented
+};
+}
+
+#define SV_TRACE_CONCAT_IMPL(a, b) a##b
+#define SV_TRACE_CONCAT(a, b) SV_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Records the rest of the enclosing scope as a span named name in the "plugin" category
+ */
+#define SV_TRACE_SCOPE(name) SVTrace::Scope SV_TRACE_CONCAT(svTraceScope_, __LINE__)(name, "plugin")
+
+/**
+ * @brief Records the rest of the enclosing scope as a span named name in the given category
+ */
+#define SV_TRACE_SCOPE_CATEGORY(name, category) SVTrace::Scope SV_TRACE_CONCAT(svTraceScope_, __LINE__)(name, category)
+
+/**
+ * @brief The TraceRecorder class records spans from any thread while a trace is being recorded and writes
+ * them in the Chrome trace event format, which Perfetto and chrome://tracing open directly. Every thread
+ * appends to its own buffer so that threads do not contend with each other while recording.
+ */
+class TraceRecorder : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~TraceRecorder() override;
+
+  /**
+   * @brief Returns the singleton instance. The first call publishes the hook for SV_TRACE_SCOPE and must
+   * happen after the application object was created.
+   * @return
+   */
+  static TraceRecorder* Instance();
+
+  /**
+   * @brief isRecording
+   * @return
+   */
+  bool isRecording() const;
+
+  /**
+   * @brief Discards the previous trace and starts recording
+   */
+  void start();
+
+  /**
+   * @brief Stops recording. The spans are kept until the next start.
+   */
+  void stop();
+
+  /**
+   * @brief Returns the number of spans recorded
+   * @return
+   */
+  int getSpanCount() const;
+
+  /**
+   * @brief Returns the number of spans that were dropped because the trace was full
+   * @return
+   */
+  int getDroppedCount() const;
+
+  /**
+   * @brief Records a span with a name that is not a string literal
+   * @param name
+   * @param category Must be a string literal
+   * @param start Start time from SVTrace::Now()
+   * @param duration In nanoseconds
+   * @param threadId The thread the span ran on, from CurrentThreadId(); -1 for the calling thread
+   */
+  void addSpan(const QString& name, const char* category, qint64 start, qint64 duration, int threadId = -1);
+
+  /**
+   * @brief Returns the ID that the calling thread has in the trace
+   * @return
+   */
+  static int CurrentThreadId();
+
+  /**
+   * @brief Adds a lane that is not tied to a thread, for spans that are measured from another thread than the
+   * one they ran on, such as the filters of a pipeline whose messages arrive on the GUI thread
+   * @param name
+   * @return The ID to pass to addSpan()
+   */
+  int addLane(const QString& name);
+
+  /**
+   * @brief Writes the recorded spans as a trace event Json file
+   * @param filePath
+   * @param errorMessage
+   * @return True on success
+   */
+  bool write(const QString& filePath, QString* errorMessage = nullptr);
+
+  static const int MaxSpans = 2000000;
+
+signals:
+  void recordingChanged(bool recording);
+
+protected:
+  TraceRecorder(QObject* parent = nullptr);
+
+private:
+  static TraceRecorder* self;
+
+  struct Span
+  {
+    const char* name = nullptr;
+    QByteArray dynamicName;
+    const char* category = nullptr;
+    qint64 start = 0;
+    qint64 duration = 0;
+    int threadId = 0;
+  };
+
+  struct ThreadBuffer
+  {
+    int id = 0;
+    QString name;
+    QMutex mutex;
+    QList<Span> spans;
+    std::atomic<bool> finished{false};
+  };
+
+  SVTraceHook m_Hook;
+  mutable QMutex m_Mutex;
+  QList<ThreadBuffer*> m_Buffers;
+  std::atomic<int> m_SpanCount;
+  std::atomic<int> m_Dropped;
+  qint64 m_Started = 0;
+
+  static void AddHookSpan(const char* name, const char* category, qint64 start, qint64 duration);
+  ThreadBuffer* currentBuffer();
+  ThreadBuffer* buffer(int threadId);
+  void append(ThreadBuffer* buffer, Span& span);
+
+public:
+  TraceRecorder(const TraceRecorder&) = delete;            // Copy Constructor Not Implemented
+  TraceRecorder(TraceRecorder&&) = delete;                 // Move Constructor Not Implemented
+  TraceRecorder& operator=(const TraceRecorder&) = delete; // Copy Assignment Not Implemented
+  TraceRecorder& operator=(TraceRecorder&&) = delete;      // Move Assignment Not Implemented
+};
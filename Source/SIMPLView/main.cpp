@@ -35,6 +35,7 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QSettings>
 #include <QtCore/QString>
 #include <QtCore/QDirIterator>
@@ -43,8 +44,15 @@
 #include <QtGui/QFontDatabase>
 
 #include "BrandedStrings.h"
+#include "EventLoopWatchdog.h"
+#include "ExecutionEventLog.h"
+#include "HelpArchive.h"
 #include "SIMPLView.h"
 #include "SIMPLViewApplication.h"
+#include "TraceRecorder.h"
+#include "MetricsServer.h"
+#include "ExecutionHistory.h"
+#include "AsyncWriteService.h"
 #include "SIMPLView_UI.h"
 #include "StyleSheetEditor.h"
 
@@ -146,11 +154,17 @@ int main(int argc, char* argv[])
 
   SIMPLViewApplication qtapp(argc, argv);
 
+  // Publishes the trace hook before any SV_TRACE_SCOPE can look for it
+  TraceRecorder::Instance();
+
   if(!qtapp.initialize(argc, argv))
   {
     return 1;
   }
 
+  // Serve the metrics again if they were served in the previous session
+  MetricsServer::Instance()->restore();
+
 #if defined(Q_OS_MAC)
   dream3dApp->setQuitOnLastWindowClosed(false);
 #endif
@@ -191,9 +205,25 @@ int main(int argc, char* argv[])
   }
 
 #ifdef SIMPL_USE_MKDOCS
-  QtSDocServer::Instance();
+  // With a help archive the documentation server only starts if a page is missing from the archive
+  if(!QFile::exists(HelpArchive::DefaultFilePath()))
+  {
+    QtSDocServer::Instance();
+  }
 #endif
 
+  // Watch the GUI event loop for stalls from here on
+  EventLoopWatchdog::Instance()->start();
+  ExecutionEventLog::Instance()->start();
+  ExecutionHistory::Instance()->start();
+  AsyncWriteService::Instance()->start();
+
   int err = SIMPLViewApplication::exec();
+
+  // Writes that are still queued finish before the application goes away
+  AsyncWriteService::Instance()->stop();
+  ExecutionHistory::Instance()->stop();
+  ExecutionEventLog::Instance()->stop();
+  EventLoopWatchdog::Instance()->stop();
   return err;
 }
@@ -0,0 +1,168 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Testing/UnitTestSupport.hpp"
+
+#include "SIMPLView/AsyncWriteOrder.h"
+
+class AsyncWriteOrderTest
+{
+public:
+  AsyncWriteOrderTest() = default;
+  ~AsyncWriteOrderTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // Takes jobs off a queue the way the I/O thread does and returns the order they ran in. Each job is named by
+  // its kind ('R' or 'W') and its position in the queue.
+  // -----------------------------------------------------------------------------
+  QStringList Drain(const QString& queued)
+  {
+    QVector<bool> writes;
+    QStringList names;
+    for(int i = 0; i < queued.size(); i++)
+    {
+      writes.push_back(queued[i] == 'W');
+      names.push_back(QString("%1%2").arg(queued[i]).arg(i));
+    }
+
+    QStringList order;
+    int writesInARow = 0;
+    while(!writes.isEmpty())
+    {
+      int next = AsyncWriteOrder::Next(writes, writesInARow);
+      DREAM3D_REQUIRE(next >= 0 && next < writes.size())
+      writesInARow = writes[next] ? writesInARow + 1 : 0;
+      writes.removeAt(next);
+      order.push_back(names.takeAt(next));
+    }
+    return order;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestEmptyQueue()
+  {
+    DREAM3D_REQUIRE_EQUAL(AsyncWriteOrder::Next(QVector<bool>(), 0), -1)
+    DREAM3D_REQUIRE_EQUAL(AsyncWriteOrder::Next(QVector<bool>(), AsyncWriteOrder::MaxWritesInARow), -1)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestWritesFirst()
+  {
+    // A read that is queued in front of a write still waits for it
+    DREAM3D_REQUIRE_EQUAL(AsyncWriteOrder::Next(QVector<bool>({false, true}), 0), 1)
+    DREAM3D_REQUIRE(Drain("RW") == QStringList({"W1", "R0"}))
+    DREAM3D_REQUIRE(Drain("RRW") == QStringList({"W2", "R0", "R1"}))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestQueuedOrderWithinKind()
+  {
+    DREAM3D_REQUIRE(Drain("WWW") == QStringList({"W0", "W1", "W2"}))
+    DREAM3D_REQUIRE(Drain("RRR") == QStringList({"R0", "R1", "R2"}))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestReadsAreNotStarved()
+  {
+    // A read gets through after every MaxWritesInARow writes
+    DREAM3D_REQUIRE_EQUAL(AsyncWriteOrder::Next(QVector<bool>({true, false}), AsyncWriteOrder::MaxWritesInARow), 1)
+    DREAM3D_REQUIRE_EQUAL(AsyncWriteOrder::Next(QVector<bool>({true, true}), AsyncWriteOrder::MaxWritesInARow), 0)
+
+    QString queued = "RRWWWWWW";
+    QStringList order = Drain(queued);
+    DREAM3D_REQUIRE_EQUAL(order.size(), queued.size())
+    int writesInARow = 0;
+    int readsLeft = queued.count('R');
+    for(const QString& name : order)
+    {
+      if(name.startsWith('W'))
+      {
+        writesInARow++;
+        DREAM3D_REQUIRE(readsLeft == 0 || writesInARow <= AsyncWriteOrder::MaxWritesInARow)
+      }
+      else
+      {
+        writesInARow = 0;
+        readsLeft--;
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(order.first(), QString("W2"))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "#### AsyncWriteOrderTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestEmptyQueue())
+    DREAM3D_REGISTER_TEST(TestWritesFirst())
+    DREAM3D_REGISTER_TEST(TestQueuedOrderWithinKind())
+    DREAM3D_REGISTER_TEST(TestReadsAreNotStarved())
+  }
+
+public:
+  AsyncWriteOrderTest(const AsyncWriteOrderTest&) = delete;            // Copy Constructor Not Implemented
+  AsyncWriteOrderTest(AsyncWriteOrderTest&&) = delete;                 // Move Constructor Not Implemented
+  AsyncWriteOrderTest& operator=(const AsyncWriteOrderTest&) = delete; // Copy Assignment Not Implemented
+  AsyncWriteOrderTest& operator=(AsyncWriteOrderTest&&) = delete;      // Move Assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  AsyncWriteOrderTest test;
+  test();
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,192 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <iomanip>
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <QtSql/QSqlDatabase>
+
+#include "SIMPLView/ExecutionHistory.h"
+
+namespace
+{
+const QString k_Connection("ExecutionHistoryQuery");
+
+/**
+ * @brief Removes "--name value" from the arguments and returns the value, or defaultValue if it is not there
+ */
+int TakeOption(QStringList& args, const QString& name, int defaultValue)
+{
+  int index = args.indexOf(name);
+  if(index < 0 || index + 1 >= args.size())
+  {
+    return defaultValue;
+  }
+  bool ok = false;
+  int value = args[index + 1].toInt(&ok);
+  args.removeAt(index + 1);
+  args.removeAt(index);
+  return ok ? value : defaultValue;
+}
+
+/**
+ * @brief Prints the recent runs
+ */
+void PrintRuns(const QSqlDatabase& db, int limit)
+{
+  QVector<ExecutionHistory::Run> runs = ExecutionHistory::RecentRuns(db, limit);
+  std::cout << std::left << std::setw(21) << "Started" << std::setw(10) << "Status" << std::right << std::setw(12) << "Time (s)" << std::setw(14) << "Tuples" << std::setw(12)
+            << "Peak (MB)"
+            << "  " << std::left << std::setw(18) << "Hash"
+            << "Pipeline" << std::right << std::endl;
+  for(const ExecutionHistory::Run& run : runs)
+  {
+    std::cout << std::left << std::setw(21) << run.started.toString("yyyy-MM-dd HH:mm:ss").toStdString() << std::setw(10) << run.status.toStdString() << std::right << std::fixed
+              << std::setprecision(1) << std::setw(12) << run.seconds << std::setw(14) << run.inputTuples << std::setw(12) << run.peakMemory / (1024.0 * 1024.0) << "  " << std::left
+              << std::setw(18) << run.pipelineHash.toStdString() << run.pipelineName.toStdString() << std::right << std::endl;
+  }
+}
+
+/**
+ * @brief Prints the per filter trends and returns the number of regressions
+ */
+int PrintTrends(const QSqlDatabase& db, int recentDays, int baselineDays, double threshold, const QString& className)
+{
+  QVector<ExecutionHistory::Trend> trends = ExecutionHistory::FilterTrends(db, recentDays, baselineDays, className);
+
+  std::cout << "Finished runs of the last " << recentDays << " days compared to the " << baselineDays << " days before." << std::endl;
+  std::cout << "Times marked * are seconds per million input tuples, the others plain seconds." << std::endl << std::endl;
+  std::cout << std::setw(10) << "Baseline" << std::setw(6) << "n" << std::setw(10) << "Recent" << std::setw(6) << "n" << std::setw(10) << "Change"
+            << "    Filter" << std::endl;
+
+  int regressions = 0;
+  for(const ExecutionHistory::Trend& trend : trends)
+  {
+    bool regression = ExecutionHistory::IsRegression(trend, threshold);
+    regressions += regression ? 1 : 0;
+
+    std::cout << std::fixed << std::setprecision(3) << std::setw(10) << trend.baseline << std::setw(6) << trend.baselineCount << std::setw(10) << trend.recent << std::setw(6) << trend.recentCount;
+    if(trend.baselineCount > 0 && trend.recentCount > 0)
+    {
+      std::cout << std::showpos << std::setprecision(1) << std::setw(9) << trend.change() * 100.0 << "%" << std::noshowpos;
+    }
+    else
+    {
+      std::cout << std::setw(10) << "-";
+    }
+    std::cout << (trend.normalized ? " *" : "  ") << (regression ? "! " : "  ") << trend.className.toStdString() << std::endl;
+  }
+
+  std::cout << std::endl << regressions << " filters are more than " << threshold * 100.0 << "% slower with at least " << ExecutionHistory::MinimumSamples << " timings on both sides" << std::endl;
+  return regressions;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("ExecutionHistoryQuery");
+
+  QStringList args = app.arguments();
+  args.removeFirst();
+
+  int recentDays = TakeOption(args, "--recent-days", 7);
+  int baselineDays = TakeOption(args, "--baseline-days", 30);
+  int thresholdPercent = TakeOption(args, "--threshold", 20);
+  int limit = TakeOption(args, "--limit", 50);
+
+  if(args.isEmpty())
+  {
+    std::cout << "Queries the execution history database that SIMPLView writes (ExecutionHistory.sqlite in its application data folder)." << std::endl;
+    std::cout << "Usage: ExecutionHistoryQuery <database> [trends | runs | filter <class name>] [options]" << std::endl;
+    std::cout << "  trends                Per filter time of recent runs against a baseline (default)" << std::endl;
+    std::cout << "  runs                  The most recent runs" << std::endl;
+    std::cout << "  filter <class name>   The trend of one filter class" << std::endl;
+    std::cout << "  --recent-days <n>     Length of the recent period (7)" << std::endl;
+    std::cout << "  --baseline-days <n>   Length of the baseline period before it (30)" << std::endl;
+    std::cout << "  --threshold <pct>     Slowdown that counts as a regression (20)" << std::endl;
+    std::cout << "  --limit <n>           Number of runs to list (50)" << std::endl;
+    std::cout << "The exit code is 2 if trends found a regression." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QString filePath = args.takeFirst();
+  if(!QFileInfo(filePath).isFile())
+  {
+    std::cout << "There is no execution history at " << filePath.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QString errorMessage;
+  if(!ExecutionHistory::Open(k_Connection, filePath, &errorMessage))
+  {
+    std::cout << "Could not open " << filePath.toStdString() << ": " << errorMessage.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int result = EXIT_SUCCESS;
+  {
+    QSqlDatabase db = QSqlDatabase::database(k_Connection, false);
+    QString command = args.isEmpty() ? QString("trends") : args.takeFirst();
+    if(command == "runs")
+    {
+      PrintRuns(db, limit);
+    }
+    else if(command == "trends" || (command == "filter" && !args.isEmpty()))
+    {
+      QString className = (command == "filter") ? args.takeFirst() : QString();
+      if(PrintTrends(db, recentDays, baselineDays, thresholdPercent / 100.0, className) > 0)
+      {
+        result = 2;
+      }
+    }
+    else
+    {
+      std::cout << "Unknown command: " << command.toStdString() << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  ExecutionHistory::Close(k_Connection);
+  return result;
+}
@@ -0,0 +1,189 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <iomanip>
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace
+{
+/**
+ * @brief Time spent in one filter of a pipeline, summed over all the runs in the log
+ */
+struct FilterTotals
+{
+  QString label;
+  int index = -1;
+  int count = 0;
+  qint64 total = 0;
+  qint64 longest = 0;
+};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("ExecutionLogSummary");
+
+  QStringList args = app.arguments();
+  args.removeFirst();
+
+  QString pipelineId;
+  int pipelineArg = args.indexOf("--pipeline");
+  if(pipelineArg >= 0 && pipelineArg + 1 < args.size())
+  {
+    pipelineId = args[pipelineArg + 1];
+    args.removeAt(pipelineArg + 1);
+    args.removeAt(pipelineArg);
+  }
+
+  if(args.isEmpty())
+  {
+    std::cout << "Summarizes the time spent per filter in SIMPLView execution event logs (ExecutionEvents*.jsonl)." << std::endl;
+    std::cout << "Usage: ExecutionLogSummary [--pipeline <id>] <log file> [<log file> ...]" << std::endl;
+    std::cout << "Pass rotated files oldest first." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QMap<QString, FilterTotals> filters;
+  QSet<QString> runs;
+  int errors = 0;
+  int warnings = 0;
+  int cancels = 0;
+  int badLines = 0;
+
+  for(const QString& filePath : args)
+  {
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+      std::cout << "Could not open " << filePath.toStdString() << ": " << file.errorString().toStdString() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    while(!file.atEnd())
+    {
+      QByteArray line = file.readLine().trimmed();
+      if(line.isEmpty())
+      {
+        continue;
+      }
+
+      QJsonParseError parseError;
+      QJsonObject event = QJsonDocument::fromJson(line, &parseError).object();
+      if(parseError.error != QJsonParseError::NoError)
+      {
+        // A line cut short by a crash is expected at the end of a log
+        badLines++;
+        continue;
+      }
+
+      QString pipeline = event["pipeline"].toString();
+      if(!pipelineId.isEmpty() && pipeline != pipelineId)
+      {
+        continue;
+      }
+
+      QString type = event["type"].toString();
+      if(event.contains("run"))
+      {
+        runs.insert(QString("%1/%2").arg(pipeline).arg(event["run"].toInt()));
+      }
+
+      if(type == "error")
+      {
+        errors++;
+      }
+      else if(type == "warning")
+      {
+        warnings++;
+      }
+      else if(type == "cancel")
+      {
+        cancels++;
+      }
+      else if(type == "filter_end")
+      {
+        int index = event["filter"].toInt();
+        QString className = event["class"].toString();
+        QString key = QString("%1 %2").arg(index, 4, 10, QChar('0')).arg(className);
+
+        FilterTotals& totals = filters[key];
+        totals.index = index;
+        totals.label = event["label"].toString().isEmpty() ? className : event["label"].toString();
+        qint64 duration = static_cast<qint64>(event["duration_ns"].toDouble());
+        totals.count++;
+        totals.total += duration;
+        totals.longest = qMax(totals.longest, duration);
+      }
+    }
+  }
+
+  qint64 grandTotal = 0;
+  for(const FilterTotals& totals : filters)
+  {
+    grandTotal += totals.total;
+  }
+
+  std::cout << runs.size() << " runs, " << errors << " errors, " << warnings << " warnings, " << cancels << " cancels";
+  if(badLines > 0)
+  {
+    std::cout << ", " << badLines << " unreadable lines";
+  }
+  std::cout << std::endl << std::endl;
+
+  std::cout << std::setw(6) << "Index" << std::setw(8) << "Runs" << std::setw(14) << "Total (ms)" << std::setw(14) << "Mean (ms)" << std::setw(14) << "Max (ms)" << std::setw(8) << "%"
+            << "  Filter" << std::endl;
+  for(const FilterTotals& totals : filters)
+  {
+    double percent = (grandTotal > 0) ? 100.0 * totals.total / grandTotal : 0.0;
+    std::cout << std::setw(6) << totals.index << std::setw(8) << totals.count << std::fixed << std::setprecision(1) << std::setw(14) << totals.total / 1.0e6 << std::setw(14)
+              << totals.total / 1.0e6 / totals.count << std::setw(14) << totals.longest / 1.0e6 << std::setw(8) << percent << "  " << totals.label.toStdString() << std::endl;
+  }
+  std::cout << std::endl << "Total time in filters: " << std::fixed << std::setprecision(1) << grandTotal / 1.0e6 << " ms" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+
+#include "SIMPLView/HelpArchive.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("HelpArchiveBuilder");
+
+  QStringList args = app.arguments();
+  if(args.size() != 3)
+  {
+    std::cout << "Packs the rendered filter documentation into a single help archive (." << HelpArchive::FileExtension().toStdString() << ")." << std::endl;
+    std::cout << "Usage: HelpArchiveBuilder <help directory> <archive file>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without documentation there is nothing to pack; the application then shows the help the way it always has
+  if(!QFileInfo(args[1]).isDir())
+  {
+    std::cout << "No help directory at " << args[1].toStdString() << ", no archive written." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  QString errorMessage;
+  bool changed = false;
+  int count = HelpArchive::Create(args[1], args[2], &errorMessage, &changed);
+  if(count < 0)
+  {
+    std::cout << errorMessage.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Reading the archive back catches a broken index at build time rather than on the first help request
+  HelpArchive archive;
+  if(!archive.open(args[2], &errorMessage))
+  {
+    std::cout << errorMessage.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << args[1].toStdString() << " -> " << args[2].toStdString() << " (" << count << " entries, " << QFileInfo(args[2]).size() << " bytes, " << timer.elapsed() << " ms"
+            << (changed ? "" : ", unchanged") << ")" << std::endl;
+  return EXIT_SUCCESS;
+}
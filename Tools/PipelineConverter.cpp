@@ -0,0 +1,102 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+
+#include "SIMPLView/PipelineBinaryFormat.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("PipelineConverter");
+
+  QStringList args = app.arguments();
+  if(args.size() < 2 || args.size() > 3)
+  {
+    std::cout << "Converts a pipeline between the Json and the binary (." << PipelineBinaryFormat::FileExtension().toStdString() << ") formats." << std::endl;
+    std::cout << "The direction of the conversion is detected from the contents of the input file." << std::endl;
+    std::cout << "Usage: PipelineConverter <input file> [output file]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QString inputFilePath = args[1];
+  QFileInfo fi(inputFilePath);
+  if(!fi.exists())
+  {
+    std::cout << "Input file does not exist: " << inputFilePath.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool toJson = PipelineBinaryFormat::IsBinaryPipelineFile(inputFilePath);
+
+  QString outputFilePath;
+  if(args.size() == 3)
+  {
+    outputFilePath = args[2];
+  }
+  else
+  {
+    QString suffix = toJson ? QString("json") : PipelineBinaryFormat::FileExtension();
+    outputFilePath = fi.absolutePath() + "/" + fi.completeBaseName() + "." + suffix;
+  }
+
+  QString errorMessage;
+  int err = 0;
+  if(toJson)
+  {
+    err = PipelineBinaryFormat::ConvertBinaryToJson(inputFilePath, outputFilePath, &errorMessage);
+  }
+  else
+  {
+    err = PipelineBinaryFormat::ConvertJsonToBinary(inputFilePath, outputFilePath, &errorMessage);
+  }
+
+  if(err < 0)
+  {
+    std::cout << errorMessage.toStdString() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QFileInfo outFi(outputFilePath);
+  std::cout << inputFilePath.toStdString() << " (" << fi.size() << " bytes) -> " << outputFilePath.toStdString() << " (" << outFi.size() << " bytes)" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include "SIMPLView/PipelineBinaryFormat.h"
+
+namespace
+{
+/**
+ * @brief Runs the function the requested number of times and returns the mean time in microseconds
+ */
+template <typename Func> double TimeIt(int iterations, Func func)
+{
+  QElapsedTimer timer;
+  timer.start();
+  for(int i = 0; i < iterations; i++)
+  {
+    func();
+  }
+  return static_cast<double>(timer.nsecsElapsed()) / 1000.0 / iterations;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("PipelineLoadBenchmark");
+
+  QStringList args = app.arguments();
+  if(args.size() < 2)
+  {
+    std::cout << "Compares the time needed to parse Json pipelines with the time needed to decode their binary encoding." << std::endl;
+    std::cout << "Usage: PipelineLoadBenchmark [-n iterations] <pipeline file> [pipeline file ...]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int iterations = 100;
+  int firstFile = 1;
+  if(args[1] == "-n" && args.size() > 3)
+  {
+    iterations = qMax(1, args[2].toInt());
+    firstFile = 3;
+  }
+
+  std::cout << "File, Json Bytes, Binary Bytes, Json Parse (us), Binary Decode (us), Speedup" << std::endl;
+
+  int failures = 0;
+  for(int i = firstFile; i < args.size(); i++)
+  {
+    QString filePath = args[i];
+    QJsonObject root;
+    QString errorMessage;
+    if(!PipelineBinaryFormat::ReadDocument(filePath, root, &errorMessage))
+    {
+      std::cout << filePath.toStdString() << ": " << errorMessage.toStdString() << std::endl;
+      failures++;
+      continue;
+    }
+
+    // Both encodings are produced from the same document so that the comparison is like for like
+    QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    QByteArray binary = PipelineBinaryFormat::Encode(root);
+
+    QJsonObject roundTrip;
+    if(!PipelineBinaryFormat::Decode(binary, roundTrip, &errorMessage) || roundTrip != root)
+    {
+      std::cout << filePath.toStdString() << ": the binary encoding does not round trip. " << errorMessage.toStdString() << std::endl;
+      failures++;
+      continue;
+    }
+
+    double jsonTime = TimeIt(iterations, [&json] {
+      QJsonParseError parseError;
+      QJsonDocument doc = QJsonDocument::fromJson(json, &parseError);
+      Q_UNUSED(doc);
+    });
+    double binaryTime = TimeIt(iterations, [&binary] {
+      QJsonObject obj;
+      PipelineBinaryFormat::Decode(binary, obj);
+    });
+
+    std::cout << QFileInfo(filePath).fileName().toStdString() << ", " << json.size() << ", " << binary.size() << ", " << jsonTime << ", " << binaryTime << ", "
+              << (binaryTime > 0.0 ? jsonTime / binaryTime : 0.0) << std::endl;
+  }
+
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}